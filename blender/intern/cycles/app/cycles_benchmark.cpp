@@ -0,0 +1,243 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "app/cycles_benchmark.h"
+
+#include "scene/scene.h"
+#include "scene/stats.h"
+
+#include "util/path.h"
+#include "util/version.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Measurements which are compared against the baseline, and whether a lower value is better. */
+static const struct {
+  const char *key;
+  bool lower_is_better;
+} benchmark_compare_keys[] = {
+    {"load_time", true},
+    {"sync_time", true},
+    {"bvh_build_time", true},
+    {"render_time", true},
+    {"samples_per_second", false},
+    {"pixel_samples_per_second", false},
+    {"device_mem_peak", true},
+    {"host_mem_peak", true},
+};
+
+static string json_unescape(const string &str)
+{
+  string result;
+  result.reserve(str.size());
+  for (size_t i = 0; i < str.size(); i++) {
+    if (str[i] == '\\' && i + 1 < str.size()) {
+      i++;
+      if (str[i] == 'u' && i + 4 < str.size()) {
+        /* Control characters, as written by string_json_escape(). */
+        result += char(std::strtol(str.substr(i + 1, 4).c_str(), nullptr, 16));
+        i += 4;
+      }
+      else {
+        result += (str[i] == 'n') ? '\n' : str[i];
+      }
+    }
+    else {
+      result += str[i];
+    }
+  }
+  return result;
+}
+
+static map<string, double> benchmark_scene_values(const BenchmarkSceneResult &result)
+{
+  map<string, double> values;
+  values["load_time"] = result.load_time;
+  values["sync_time"] = result.sync_time;
+  values["bvh_build_time"] = result.bvh_build_time;
+  values["render_time"] = result.render_time;
+  values["samples_per_second"] = result.samples_per_second;
+  values["pixel_samples_per_second"] = result.pixel_samples_per_second;
+  values["device_mem_peak"] = double(result.device_mem_peak);
+  values["host_mem_peak"] = double(result.host_mem_peak);
+  return values;
+}
+
+void BenchmarkSceneResult::collect_update_stats(Scene *scene)
+{
+  if (!scene->update_stats) {
+    return;
+  }
+
+  for (const NamedTimeEntry &entry : scene->update_stats->scene.times.entries) {
+    sync_time += entry.time;
+  }
+
+  /* BVH building is timed as part of the geometry manager update, both for the object and the
+   * top level BVH. */
+  for (const NamedTimeEntry &entry : scene->update_stats->geometry.times.entries) {
+    if (entry.name.find("BVH") != string::npos) {
+      bvh_build_time += entry.time;
+    }
+  }
+}
+
+void BenchmarkSceneResult::compute_throughput()
+{
+  if (render_time <= 0.0) {
+    return;
+  }
+
+  const double num_pixels = double(width) * double(height);
+  samples_per_second = double(samples) / render_time;
+  pixel_samples_per_second = num_pixels * double(samples) / render_time;
+}
+
+string BenchmarkReport::to_json() const
+{
+  string json = "{\n";
+  json += string_printf("  \"version\": \"%s\",\n", CYCLES_VERSION_STRING);
+  json += string_printf("  \"device\": \"%s\",\n", string_json_escape(device).c_str());
+  json += string_printf("  \"threads\": %d,\n", threads);
+  json += "  \"scenes\": [\n";
+
+  for (size_t i = 0; i < scenes.size(); i++) {
+    const BenchmarkSceneResult &result = scenes[i];
+
+    json += "    {\n";
+    json += string_printf("      \"name\": \"%s\",\n", string_json_escape(result.name).c_str());
+    json += string_printf("      \"width\": %d,\n", result.width);
+    json += string_printf("      \"height\": %d,\n", result.height);
+    json += string_printf("      \"samples\": %d,\n", result.samples);
+    json += string_printf("      \"seed\": %d,\n", result.seed);
+    json += string_printf("      \"load_time\": %.6f,\n", result.load_time);
+    json += string_printf("      \"sync_time\": %.6f,\n", result.sync_time);
+    json += string_printf("      \"bvh_build_time\": %.6f,\n", result.bvh_build_time);
+    json += string_printf("      \"render_time\": %.6f,\n", result.render_time);
+    json += string_printf("      \"samples_per_second\": %.6f,\n", result.samples_per_second);
+    json += string_printf("      \"pixel_samples_per_second\": %.3f,\n",
+                          result.pixel_samples_per_second);
+    json += string_printf("      \"device_mem_peak\": %zu,\n", result.device_mem_peak);
+    json += string_printf("      \"host_mem_peak\": %zu\n", result.host_mem_peak);
+    json += (i + 1 < scenes.size()) ? "    },\n" : "    }\n";
+  }
+
+  json += "  ]\n";
+  json += "}\n";
+
+  return json;
+}
+
+bool BenchmarkReport::write_json(const string &filepath) const
+{
+  string json = to_json();
+  return path_write_text(filepath, json);
+}
+
+/* Read back a report written by BenchmarkReport::to_json(). This is not a general JSON parser,
+ * it relies on the one key per line layout of the written reports. */
+bool benchmark_read_baseline(const string &filepath, BenchmarkBaseline &baseline)
+{
+  string text;
+  if (!path_read_text(filepath, text)) {
+    return false;
+  }
+
+  vector<string> lines;
+  string_split(lines, text, "\n", false);
+
+  string scene_name;
+  for (const string &line : lines) {
+    const string stripped = string_strip(line);
+
+    if (string_startswith(stripped, "}")) {
+      scene_name.clear();
+      continue;
+    }
+    if (!string_startswith(stripped, "\"")) {
+      continue;
+    }
+
+    const size_t key_end = stripped.find('"', 1);
+    const size_t colon = stripped.find(':', key_end);
+    if (key_end == string::npos || colon == string::npos) {
+      continue;
+    }
+
+    const string key = stripped.substr(1, key_end - 1);
+    string value = string_strip(stripped.substr(colon + 1));
+    if (string_endswith(value, ",")) {
+      value.pop_back();
+    }
+
+    if (key == "name") {
+      if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+        scene_name = json_unescape(value.substr(1, value.size() - 2));
+        baseline[scene_name];
+      }
+      continue;
+    }
+
+    if (scene_name.empty() || value.empty() || value.front() == '"') {
+      continue;
+    }
+
+    char *end = nullptr;
+    const double number = strtod(value.c_str(), &end);
+    if (end != value.c_str()) {
+      baseline[scene_name][key] = number;
+    }
+  }
+
+  return !baseline.empty();
+}
+
+bool benchmark_compare(const BenchmarkReport &report,
+                       const BenchmarkBaseline &baseline,
+                       const double tolerance)
+{
+  bool ok = true;
+
+  for (const BenchmarkSceneResult &result : report.scenes) {
+    const auto baseline_it = baseline.find(result.name);
+    if (baseline_it == baseline.end()) {
+      printf("%s: not in baseline, skipped\n", result.name.c_str());
+      continue;
+    }
+
+    printf("%s:\n", result.name.c_str());
+
+    const map<string, double> values = benchmark_scene_values(result);
+    for (const auto &compare : benchmark_compare_keys) {
+      const auto value_it = baseline_it->second.find(compare.key);
+      if (value_it == baseline_it->second.end() || value_it->second <= 0.0) {
+        continue;
+      }
+
+      const double base = value_it->second;
+      const double current = values.at(compare.key);
+      const double change = (current - base) / base;
+      const bool regressed = compare.lower_is_better ? (change > tolerance) :
+                                                       (-change > tolerance);
+
+      printf("  %-20s %14.6f -> %14.6f  %+7.2f%%%s\n",
+             compare.key,
+             base,
+             current,
+             change * 100.0,
+             regressed ? "  REGRESSION" : "");
+
+      if (regressed) {
+        ok = false;
+      }
+    }
+  }
+
+  return ok;
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,67 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+#include "util/map.h"
+#include "util/string.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+class Scene;
+
+/* Measurements of a single benchmark scene render.
+ *
+ * All times are in seconds and memory sizes in bytes. Throughput is measured in pixel samples,
+ * since the kernels do not count the rays they trace; this is still a stable measure as long as
+ * the same scene is rendered with the same number of samples and seed. */
+struct BenchmarkSceneResult {
+  string name;
+
+  int width = 0;
+  int height = 0;
+  int samples = 0;
+  int seed = 0;
+
+  double load_time = 0.0;
+  double sync_time = 0.0;
+  double bvh_build_time = 0.0;
+  double render_time = 0.0;
+
+  double samples_per_second = 0.0;
+  double pixel_samples_per_second = 0.0;
+
+  size_t device_mem_peak = 0;
+  size_t host_mem_peak = 0;
+
+  /* Fill in sync and BVH build time from the scene update statistics. */
+  void collect_update_stats(Scene *scene);
+
+  /* Compute derived throughput values from the render time. */
+  void compute_throughput();
+};
+
+struct BenchmarkReport {
+  string device;
+  int threads = 0;
+  vector<BenchmarkSceneResult> scenes;
+
+  string to_json() const;
+  bool write_json(const string &filepath) const;
+};
+
+/* Values read back from a previously written report, per scene name and measurement key. */
+using BenchmarkBaseline = map<string, map<string, double>>;
+
+bool benchmark_read_baseline(const string &filepath, BenchmarkBaseline &baseline);
+
+/* Compare the report against the baseline, printing a line per measurement. Returns false if
+ * any timing measurement got slower, or any throughput got lower, by more than the given
+ * relative tolerance. */
+bool benchmark_compare(const BenchmarkReport &report,
+                       const BenchmarkBaseline &baseline,
+                       const double tolerance);
+
+CCL_NAMESPACE_END
@@ -12,12 +12,13 @@
 #include "session/session.h"
 
 #include "util/args.h"
+#include "util/guarded_allocator.h"
 #include "util/log.h"
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/string.h"
+#include "util/time.h"
 #ifdef WITH_CYCLES_STANDALONE_GUI
-#  include "util/time.h"
 #  include "util/transform.h"
 #endif
 #include "util/unique_ptr.h"
@@ -27,6 +28,7 @@
 #  include "hydra/file_reader.h"
 #endif
 
+#include "app/cycles_benchmark.h"
 #include "app/cycles_xml.h"
 #include "app/oiio_output_driver.h"
 
@@ -41,13 +43,20 @@ struct Options {
   unique_ptr<Session> session;
   Scene *scene;
   string filepath;
+  vector<string> filepaths;
   int width, height;
+  int seed;
   SceneParams scene_params;
   SessionParams session_params;
   bool quiet;
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string benchmark_filepath;
+  string benchmark_baseline_filepath;
+  float benchmark_tolerance;
+  string update_timeline_filepath;
+  double scene_load_time;
 } options;
 
 static void session_print(const string &str)
@@ -101,6 +110,8 @@ static void scene_init()
 {
   options.scene = options.session->scene.get();
 
+  const scoped_timer load_timer(&options.scene_load_time);
+
   /* Read XML or USD */
 #ifdef WITH_USD
   if (!string_endswith(string_to_lower(options.filepath), ".xml")) {
@@ -124,6 +135,21 @@ static void scene_init()
 
   /* Calculate Viewplane */
   options.scene->camera->compute_auto_viewplane();
+
+  /* Seed override, always applied for benchmarks so that the same noise pattern is rendered
+   * every time. Adaptive sampling is disabled to render exactly the requested samples. */
+  const bool benchmark = !options.benchmark_filepath.empty();
+  if (benchmark || options.seed >= 0) {
+    options.scene->integrator->set_seed(max(options.seed, 0));
+  }
+  if (benchmark) {
+    options.scene->integrator->set_use_adaptive_sampling(false);
+    options.scene->enable_update_stats();
+  }
+
+  if (!options.update_timeline_filepath.empty()) {
+    options.scene->enable_update_timeline(options.update_timeline_filepath);
+  }
 }
 
 static void session_init()
@@ -176,6 +202,81 @@ static void session_exit()
   }
 }
 
+static int benchmark_run()
+{
+  BenchmarkReport report;
+  report.device = options.session_params.device.description;
+  report.threads = options.session_params.threads;
+
+  for (const string &filepath : options.filepaths) {
+    options.filepath = filepath;
+    options.scene_load_time = 0.0;
+
+    session_init();
+
+    const double render_start = time_dt();
+    options.session->wait();
+    const double wall_time = time_dt() - render_start;
+
+    string error = options.session->progress.get_error_message();
+    if (error.empty() && options.session->device->have_error()) {
+      error = options.session->device->error_message();
+    }
+    if (!error.empty()) {
+      fprintf(stderr, "Error rendering %s: %s\n", filepath.c_str(), error.c_str());
+      session_exit();
+      return EXIT_FAILURE;
+    }
+
+    BenchmarkSceneResult result;
+    result.name = path_filename(filepath);
+    result.width = options.width;
+    result.height = options.height;
+    result.samples = options.session_params.samples;
+    result.seed = options.scene->integrator->get_seed();
+    result.load_time = options.scene_load_time;
+    result.collect_update_stats(options.scene);
+    /* The session thread does the scene synchronization before it starts path tracing. */
+    result.render_time = max(wall_time - result.sync_time, 0.0);
+    result.compute_throughput();
+    result.device_mem_peak = options.session->stats.mem_peak;
+    /* Peak of the whole process so far, only available with the guarded allocator. */
+    result.host_mem_peak = util_guarded_get_mem_peak();
+
+    session_exit();
+
+    printf("%s: sync %.3fs, BVH %.3fs, render %.3fs, %.2f samples/s\n",
+           result.name.c_str(),
+           result.sync_time,
+           result.bvh_build_time,
+           result.render_time,
+           result.samples_per_second);
+
+    report.scenes.push_back(result);
+  }
+
+  if (!report.write_json(options.benchmark_filepath)) {
+    fprintf(stderr, "Failed to write benchmark report: %s\n", options.benchmark_filepath.c_str());
+    return EXIT_FAILURE;
+  }
+
+  if (!options.benchmark_baseline_filepath.empty()) {
+    BenchmarkBaseline baseline;
+    if (!benchmark_read_baseline(options.benchmark_baseline_filepath, baseline)) {
+      fprintf(stderr,
+              "Failed to read benchmark baseline: %s\n",
+              options.benchmark_baseline_filepath.c_str());
+      return EXIT_FAILURE;
+    }
+    if (!benchmark_compare(report, baseline, options.benchmark_tolerance)) {
+      fprintf(stderr, "Benchmark regressions compared to baseline\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
 #ifdef WITH_CYCLES_STANDALONE_GUI
 static void display_info(Progress &progress)
 {
@@ -367,6 +468,12 @@ static void parse_int(OIIO::cspan<const char *> argv, int *i)
   *i = atoi(argv[1]);
 }
 
+static void parse_float(OIIO::cspan<const char *> argv, float *f)
+{
+  assert(argv.size() == 2);
+  *f = atof(argv[1]);
+}
+
 static void parse_string(OIIO::cspan<const char *> argv, std::string *s)
 {
   assert(argv.size() == 2);
@@ -380,6 +487,9 @@ static void options_parse(const int argc, const char **argv)
   options.filepath = "";
   options.session = nullptr;
   options.quiet = false;
+  options.seed = -1;
+  options.benchmark_tolerance = 0.05f;
+  options.scene_load_time = 0.0;
   options.session_params.use_auto_tile = false;
   options.session_params.tile_size = 0;
 
@@ -409,8 +519,13 @@ static void options_parse(const int argc, const char **argv)
   bool version = false;
   int verbosity = 1;
 
-  ap.usage("cycles [options] file.xml");
-  ap.arg("filename").hidden().action([&](auto argv) { options.filepath = argv[0]; });
+  ap.usage("cycles [options] file.xml [file.xml ...]");
+  ap.arg("filename").hidden().action([&](auto argv) {
+    if (options.filepath.empty()) {
+      options.filepath = argv[0];
+    }
+    options.filepaths.push_back(argv[0]);
+  });
   ap.arg("--device %s:DEVICE").help("Devices to use: " + device_names).action([&](auto argv) {
     parse_string(argv, &devicename);
   });
@@ -440,6 +555,21 @@ static void options_parse(const int argc, const char **argv)
   ap.arg("--tile-size %d:TILE_SIZE").help("Tile size in pixels").action([&](auto argv) {
     parse_int(argv, &options.session_params.tile_size);
   });
+  ap.arg("--seed %d:SEED").help("Override the integrator seed").action([&](auto argv) {
+    parse_int(argv, &options.seed);
+  });
+  ap.arg("--benchmark %s:REPORT")
+      .help("Render all given scenes in background and write timings as JSON to REPORT")
+      .action([&](auto argv) { parse_string(argv, &options.benchmark_filepath); });
+  ap.arg("--benchmark-baseline %s:BASELINE")
+      .help("Compare the benchmark against a previously written report")
+      .action([&](auto argv) { parse_string(argv, &options.benchmark_baseline_filepath); });
+  ap.arg("--benchmark-tolerance %f:TOLERANCE")
+      .help("Relative change allowed before reporting a regression (default 0.05)")
+      .action([&](auto argv) { parse_float(argv, &options.benchmark_tolerance); });
+  ap.arg("--update-timeline %s:TIMELINE")
+      .help("Write scene update timings as Chrome trace JSON to TIMELINE")
+      .action([&](auto argv) { parse_string(argv, &options.update_timeline_filepath); });
   ap.arg("--list-devices", &list).help("List information about all available devices");
   ap.arg("--profile", &profile).help("Enable profile logging");
 #ifdef WITH_CYCLES_LOGGING
@@ -497,6 +627,12 @@ static void options_parse(const int argc, const char **argv)
   options.session_params.background = true;
 #endif
 
+  if (!options.benchmark_filepath.empty()) {
+    /* Render exactly the requested samples without interruptions. */
+    options.session_params.background = true;
+    options.session_params.time_limit = 0.0;
+  }
+
   if (options.session_params.tile_size > 0) {
     options.session_params.use_auto_tile = true;
   }
@@ -528,6 +664,10 @@ static void options_parse(const int argc, const char **argv)
     exit(EXIT_FAILURE);
   }
 #endif
+  else if (!options.benchmark_baseline_filepath.empty() && options.benchmark_filepath.empty()) {
+    fprintf(stderr, "Benchmark baseline specified without --benchmark\n");
+    exit(EXIT_FAILURE);
+  }
   else if (options.session_params.samples < 0) {
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
@@ -548,6 +688,10 @@ int main(const int argc, const char **argv)
   path_init();
   options_parse(argc, argv);
 
+  if (!options.benchmark_filepath.empty()) {
+    return benchmark_run();
+  }
+
 #ifdef WITH_CYCLES_STANDALONE_GUI
   if (options.session_params.background) {
 #endif
@@ -1053,6 +1053,11 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    use_compact_geometry: BoolProperty(
+        name="Compact Geometry",
+        description="Store mesh normals in reduced precision to save memory, with a negligible effect on shading",
+        default=False,
+    )
 
     # Various fine-tuning debug flags
 
@@ -1472,6 +1477,12 @@ class CyclesRenderLayerSettings(bpy.types.PropertyGroup):
         default=False,
         update=update_render_passes,
     )
+    pass_debug_render_time: BoolProperty(
+        name="Debug Render Time",
+        description="Time in milliseconds spent rendering each pixel, over all its samples. To find the parts of the image that are most expensive to render. Only available on CPU",
+        default=False,
+        update=update_render_passes,
+    )
     use_pass_volume_direct: BoolProperty(
         name="Volume Direct",
         description="Deliver direct volumetric scattering pass",
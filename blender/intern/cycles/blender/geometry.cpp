@@ -7,6 +7,7 @@
 #include "scene/mesh.h"
 #include "scene/object.h"
 #include "scene/pointcloud.h"
+#include "scene/stats.h"
 #include "scene/volume.h"
 
 #include "blender/sync.h"
@@ -66,6 +67,21 @@ array<Node *> BlenderSync::find_used_shaders(BL::Object &b_ob)
   return used_shaders;
 }
 
+static const char *geometry_type_timeline_category(const Geometry::Type type)
+{
+  switch (type) {
+    case Geometry::MESH:
+      return "Blender Sync Mesh";
+    case Geometry::HAIR:
+      return "Blender Sync Hair";
+    case Geometry::VOLUME:
+      return "Blender Sync Volume";
+    case Geometry::POINTCLOUD:
+      return "Blender Sync Point Cloud";
+  }
+  return "Blender Sync";
+}
+
 Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
                                      BObjectInfo &b_ob_info,
                                      bool object_updated,
@@ -154,7 +170,11 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
       return;
     }
 
-    progress.set_sync_status("Synchronizing object", b_ob_info.real_object.name());
+    const string object_name = b_ob_info.real_object.name();
+    const scoped_callback_timer timer = timeline_timer(geometry_type_timeline_category(geom_type),
+                                                       object_name);
+
+    progress.set_sync_status("Synchronizing object", object_name);
 
     if (geom_type == Geometry::HAIR) {
       Hair *hair = static_cast<Hair *>(geom);
@@ -40,6 +40,10 @@ void BlenderSync::sync_light(BL::Object &b_parent,
     }
   }
 
+  /* Only look up the object name when the timeline is recorded. */
+  const scoped_callback_timer timer = timeline_timer(
+      "Blender Sync Light", scene->update_stats ? b_ob_info.real_object.name() : string());
+
   light->name = b_light.name().c_str();
 
   /* type */
@@ -64,6 +64,12 @@ bool BlenderOutputDriver::update_render_tile(const Tile &tile)
   return false;
 }
 
+bool BlenderOutputDriver::supports_partial_tiles() const
+{
+  /* Every tile is written into its own region of the render result. */
+  return true;
+}
+
 void BlenderOutputDriver::write_render_tile(const Tile &tile)
 {
   b_engine_.tile_highlight_clear_all();
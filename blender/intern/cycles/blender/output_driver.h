@@ -16,6 +16,7 @@ class BlenderOutputDriver : public OutputDriver {
   ~BlenderOutputDriver() override;
 
   void write_render_tile(const Tile &tile) override;
+  bool supports_partial_tiles() const override;
   bool update_render_tile(const Tile &tile) override;
   bool read_render_tile(const Tile &tile) override;
 
@@ -130,6 +130,11 @@ void BlenderSession::create_session()
   scene = session->scene.get();
   scene->name = b_scene.name();
 
+  /* Scene update timeline for profiling, there is no user interface for it. */
+  if (const char *timeline_filepath = getenv("CYCLES_UPDATE_TIMELINE")) {
+    scene->enable_update_timeline(timeline_filepath);
+  }
+
   /* create sync */
   sync = make_unique<BlenderSync>(
       b_engine, b_data, b_scene, scene, !background, use_developer_ui, session->progress);
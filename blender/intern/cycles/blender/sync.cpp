@@ -17,6 +17,7 @@
 #include "scene/shader.h"
 #include "scene/shader_graph.h"
 #include "scene/shader_nodes.h"
+#include "scene/stats.h"
 
 #include "device/device.h"
 
@@ -273,6 +274,7 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   }
 
   const scoped_timer timer;
+  const scoped_callback_timer total_timer = timeline_timer("Blender Sync", "sync_data");
 
   BL::ViewLayer b_view_layer = b_depsgraph.view_layer_eval();
 
@@ -283,17 +285,27 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   sync_view_layer(b_view_layer);
   sync_integrator(b_view_layer, background, denoise_device_info);
   sync_film(b_view_layer, b_v3d);
-  sync_shaders(b_depsgraph, b_v3d, auto_refresh_update);
-  sync_images();
+  {
+    const scoped_callback_timer step_timer = timeline_timer("Blender Sync", "sync_shaders");
+    sync_shaders(b_depsgraph, b_v3d, auto_refresh_update);
+  }
+  {
+    const scoped_callback_timer step_timer = timeline_timer("Blender Sync", "sync_images");
+    sync_images();
+  }
 
   geometry_synced.clear(); /* use for objects and motion sync */
 
   if (scene->need_motion() == Scene::MOTION_PASS || scene->need_motion() == Scene::MOTION_NONE ||
       scene->camera->get_motion_position() == MOTION_POSITION_CENTER)
   {
+    const scoped_callback_timer step_timer = timeline_timer("Blender Sync", "sync_objects");
     sync_objects(b_depsgraph, b_v3d);
   }
-  sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  {
+    const scoped_callback_timer step_timer = timeline_timer("Blender Sync", "sync_motion");
+    sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  }
 
   geometry_synced.clear();
 
@@ -689,6 +701,7 @@ static bool get_known_pass_type(BL::RenderPass &b_pass, PassType &type, PassMode
 
   MAP_PASS("AdaptiveAuxBuffer", PASS_ADAPTIVE_AUX_BUFFER, false);
   MAP_PASS("Debug Sample Count", PASS_SAMPLE_COUNT, false);
+  MAP_PASS("Debug Render Time", PASS_RENDER_TIME, false);
 
   MAP_PASS("Guiding Color", PASS_GUIDING_COLOR, false);
   MAP_PASS("Guiding Probability", PASS_GUIDING_PROBABILITY, false);
@@ -862,6 +875,7 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   params.use_bvh_compact_structure = RNA_boolean_get(&cscene, "debug_use_compact_bvh");
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
+  params.use_compact_geometry = RNA_boolean_get(&cscene, "use_compact_geometry");
 
   PointerRNA csscene = RNA_pointer_get(&b_scene.ptr, "cycles_curves");
   params.hair_subdivisions = get_int(csscene, "subdivisions");
@@ -1079,4 +1093,14 @@ DenoiseParams BlenderSync::get_denoise_params(BL::Scene &b_scene,
   return denoising;
 }
 
+scoped_callback_timer BlenderSync::timeline_timer(const char *category, const string &name)
+{
+  /* Statistics are checked when the timer ends, as they may get enabled during the sync. */
+  return scoped_callback_timer([scene = scene, category, name](double time) {
+    if (scene->update_stats) {
+      scene->update_stats->timeline.add_event(category, name, time);
+    }
+  });
+}
+
 CCL_NAMESPACE_END
@@ -16,6 +16,7 @@
 
 #include "util/map.h"
 #include "util/set.h"
+#include "util/time.h"
 #include "util/transform.h"
 
 CCL_NAMESPACE_BEGIN
@@ -222,6 +223,10 @@ class BlenderSync {
   /* Images. */
   void sync_images();
 
+  /* Timer which adds an event to the scene update timeline, when update statistics are
+   * enabled. */
+  scoped_callback_timer timeline_timer(const char *category, const string &name);
+
   /* util */
   void find_shader(BL::ID &id, array<Node *> &used_shaders, Shader *default_shader);
   bool BKE_object_is_modified(BL::Object &b_ob);
@@ -9,6 +9,15 @@
 CCL_NAMESPACE_BEGIN
 
 #define KERNEL_FUNCTIONS(name) KERNEL_NAME_EVAL(cpu, name), KERNEL_NAME_EVAL(cpu_avx2, name)
+#define KERNEL_SPECIALIZED_FUNCTIONS(variant, name) \
+  KERNEL_NAME_EVAL(cpu_##variant, name), KERNEL_NAME_EVAL(cpu_avx2_##variant, name)
+#define REGISTER_KERNEL_SPECIALIZED(variant, features) \
+  { \
+    features, \
+        IntegratorInitFunction( \
+            KERNEL_SPECIALIZED_FUNCTIONS(variant, integrator_init_from_camera)), \
+        IntegratorShadeFunction(KERNEL_SPECIALIZED_FUNCTIONS(variant, integrator_megakernel)) \
+  }
 
 #define REGISTER_KERNEL(name) name(KERNEL_FUNCTIONS(name))
 #define REGISTER_KERNEL_FILM_CONVERT(name) \
@@ -20,6 +29,9 @@ CPUKernels::CPUKernels()
       REGISTER_KERNEL(integrator_init_from_camera),
       REGISTER_KERNEL(integrator_init_from_bake),
       REGISTER_KERNEL(integrator_megakernel),
+      integrator_specialized{
+          REGISTER_KERNEL_SPECIALIZED(simple, KERNEL_FEATURES_CPU_SIMPLE),
+          REGISTER_KERNEL_SPECIALIZED(no_volume, KERNEL_FEATURES_CPU_NO_VOLUME)},
       /* Shader evaluation. */
       REGISTER_KERNEL(shader_eval_displace),
       REGISTER_KERNEL(shader_eval_background),
@@ -46,8 +58,26 @@ CPUKernels::CPUKernels()
 {
 }
 
+const CPUKernels::IntegratorSpecializedKernels *CPUKernels::get_integrator_specialized(
+    const uint kernel_features) const
+{
+  if (!DebugFlags().cpu.specialized_kernels) {
+    return nullptr;
+  }
+
+  for (const IntegratorSpecializedKernels &kernels : integrator_specialized) {
+    if ((kernel_features & ~kernels.supported_features) == 0) {
+      return &kernels;
+    }
+  }
+
+  return nullptr;
+}
+
 #undef REGISTER_KERNEL
 #undef REGISTER_KERNEL_FILM_CONVERT
+#undef REGISTER_KERNEL_SPECIALIZED
+#undef KERNEL_SPECIALIZED_FUNCTIONS
 #undef KERNEL_FUNCTIONS
 
 CCL_NAMESPACE_END
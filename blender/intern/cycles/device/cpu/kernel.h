@@ -32,6 +32,21 @@ class CPUKernels {
   IntegratorInitFunction integrator_init_from_bake;
   IntegratorShadeFunction integrator_megakernel;
 
+  /* Path tracing kernels compiled for a subset of the kernel features. Scenes which only use
+   * those features avoid the code size and branches of the unused features. */
+  struct IntegratorSpecializedKernels {
+    uint supported_features;
+    IntegratorInitFunction init_from_camera;
+    IntegratorShadeFunction megakernel;
+  };
+
+  /* Ordered from the most to the least specialized. */
+  IntegratorSpecializedKernels integrator_specialized[2];
+
+  /* Get the most specialized kernels supporting all of the given features, or nullptr if the
+   * generic kernels are to be used. */
+  const IntegratorSpecializedKernels *get_integrator_specialized(const uint kernel_features) const;
+
   /* Shader evaluation. */
 
   using ShaderEvalFunction = CPUKernelFunction<void (*)(
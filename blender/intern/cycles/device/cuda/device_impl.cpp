@@ -598,6 +598,14 @@ void CUDADevice::mem_copy_to(device_memory &mem)
   }
 }
 
+void CUDADevice::mem_copy_range_to(device_memory &mem, const size_t offset, const size_t size)
+{
+  /* Global memory keeps its device pointer, so only the range needs to be copied. */
+  if (!generic_copy_range_to(mem, offset, size)) {
+    mem_copy_to(mem);
+  }
+}
+
 void CUDADevice::mem_copy_from(
     device_memory &mem, const size_t y, size_t w, const size_t h, size_t elem)
 {
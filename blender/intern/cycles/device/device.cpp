@@ -456,6 +456,11 @@ DeviceInfo Device::get_multi_device(const vector<DeviceInfo> &subdevices,
   return info;
 }
 
+void Device::mem_copy_range_to(device_memory &mem, const size_t /*offset*/, const size_t /*size*/)
+{
+  mem_copy_to(mem);
+}
+
 void Device::tag_update()
 {
   free_memory();
@@ -809,6 +814,22 @@ void GPUDevice::generic_copy_to(device_memory &mem)
   }
 }
 
+bool GPUDevice::generic_copy_range_to(device_memory &mem, const size_t offset, const size_t size)
+{
+  if (!mem.host_pointer || !mem.device_pointer || mem.type == MEM_TEXTURE ||
+      mem.device_size != mem.memory_size() || offset + size > mem.memory_size())
+  {
+    return false;
+  }
+
+  const thread_scoped_lock lock(device_mem_map_mutex);
+  if (!device_mem_map[&mem].use_mapped_host || mem.host_pointer != mem.shared_pointer) {
+    copy_host_to_device(
+        (char *)mem.device_pointer + offset, (char *)mem.host_pointer + offset, size);
+  }
+  return true;
+}
+
 /* DeviceInfo */
 
 CCL_NAMESPACE_END
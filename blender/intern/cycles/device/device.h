@@ -315,6 +315,9 @@ class Device {
 
   virtual void mem_alloc(device_memory &mem) = 0;
   virtual void mem_copy_to(device_memory &mem) = 0;
+  /* Copy a byte range of memory that is already allocated on the device. Devices that can't
+   * update part of the memory copy all of it. */
+  virtual void mem_copy_range_to(device_memory &mem, const size_t offset, const size_t size);
   virtual void mem_copy_from(
       device_memory &mem, const size_t y, size_t w, const size_t h, size_t elem) = 0;
   virtual void mem_zero(device_memory &mem) = 0;
@@ -392,6 +395,8 @@ class GPUDevice : public Device {
   virtual GPUDevice::Mem *generic_alloc(device_memory &mem, const size_t pitch_padding = 0);
   virtual void generic_free(device_memory &mem);
   virtual void generic_copy_to(device_memory &mem);
+  /* Copy a byte range, returns false if the memory must be copied entirely instead. */
+  bool generic_copy_range_to(device_memory &mem, const size_t offset, const size_t size);
 
   /* total - amount of device memory, free - amount of available device memory */
   virtual void get_device_memory_info(size_t &total, size_t &free) = 0;
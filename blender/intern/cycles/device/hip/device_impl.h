@@ -72,6 +72,8 @@ class HIPDevice : public GPUDevice {
 
   void mem_copy_to(device_memory &mem) override;
 
+  void mem_copy_range_to(device_memory &mem, const size_t offset, const size_t size) override;
+
   void mem_copy_from(
       device_memory &mem, const size_t y, size_t w, const size_t h, size_t elem) override;
 
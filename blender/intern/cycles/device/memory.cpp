@@ -86,6 +86,13 @@ void device_memory::device_copy_to()
   }
 }
 
+void device_memory::device_copy_range_to(const size_t offset, const size_t size)
+{
+  if (host_pointer) {
+    device->mem_copy_range_to(*this, offset, size);
+  }
+}
+
 void device_memory::device_copy_from(const size_t y, const size_t w, size_t h, const size_t elem)
 {
   assert(type != MEM_TEXTURE && type != MEM_READ_ONLY && type != MEM_GLOBAL);
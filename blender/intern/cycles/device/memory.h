@@ -288,6 +288,7 @@ class device_memory {
   void device_alloc();
   void device_free();
   void device_copy_to();
+  void device_copy_range_to(const size_t offset, const size_t size);
   void device_copy_from(const size_t y, const size_t w, size_t h, const size_t elem);
   void device_zero();
 
@@ -529,6 +530,17 @@ template<typename T> class device_vector : public device_memory {
     }
   }
 
+  /* Copy a range of elements to the device. Memory that was not allocated on the device with
+   * the current size yet is copied entirely. */
+  void copy_to_device(const size_t offset, const size_t size)
+  {
+    if (data_size != 0) {
+      assert(offset + size <= data_size);
+      const size_t elem_size = data_elements * datatype_size(data_type);
+      device_copy_range_to(offset * elem_size, size * elem_size);
+    }
+  }
+
   void copy_to_device_if_modified()
   {
     if (!modified) {
@@ -365,6 +365,34 @@ class MultiDevice : public Device {
     stats.mem_alloc(mem.device_size - existing_size);
   }
 
+  void mem_copy_range_to(device_memory &mem, const size_t offset, const size_t size) override
+  {
+    /* Memory that is not allocated with the same size yet is copied entirely, so that pointers
+     * in kernel globals are updated on all devices of an island. */
+    if (!mem.device_pointer || mem.type == MEM_TEXTURE || mem.device_size != mem.memory_size()) {
+      mem_copy_to(mem);
+      return;
+    }
+
+    device_ptr key = mem.device_pointer;
+    size_t existing_size = mem.device_size;
+
+    /* The range is copied to the owner of the memory in each island, the other devices of the
+     * island keep pointing to the same memory. */
+    for (const vector<SubDevice *> &island : peer_islands) {
+      SubDevice *owner_sub = find_suitable_mem_device(key, island);
+      mem.device = owner_sub->device.get();
+      mem.device_pointer = owner_sub->ptr_map[key];
+      mem.device_size = existing_size;
+
+      owner_sub->device->mem_copy_range_to(mem, offset, size);
+    }
+
+    mem.device = this;
+    mem.device_pointer = key;
+    mem.device_size = existing_size;
+  }
+
   void mem_copy_from(
       device_memory &mem, const size_t y, size_t w, const size_t h, size_t elem) override
   {
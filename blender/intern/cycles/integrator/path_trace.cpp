@@ -1028,18 +1028,65 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
 
   progress_set_status("Reading full buffer from disk");
 
+  /* Without denoising the frame is read and written in bands of rows, so that the full frame is
+   * never in memory at once. Denoising needs the full frame, and so do output drivers which can
+   * only write the full frame. */
+  RenderBuffers band_buffers(cpu_device_.get());
+  DenoiseParams denoise_params;
+  int full_height = 0;
+  if (!tile_manager_.read_buffer_band_from_disk(
+          filename, 0, &band_buffers, &denoise_params, &full_height))
+  {
+    full_buffer_read_error();
+    return;
+  }
+
+  const bool use_denoise = denoise_params.use && denoiser_;
+  const bool is_full_frame = band_buffers.params.height >= full_height;
+  const bool write_bands = output_driver_ && output_driver_->supports_partial_tiles();
+  if (use_denoise || !(is_full_frame || write_bands)) {
+    band_buffers.buffer.free();
+    process_full_buffer_from_disk_full_frame(filename);
+    return;
+  }
+
+  const string layer_view_name = get_layer_view_name(band_buffers);
+
+  render_state_.has_denoised_result = false;
+
+  progress_set_status(layer_view_name, "Finishing");
+
+  int y = 0;
+  while (true) {
+    full_frame_state_.render_buffers = &band_buffers;
+    full_frame_state_.render_tile_offset = make_int2(0, y);
+
+    tile_buffer_write();
+
+    full_frame_state_.render_buffers = nullptr;
+    full_frame_state_.render_tile_offset = make_int2(0, 0);
+
+    y += band_buffers.params.height;
+    if (y >= full_height || (progress_ && progress_->get_cancel())) {
+      break;
+    }
+
+    if (!tile_manager_.read_buffer_band_from_disk(
+            filename, y, &band_buffers, &denoise_params, &full_height))
+    {
+      full_buffer_read_error();
+      return;
+    }
+  }
+}
+
+void PathTrace::process_full_buffer_from_disk_full_frame(string_view filename)
+{
   RenderBuffers full_frame_buffers(cpu_device_.get());
 
   DenoiseParams denoise_params;
   if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params)) {
-    const string error_message = "Error reading tiles from file";
-    if (progress_) {
-      progress_->set_error(error_message);
-      progress_->set_cancel(error_message);
-    }
-    else {
-      LOG(ERROR) << error_message;
-    }
+    full_buffer_read_error();
     return;
   }
 
@@ -1078,6 +1125,18 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
   full_frame_state_.render_buffers = nullptr;
 }
 
+void PathTrace::full_buffer_read_error()
+{
+  const string error_message = "Error reading tiles from file";
+  if (progress_) {
+    progress_->set_error(error_message);
+    progress_->set_cancel(error_message);
+  }
+  else {
+    LOG(ERROR) << error_message;
+  }
+}
+
 int PathTrace::get_num_render_tile_samples() const
 {
   if (full_frame_state_.render_buffers) {
@@ -1148,7 +1207,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.render_tile_offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
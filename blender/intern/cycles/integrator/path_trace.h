@@ -241,6 +241,12 @@ class PathTrace {
   /* Write current tile into the file on disk. */
   void tile_buffer_write_to_disk();
 
+  /* Read, optionally denoise and write the full frame file from disk, all in memory at once. */
+  void process_full_buffer_from_disk_full_frame(string_view filename);
+
+  /* Report failure of reading the full frame file from disk. */
+  void full_buffer_read_error();
+
   /* Run the progress_update_cb callback if it is needed. */
   void progress_update_if_needed(const RenderWork &render_work);
 
@@ -355,6 +361,9 @@ class PathTrace {
   /* State of the full frame processing and writing to the software. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+
+    /* Offset of the render buffers in the full frame, when it is processed in bands. */
+    int2 render_tile_offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
@@ -20,6 +20,7 @@
 #include "session/buffers.h"
 
 #include "util/tbb.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -74,6 +75,12 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
+  /* Baking uses its own init kernel, which is only available in the generic kernels. */
+  const CPUKernels::IntegratorSpecializedKernels *specialized_kernels =
+      device_scene_->data.bake.use ?
+          nullptr :
+          kernels_.get_integrator_specialized(device_scene_->data.kernel_features);
+
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
   local_arena.execute([&]() {
     parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
@@ -97,7 +104,7 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
 
       ThreadKernelGlobalsCPU *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
 
-      render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+      render_samples_full_pipeline(kernel_globals, work_tile, samples_num, specialized_kernels);
     });
   });
   if (device_->profiler.active()) {
@@ -109,12 +116,21 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
   statistics.occupancy = 1.0f;
 }
 
-void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kernel_globals,
-                                                    const KernelWorkTile &work_tile,
-                                                    const int samples_num)
+void PathTraceWorkCPU::render_samples_full_pipeline(
+    ThreadKernelGlobalsCPU *kernel_globals,
+    const KernelWorkTile &work_tile,
+    const int samples_num,
+    const CPUKernels::IntegratorSpecializedKernels *specialized_kernels)
 {
   const bool has_bake = device_scene_->data.bake.use;
 
+  const CPUKernels::IntegratorInitFunction &init_from_camera =
+      specialized_kernels ? specialized_kernels->init_from_camera :
+                            kernels_.integrator_init_from_camera;
+  const CPUKernels::IntegratorShadeFunction &megakernel = specialized_kernels ?
+                                                              specialized_kernels->megakernel :
+                                                              kernels_.integrator_megakernel;
+
   IntegratorStateCPU integrator_states[2];
 
   IntegratorStateCPU *state = &integrator_states[0];
@@ -128,6 +144,18 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
   KernelWorkTile sample_work_tile = work_tile;
   float *render_buffer = buffers_->buffer.data();
 
+  /* Time all samples of the pixel at once, the work tile is a single pixel which is only
+   * rendered by this thread. */
+  float *render_time_pixel = nullptr;
+  double render_time_start = 0.0;
+  if (device_scene_->data.film.pass_render_time != PASS_UNUSED) {
+    const int64_t render_pixel_index = work_tile.offset + work_tile.x +
+                                       int64_t(work_tile.y) * work_tile.stride;
+    render_time_pixel = render_buffer + render_pixel_index * device_scene_->data.film.pass_stride +
+                        device_scene_->data.film.pass_render_time;
+    render_time_start = time_dt();
+  }
+
   for (int sample = 0; sample < samples_num; ++sample) {
     if (is_cancel_requested()) {
       break;
@@ -141,14 +169,13 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
       }
     }
     else {
-      if (!kernels_.integrator_init_from_camera(
-              kernel_globals, state, &sample_work_tile, render_buffer))
+      if (!init_from_camera(kernel_globals, state, &sample_work_tile, render_buffer))
       {
         break;
       }
     }
 
-    kernels_.integrator_megakernel(kernel_globals, state, render_buffer);
+    megakernel(kernel_globals, state, render_buffer);
 
 #ifdef WITH_PATH_GUIDING
     if (kernel_globals->data.integrator.train_guiding) {
@@ -158,11 +185,15 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
 #endif
 
     if (shadow_catcher_state) {
-      kernels_.integrator_megakernel(kernel_globals, shadow_catcher_state, render_buffer);
+      megakernel(kernel_globals, shadow_catcher_state, render_buffer);
     }
 
     ++sample_work_tile.start_sample;
   }
+
+  if (render_time_pixel) {
+    *render_time_pixel += float((time_dt() - render_time_start) * 1000.0);
+  }
 }
 
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
@@ -7,6 +7,7 @@
 #include "kernel/device/cpu/globals.h"
 #include "kernel/integrator/state.h"
 
+#include "device/cpu/kernel.h"
 #include "device/queue.h"
 
 #include "integrator/path_trace_work.h"
@@ -19,8 +20,6 @@ struct KernelWorkTile;
 struct ThreadKernelGlobalsCPU;
 struct IntegratorStateCPU;
 
-class CPUKernels;
-
 /* Implementation of PathTraceWork which schedules work on to queues pixel-by-pixel,
  * for CPU devices.
  *
@@ -69,10 +68,13 @@ class PathTraceWorkCPU : public PathTraceWork {
 #endif
 
  protected:
-  /* Core path tracing routine. Renders given work time on the given queue. */
-  void render_samples_full_pipeline(ThreadKernelGlobalsCPU *kernel_globals,
-                                    const KernelWorkTile &work_tile,
-                                    const int samples_num);
+  /* Core path tracing routine. Renders given work time on the given queue.
+   * Uses the specialized kernels when given, and the generic ones otherwise. */
+  void render_samples_full_pipeline(
+      ThreadKernelGlobalsCPU *kernel_globals,
+      const KernelWorkTile &work_tile,
+      const int samples_num,
+      const CPUKernels::IntegratorSpecializedKernels *specialized_kernels);
 
   /* CPU kernels. */
   const CPUKernels &kernels_;
@@ -38,4 +38,22 @@ void kernel_global_memory_copy(KernelGlobalsCPU *kg,
 #define KERNEL_ARCH cpu_avx2
 #include "kernel/device/cpu/kernel_arch.h"
 
+/* Path tracing kernels specialized for scenes using a subset of the kernel features. */
+
+#define KERNEL_ARCH cpu_simple
+#define KERNEL_ARCH_INTEGRATOR_ONLY
+#include "kernel/device/cpu/kernel_arch.h"
+
+#define KERNEL_ARCH cpu_avx2_simple
+#define KERNEL_ARCH_INTEGRATOR_ONLY
+#include "kernel/device/cpu/kernel_arch.h"
+
+#define KERNEL_ARCH cpu_no_volume
+#define KERNEL_ARCH_INTEGRATOR_ONLY
+#include "kernel/device/cpu/kernel_arch.h"
+
+#define KERNEL_ARCH cpu_avx2_no_volume
+#define KERNEL_ARCH_INTEGRATOR_ONLY
+#include "kernel/device/cpu/kernel_arch.h"
+
 CCL_NAMESPACE_END
@@ -2,7 +2,10 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
-/* Templated common declaration part of all CPU kernels. */
+/* Templated common declaration part of all CPU kernels.
+ *
+ * When KERNEL_ARCH_INTEGRATOR_ONLY is defined only the path tracing kernels are declared, for
+ * kernels specialized for a subset of the kernel features. */
 
 /* --------------------------------------------------------------------
  * Integrator.
@@ -33,6 +36,8 @@ KERNEL_INTEGRATOR_SHADE_FUNCTION(megakernel);
 #undef KERNEL_INTEGRATOR_INIT_FUNCTION
 #undef KERNEL_INTEGRATOR_SHADE_FUNCTION
 
+#ifndef KERNEL_ARCH_INTEGRATOR_ONLY
+
 #define KERNEL_FILM_CONVERT_FUNCTION(name) \
   void KERNEL_FUNCTION_FULL_NAME(film_convert_##name)(const KernelFilmConvert *kfilm_convert, \
                                                       const float *buffer, \
@@ -119,4 +124,7 @@ void KERNEL_FUNCTION_FULL_NAME(cryptomatte_postprocess)(const ThreadKernelGlobal
                                                         ccl_global float *render_buffer,
                                                         int pixel_index);
 
+#endif /* KERNEL_ARCH_INTEGRATOR_ONLY */
+
+#undef KERNEL_ARCH_INTEGRATOR_ONLY
 #undef KERNEL_ARCH
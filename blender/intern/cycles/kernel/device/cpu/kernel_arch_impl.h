@@ -6,6 +6,9 @@
  *
  * The idea is that particular .cpp files sets needed optimization flags and
  * simply includes this file without worry of copying actual implementation over.
+ *
+ * When KERNEL_ARCH_INTEGRATOR_ONLY is defined only the path tracing kernels are implemented. This
+ * is used for kernels specialized for a subset of the kernel features with __KERNEL_FEATURES__.
  */
 
 #pragma once
@@ -96,6 +99,8 @@ DEFINE_INTEGRATOR_INIT_KERNEL(init_from_camera)
 DEFINE_INTEGRATOR_INIT_KERNEL(init_from_bake)
 DEFINE_INTEGRATOR_SHADE_KERNEL(megakernel)
 
+#ifndef KERNEL_ARCH_INTEGRATOR_ONLY
+
 /* --------------------------------------------------------------------
  * Shader evaluation.
  */
@@ -284,6 +289,8 @@ KERNEL_FILM_CONVERT_FUNCTION(float4, false)
 
 #undef KERNEL_FILM_CONVERT_FUNCTION
 
+#endif /* KERNEL_ARCH_INTEGRATOR_ONLY */
+
 #undef KERNEL_INVOKE
 #undef DEFINE_INTEGRATOR_KERNEL
 #undef DEFINE_INTEGRATOR_SHADE_KERNEL
@@ -291,6 +298,7 @@ KERNEL_FILM_CONVERT_FUNCTION(float4, false)
 
 #undef KERNEL_STUB
 #undef STUB_ASSERT
+#undef KERNEL_ARCH_INTEGRATOR_ONLY
 #undef KERNEL_ARCH
 
 CCL_NAMESPACE_END
@@ -0,0 +1,16 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+/* CPU path tracing kernels specialized for scenes without volumes, shadow catchers and MNEE.
+ * Code for the other features is not compiled in, see KERNEL_FEATURES_CPU_NO_VOLUME. */
+
+#define __KERNEL_FEATURES__ KERNEL_FEATURES_CPU_NO_VOLUME
+
+#include "kernel/device/cpu/arch_default.h"
+
+#include "kernel/device/cpu/globals.h"
+#include "kernel/device/cpu/kernel.h"
+#define KERNEL_ARCH cpu_no_volume
+#define KERNEL_ARCH_INTEGRATOR_ONLY
+#include "kernel/device/cpu/kernel_arch_impl.h"
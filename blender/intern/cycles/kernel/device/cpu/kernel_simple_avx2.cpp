@@ -0,0 +1,17 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+/* CPU path tracing kernels specialized for scenes without volumes, subsurface scattering, hair,
+ * point clouds, motion blur, shadow catchers, light linking and light tree.
+ * Code for the other features is not compiled in, see KERNEL_FEATURES_CPU_SIMPLE. */
+
+#define __KERNEL_FEATURES__ KERNEL_FEATURES_CPU_SIMPLE
+
+#include "kernel/device/cpu/arch_avx2.h"
+
+#include "kernel/device/cpu/globals.h"
+#include "kernel/device/cpu/kernel.h"
+#define KERNEL_ARCH cpu_avx2_simple
+#define KERNEL_ARCH_INTEGRATOR_ONLY
+#include "kernel/device/cpu/kernel_arch_impl.h"
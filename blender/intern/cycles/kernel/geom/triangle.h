@@ -18,6 +18,15 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Smooth normal of a mesh vertex. */
+ccl_device_forceinline float3 triangle_vertex_normal(KernelGlobals kg, const uint vert)
+{
+  if (kernel_data.bvh.use_compact_normals) {
+    return decode_normal_octahedral(kernel_data_fetch(tri_vnormal_compact, vert));
+  }
+  return kernel_data_fetch(tri_vnormal, vert);
+}
+
 /* Normal on triangle. */
 ccl_device_inline float3 triangle_normal(KernelGlobals kg, ccl_private ShaderData *sd)
 {
@@ -88,9 +97,9 @@ ccl_device_inline void triangle_vertices_and_normals(KernelGlobals kg,
   P[1] = kernel_data_fetch(tri_verts, tri_vindex.y);
   P[2] = kernel_data_fetch(tri_verts, tri_vindex.z);
 
-  N[0] = kernel_data_fetch(tri_vnormal, tri_vindex.x);
-  N[1] = kernel_data_fetch(tri_vnormal, tri_vindex.y);
-  N[2] = kernel_data_fetch(tri_vnormal, tri_vindex.z);
+  N[0] = triangle_vertex_normal(kg, tri_vindex.x);
+  N[1] = triangle_vertex_normal(kg, tri_vindex.y);
+  N[2] = triangle_vertex_normal(kg, tri_vindex.z);
 }
 
 /* Interpolate smooth vertex normal from vertices */
@@ -101,9 +110,9 @@ triangle_smooth_normal(KernelGlobals kg, const float3 Ng, const int prim, const
   /* load triangle vertices */
   const uint3 tri_vindex = kernel_data_fetch(tri_vindex, prim);
 
-  const float3 n0 = kernel_data_fetch(tri_vnormal, tri_vindex.x);
-  const float3 n1 = kernel_data_fetch(tri_vnormal, tri_vindex.y);
-  const float3 n2 = kernel_data_fetch(tri_vnormal, tri_vindex.z);
+  const float3 n0 = triangle_vertex_normal(kg, tri_vindex.x);
+  const float3 n1 = triangle_vertex_normal(kg, tri_vindex.y);
+  const float3 n2 = triangle_vertex_normal(kg, tri_vindex.z);
 
   const float3 N = safe_normalize((1.0f - u - v) * n0 + u * n1 + v * n2);
 
@@ -120,9 +129,9 @@ ccl_device_inline float3 triangle_smooth_normal_unnormalized(KernelGlobals kg,
   /* load triangle vertices */
   const uint3 tri_vindex = kernel_data_fetch(tri_vindex, prim);
 
-  float3 n0 = kernel_data_fetch(tri_vnormal, tri_vindex.x);
-  float3 n1 = kernel_data_fetch(tri_vnormal, tri_vindex.y);
-  float3 n2 = kernel_data_fetch(tri_vnormal, tri_vindex.z);
+  float3 n0 = triangle_vertex_normal(kg, tri_vindex.x);
+  float3 n1 = triangle_vertex_normal(kg, tri_vindex.y);
+  float3 n2 = triangle_vertex_normal(kg, tri_vindex.z);
 
   /* ensure that the normals are in object space */
   if (sd->object_flag & SD_OBJECT_TRANSFORM_APPLIED) {
@@ -137,7 +137,8 @@ ccl_device_forceinline void integrate_surface_emission(KernelGlobals kg,
    * light sources. */
   if (kernel_data.kernel_features & KERNEL_FEATURE_SHADOW_LINKING) {
     if (!(path_flag & PATH_RAY_CAMERA) &&
-        kernel_data_fetch(objects, sd->object).shadow_set_membership != LIGHT_LINK_MASK_ALL)
+        kernel_data_fetch(object_light_linking, sd->object).shadow_set_membership !=
+            LIGHT_LINK_MASK_ALL)
     {
       return;
     }
@@ -69,77 +69,91 @@ CCL_NAMESPACE_BEGIN
 
 // NOLINTEND
 
-/* Kernel Features */
+/* Kernel Features
+ *
+ * These are defines rather than an enum, so that they can be used in the preprocessor checks for
+ * __KERNEL_FEATURES__ below. */
 
 /* Shader nodes. */
-enum {
-  KERNEL_FEATURE_NODE_BSDF = (1U << 0U),
-  KERNEL_FEATURE_NODE_EMISSION = (1U << 1U),
-  KERNEL_FEATURE_NODE_VOLUME = (1U << 2U),
-  KERNEL_FEATURE_NODE_BUMP = (1U << 3U),
-  KERNEL_FEATURE_NODE_BUMP_STATE = (1U << 4U),
-  KERNEL_FEATURE_NODE_VORONOI_EXTRA = (1U << 5U),
-  KERNEL_FEATURE_NODE_RAYTRACE = (1U << 6U),
-  KERNEL_FEATURE_NODE_AOV = (1U << 7U),
-  KERNEL_FEATURE_NODE_LIGHT_PATH = (1U << 8U),
-  KERNEL_FEATURE_NODE_PRINCIPLED_HAIR = (1U << 9U),
+#define KERNEL_FEATURE_NODE_BSDF (1U << 0U)
+#define KERNEL_FEATURE_NODE_EMISSION (1U << 1U)
+#define KERNEL_FEATURE_NODE_VOLUME (1U << 2U)
+#define KERNEL_FEATURE_NODE_BUMP (1U << 3U)
+#define KERNEL_FEATURE_NODE_BUMP_STATE (1U << 4U)
+#define KERNEL_FEATURE_NODE_VORONOI_EXTRA (1U << 5U)
+#define KERNEL_FEATURE_NODE_RAYTRACE (1U << 6U)
+#define KERNEL_FEATURE_NODE_AOV (1U << 7U)
+#define KERNEL_FEATURE_NODE_LIGHT_PATH (1U << 8U)
+#define KERNEL_FEATURE_NODE_PRINCIPLED_HAIR (1U << 9U)
 
-  /* Use path tracing kernels. */
-  KERNEL_FEATURE_PATH_TRACING = (1U << 10U),
+/* Use path tracing kernels. */
+#define KERNEL_FEATURE_PATH_TRACING (1U << 10U)
 
-  /* BVH/sampling kernel features. */
-  KERNEL_FEATURE_POINTCLOUD = (1U << 11U),
-  KERNEL_FEATURE_HAIR = (1U << 12U),
-  KERNEL_FEATURE_HAIR_THICK = (1U << 13U),
-  KERNEL_FEATURE_OBJECT_MOTION = (1U << 14U),
+/* BVH/sampling kernel features. */
+#define KERNEL_FEATURE_POINTCLOUD (1U << 11U)
+#define KERNEL_FEATURE_HAIR (1U << 12U)
+#define KERNEL_FEATURE_HAIR_THICK (1U << 13U)
+#define KERNEL_FEATURE_OBJECT_MOTION (1U << 14U)
 
-  /* Denotes whether baking functionality is needed. */
-  KERNEL_FEATURE_BAKING = (1U << 15U),
+/* Denotes whether baking functionality is needed. */
+#define KERNEL_FEATURE_BAKING (1U << 15U)
 
-  /* Use subsurface scattering materials. */
-  KERNEL_FEATURE_SUBSURFACE = (1U << 16U),
+/* Use subsurface scattering materials. */
+#define KERNEL_FEATURE_SUBSURFACE (1U << 16U)
 
-  /* Use volume materials. */
-  KERNEL_FEATURE_VOLUME = (1U << 17U),
+/* Use volume materials. */
+#define KERNEL_FEATURE_VOLUME (1U << 17U)
 
-  /* Use OpenSubdiv patch evaluation */
-  KERNEL_FEATURE_PATCH_EVALUATION = (1U << 18U),
+/* Use OpenSubdiv patch evaluation */
+#define KERNEL_FEATURE_PATCH_EVALUATION (1U << 18U)
 
-  /* Use Transparent shadows */
-  KERNEL_FEATURE_TRANSPARENT = (1U << 19U),
+/* Use Transparent shadows */
+#define KERNEL_FEATURE_TRANSPARENT (1U << 19U)
 
-  /* Use shadow catcher. */
-  KERNEL_FEATURE_SHADOW_CATCHER = (1U << 20U),
+/* Use shadow catcher. */
+#define KERNEL_FEATURE_SHADOW_CATCHER (1U << 20U)
 
-  /* Light render passes. */
-  KERNEL_FEATURE_LIGHT_PASSES = (1U << 21U),
+/* Light render passes. */
+#define KERNEL_FEATURE_LIGHT_PASSES (1U << 21U)
 
-  /* AO. */
-  KERNEL_FEATURE_AO_PASS = (1U << 22U),
-  KERNEL_FEATURE_AO_ADDITIVE = (1U << 23U),
+/* AO. */
+#define KERNEL_FEATURE_AO_PASS (1U << 22U)
+#define KERNEL_FEATURE_AO_ADDITIVE (1U << 23U)
 
-  /* MNEE. */
-  KERNEL_FEATURE_MNEE = (1U << 24U),
+/* MNEE. */
+#define KERNEL_FEATURE_MNEE (1U << 24U)
 
-  /* Path guiding. */
-  KERNEL_FEATURE_PATH_GUIDING = (1U << 25U),
+/* Path guiding. */
+#define KERNEL_FEATURE_PATH_GUIDING (1U << 25U)
 
-  /* OSL. */
-  KERNEL_FEATURE_OSL = (1U << 26U),
+/* OSL. */
+#define KERNEL_FEATURE_OSL (1U << 26U)
 
-  /* Light and shadow linking. */
-  KERNEL_FEATURE_LIGHT_LINKING = (1U << 27U),
-  KERNEL_FEATURE_SHADOW_LINKING = (1U << 28U),
+/* Light and shadow linking. */
+#define KERNEL_FEATURE_LIGHT_LINKING (1U << 27U)
+#define KERNEL_FEATURE_SHADOW_LINKING (1U << 28U)
 
-  /* Use denoising kernels and output denoising passes. */
-  KERNEL_FEATURE_DENOISING = (1U << 29U),
+/* Use denoising kernels and output denoising passes. */
+#define KERNEL_FEATURE_DENOISING (1U << 29U)
 
-  /* Light tree. */
-  KERNEL_FEATURE_LIGHT_TREE = (1U << 30U)
-};
+/* Light tree. */
+#define KERNEL_FEATURE_LIGHT_TREE (1U << 30U)
 
 #define KERNEL_FEATURE_AO (KERNEL_FEATURE_AO_PASS | KERNEL_FEATURE_AO_ADDITIVE)
 
+/* Features supported by the CPU integrator kernels which are specialized for simpler scenes. These
+ * kernels are compiled with __KERNEL_FEATURES__ set to the mask, and used when the scene does not
+ * need any feature outside of it. */
+#define KERNEL_FEATURES_CPU_SIMPLE \
+  (~(KERNEL_FEATURE_NODE_PRINCIPLED_HAIR | KERNEL_FEATURE_POINTCLOUD | KERNEL_FEATURE_HAIR | \
+     KERNEL_FEATURE_HAIR_THICK | KERNEL_FEATURE_OBJECT_MOTION | KERNEL_FEATURE_BAKING | \
+     KERNEL_FEATURE_SUBSURFACE | KERNEL_FEATURE_VOLUME | KERNEL_FEATURE_PATCH_EVALUATION | \
+     KERNEL_FEATURE_SHADOW_CATCHER | KERNEL_FEATURE_MNEE | KERNEL_FEATURE_LIGHT_LINKING | \
+     KERNEL_FEATURE_SHADOW_LINKING | KERNEL_FEATURE_LIGHT_TREE))
+#define KERNEL_FEATURES_CPU_NO_VOLUME \
+  (~(KERNEL_FEATURE_BAKING | KERNEL_FEATURE_VOLUME | KERNEL_FEATURE_SHADOW_CATCHER | \
+     KERNEL_FEATURE_MNEE))
+
 /* Shader node feature mask, to specialize shader evaluation for kernels. */
 
 #define KERNEL_FEATURE_NODE_MASK_SURFACE_LIGHT \
@@ -222,7 +236,6 @@ enum {
 #  undef __MNEE__
 #endif
 
-/* Scene-based selective features compilation. */
 /* Scene-based selective features compilation. */
 #ifdef __KERNEL_FEATURES__
 #  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_OBJECT_MOTION)
@@ -271,6 +284,9 @@ enum {
 #  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_SHADOW_LINKING)
 #    undef __SHADOW_LINKING__
 #  endif
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_LIGHT_TREE)
+#    undef __LIGHT_TREE__
+#  endif
 #endif
 
 #ifdef WITH_CYCLES_DEBUG_NAN
@@ -567,6 +583,10 @@ enum PassType {
   PASS_GUIDING_PROBABILITY,
   /* The avg. roughness at the first bounce. */
   PASS_GUIDING_AVG_ROUGHNESS,
+
+  /* Total time in milliseconds spent rendering the pixel, over all its samples. Only written by
+   * the CPU device. */
+  PASS_RENDER_TIME,
   PASS_CATEGORY_DATA_END = 63,
 
   PASS_BAKE_PRIMITIVE,
@@ -1549,14 +1569,19 @@ struct KernelObject {
 
   /* Volume velocity scale. */
   float velocity_scale;
+};
+static_assert_align(KernelObject, 16);
 
-  /* TODO: separate array to avoid memory overhead when not used. */
+/* Light and shadow linking sets of an object. Stored in a separate array which is only allocated
+ * when the scene uses light or shadow linking, to keep the per-instance data small. */
+struct KernelObjectLightLinking {
   uint64_t light_set_membership;
-  uint receiver_light_set;
   uint64_t shadow_set_membership;
+  uint receiver_light_set;
   uint blocker_shadow_set;
+  int pad1, pad2;
 };
-static_assert_align(KernelObject, 16);
+static_assert_align(KernelObjectLightLinking, 16);
 
 struct KernelCurve {
   int shader_id;
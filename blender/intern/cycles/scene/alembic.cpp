@@ -186,31 +186,31 @@ void CachedData::invalidate_last_loaded_time(bool attributes_only)
   points_shader.invalidate_last_loaded_time();
 }
 
-void CachedData::set_time_sampling(TimeSampling time_sampling)
+void CachedData::set_time_sampling(TimeSampling time_sampling, const size_t first_sample_index)
 {
-  curve_first_key.set_time_sampling(time_sampling);
-  curve_keys.set_time_sampling(time_sampling);
-  curve_radius.set_time_sampling(time_sampling);
-  curve_shader.set_time_sampling(time_sampling);
-  num_ngons.set_time_sampling(time_sampling);
-  shader.set_time_sampling(time_sampling);
-  subd_creases_edge.set_time_sampling(time_sampling);
-  subd_creases_weight.set_time_sampling(time_sampling);
-  subd_face_corners.set_time_sampling(time_sampling);
-  subd_num_corners.set_time_sampling(time_sampling);
-  subd_ptex_offset.set_time_sampling(time_sampling);
-  subd_smooth.set_time_sampling(time_sampling);
-  subd_start_corner.set_time_sampling(time_sampling);
-  transforms.set_time_sampling(time_sampling);
-  triangles.set_time_sampling(time_sampling);
-  uv_loops.set_time_sampling(time_sampling);
-  vertices.set_time_sampling(time_sampling);
-  points.set_time_sampling(time_sampling);
-  radiuses.set_time_sampling(time_sampling);
-  points_shader.set_time_sampling(time_sampling);
+  curve_first_key.set_time_sampling(time_sampling, first_sample_index);
+  curve_keys.set_time_sampling(time_sampling, first_sample_index);
+  curve_radius.set_time_sampling(time_sampling, first_sample_index);
+  curve_shader.set_time_sampling(time_sampling, first_sample_index);
+  num_ngons.set_time_sampling(time_sampling, first_sample_index);
+  shader.set_time_sampling(time_sampling, first_sample_index);
+  subd_creases_edge.set_time_sampling(time_sampling, first_sample_index);
+  subd_creases_weight.set_time_sampling(time_sampling, first_sample_index);
+  subd_face_corners.set_time_sampling(time_sampling, first_sample_index);
+  subd_num_corners.set_time_sampling(time_sampling, first_sample_index);
+  subd_ptex_offset.set_time_sampling(time_sampling, first_sample_index);
+  subd_smooth.set_time_sampling(time_sampling, first_sample_index);
+  subd_start_corner.set_time_sampling(time_sampling, first_sample_index);
+  transforms.set_time_sampling(time_sampling, first_sample_index);
+  triangles.set_time_sampling(time_sampling, first_sample_index);
+  uv_loops.set_time_sampling(time_sampling, first_sample_index);
+  vertices.set_time_sampling(time_sampling, first_sample_index);
+  points.set_time_sampling(time_sampling, first_sample_index);
+  radiuses.set_time_sampling(time_sampling, first_sample_index);
+  points_shader.set_time_sampling(time_sampling, first_sample_index);
 
   for (CachedAttribute &attr : attributes) {
-    attr.data.set_time_sampling(time_sampling);
+    attr.data.set_time_sampling(time_sampling, first_sample_index);
   }
 }
 
@@ -471,6 +471,8 @@ bool AlembicObject::has_data_loaded() const
 void AlembicObject::load_data_in_cache(CachedData &cached_data,
                                        AlembicProcedural *proc,
                                        IPolyMeshSchema &schema,
+                                       const array<Node *> &used_shaders,
+                                       const AttributeRequestSet &requested_attributes,
                                        Progress &progress)
 {
   /* Only load data for the original Geometry. */
@@ -488,7 +490,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.face_indices = schema.getFaceIndicesProperty();
   data.normals = schema.getNormalsParam();
   data.num_samples = schema.getNumSamples();
-  data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
+  data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, used_shaders);
 
   read_geometry_data(proc, cached_data, data, progress);
 
@@ -499,7 +501,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), requested_attributes, progress);
 
   if (progress.get_cancel()) {
     return;
@@ -512,6 +514,8 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
 void AlembicObject::load_data_in_cache(CachedData &cached_data,
                                        AlembicProcedural *proc,
                                        ISubDSchema &schema,
+                                       const array<Node *> &used_shaders,
+                                       const AttributeRequestSet &requested_attributes,
                                        Progress &progress)
 {
   /* Only load data for the original Geometry. */
@@ -530,7 +534,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
     data.face_indices = schema.getFaceIndicesProperty();
     data.num_samples = schema.getNumSamples();
     data.velocities = schema.getVelocitiesProperty();
-    data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
+    data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, used_shaders);
 
     read_geometry_data(proc, cached_data, data, progress);
 
@@ -541,7 +545,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
     /* Use the schema as the base compound property to also be able to look for top level
      * properties. */
     read_attributes(
-        proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+        proc, cached_data, schema, schema.getUVsParam(), requested_attributes, progress);
 
     cached_data.invalidate_last_loaded_time(true);
     data_loaded = true;
@@ -566,7 +570,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.holes = schema.getHolesProperty();
   data.subdivision_scheme = schema.getSubdivisionSchemeProperty();
   data.velocities = schema.getVelocitiesProperty();
-  data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
+  data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, used_shaders);
 
   read_geometry_data(proc, cached_data, data, progress);
 
@@ -577,7 +581,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), requested_attributes, progress);
 
   cached_data.invalidate_last_loaded_time(true);
   data_loaded = true;
@@ -586,6 +590,8 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
 void AlembicObject::load_data_in_cache(CachedData &cached_data,
                                        AlembicProcedural *proc,
                                        const ICurvesSchema &schema,
+                                       const array<Node *> &used_shaders,
+                                       const AttributeRequestSet &requested_attributes,
                                        Progress &progress)
 {
   /* Only load data for the original Geometry. */
@@ -619,7 +625,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), requested_attributes, progress);
 
   cached_data.invalidate_last_loaded_time(true);
   data_loaded = true;
@@ -628,6 +634,8 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
 void AlembicObject::load_data_in_cache(CachedData &cached_data,
                                        AlembicProcedural *proc,
                                        const IPointsSchema &schema,
+                                       const array<Node *> &used_shaders,
+                                       const AttributeRequestSet &requested_attributes,
                                        Progress &progress)
 {
   /* Only load data for the original Geometry. */
@@ -654,7 +662,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
 
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
-  read_attributes(proc, cached_data, schema, {}, get_requested_attributes(), progress);
+  read_attributes(proc, cached_data, schema, {}, requested_attributes, progress);
 
   cached_data.invalidate_last_loaded_time(true);
   data_loaded = true;
@@ -793,6 +801,7 @@ NODE_DEFINE(AlembicProcedural)
 
   SOCKET_BOOLEAN(use_prefetch, "Use Prefetch", true);
   SOCKET_INT(prefetch_cache_size, "Prefetch Cache Size", 4096);
+  SOCKET_INT(prefetch_frames, "Prefetch Frames", 0);
 
   return type;
 }
@@ -805,6 +814,9 @@ AlembicProcedural::AlembicProcedural() : Procedural(get_node_type())
 
 AlembicProcedural::~AlembicProcedural()
 {
+  prefetch_progress_.set_cancel("Alembic Procedural deleted");
+  wait_prefetch();
+
   ccl::set<Geometry *> geometries_set;
   ccl::set<Object *> objects_set;
   const ccl::set<AlembicObject *> abc_objects_set;
@@ -839,6 +851,10 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
   assert(scene_ == nullptr || scene_ == scene);
   scene_ = scene;
 
+  /* The frames loaded in the background read the objects, their geometry and shaders, which are
+   * modified below. */
+  wait_prefetch();
+
   if (frame < start_frame || frame > end_frame) {
     clear_modified();
     objects_modified = false;
@@ -926,13 +942,16 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
   }
 
-  if (use_prefetch_is_modified()) {
-    if (!use_prefetch) {
-      for (Node *node : nodes) {
-        AlembicObject *object = static_cast<AlembicObject *>(node);
-        object->clear_cache();
-      }
+  if (use_prefetch_is_modified() || prefetch_frames_is_modified()) {
+    /* Switching between loading the entire animation and streaming it, the data needs to be
+     * reloaded for the new frame ranges. */
+    for (Node *node : nodes) {
+      AlembicObject *object = static_cast<AlembicObject *>(node);
+      object->clear_cache();
     }
+
+    cached_frame_end_ = cached_frame_start_ - 1.0f;
+    prefetched_frame_end_ = prefetched_frame_start_ - 1.0f;
   }
 
   if (prefetch_cache_size_is_modified()) {
@@ -950,7 +969,12 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
   }
 
-  build_caches(progress);
+  if (use_prefetch && prefetch_frames > 0) {
+    build_streamed_caches(progress);
+  }
+  else {
+    build_caches(progress);
+  }
 
   for (Node *node : nodes) {
     AlembicObject *object = static_cast<AlembicObject *>(node);
@@ -1504,7 +1528,12 @@ void AlembicProcedural::build_caches(Progress &progress)
       if (!object->has_data_loaded()) {
         IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
         IPolyMeshSchema schema = polymesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+        object->load_data_in_cache(object->get_cached_data(),
+                                   this,
+                                   schema,
+                                   object->get_used_shaders(),
+                                   object->get_requested_attributes(),
+                                   progress);
       }
       else if (object->need_shader_update) {
         IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
@@ -1523,7 +1552,12 @@ void AlembicProcedural::build_caches(Progress &progress)
       {
         ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
         const ICurvesSchema schema = curves.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+        object->load_data_in_cache(object->get_cached_data(),
+                                   this,
+                                   schema,
+                                   object->get_used_shaders(),
+                                   object->get_requested_attributes(),
+                                   progress);
       }
     }
     else if (object->schema_type == AlembicObject::POINTS) {
@@ -1532,14 +1566,24 @@ void AlembicProcedural::build_caches(Progress &progress)
       {
         IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
         const IPointsSchema schema = points.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+        object->load_data_in_cache(object->get_cached_data(),
+                                   this,
+                                   schema,
+                                   object->get_used_shaders(),
+                                   object->get_requested_attributes(),
+                                   progress);
       }
     }
     else if (object->schema_type == AlembicObject::SUBD) {
       if (!object->has_data_loaded()) {
         ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
         ISubDSchema schema = subd_mesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+        object->load_data_in_cache(object->get_cached_data(),
+                                   this,
+                                   schema,
+                                   object->get_used_shaders(),
+                                   object->get_requested_attributes(),
+                                   progress);
       }
       else if (object->need_shader_update) {
         ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
@@ -1570,6 +1614,194 @@ void AlembicProcedural::build_caches(Progress &progress)
   VLOG_WORK << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used);
 }
 
+void AlembicProcedural::load_frames_in_cache(AlembicObject *object,
+                                             CachedData &cached_data,
+                                             const float start_frame,
+                                             const float end_frame,
+                                             const array<Node *> &used_shaders,
+                                             const AttributeRequestSet &requested_attributes,
+                                             Progress &progress)
+{
+  cached_data.use_frame_range = true;
+  cached_data.frame_range_start = static_cast<double>(start_frame);
+  cached_data.frame_range_end = static_cast<double>(end_frame);
+
+  if (object->schema_type == AlembicObject::POLY_MESH) {
+    IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+    IPolyMeshSchema schema = polymesh.getSchema();
+    object->load_data_in_cache(
+        cached_data, this, schema, used_shaders, requested_attributes, progress);
+  }
+  else if (object->schema_type == AlembicObject::CURVES) {
+    ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
+    const ICurvesSchema schema = curves.getSchema();
+    object->load_data_in_cache(
+        cached_data, this, schema, used_shaders, requested_attributes, progress);
+  }
+  else if (object->schema_type == AlembicObject::POINTS) {
+    IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
+    const IPointsSchema schema = points.getSchema();
+    object->load_data_in_cache(
+        cached_data, this, schema, used_shaders, requested_attributes, progress);
+  }
+  else if (object->schema_type == AlembicObject::SUBD) {
+    ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+    ISubDSchema schema = subd_mesh.getSchema();
+    object->load_data_in_cache(
+        cached_data, this, schema, used_shaders, requested_attributes, progress);
+  }
+
+  object->setup_transform_cache(cached_data, scale);
+}
+
+void AlembicProcedural::wait_prefetch()
+{
+  prefetch_pool_.wait_work();
+}
+
+void AlembicProcedural::build_streamed_caches(Progress &progress)
+{
+  /* Any frames loaded in the background were waited for at the start of generate(). */
+  bool need_reload = scale_is_modified() || default_radius_is_modified();
+  for (Node *node : nodes) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+    if (object->instance_of) {
+      /* Instances do not load any data. */
+      continue;
+    }
+    if (!object->has_data_loaded() || object->need_shader_update ||
+        object->radius_scale_is_modified())
+    {
+      need_reload = true;
+    }
+  }
+
+  const bool frame_is_cached = (frame >= cached_frame_start_ && frame <= cached_frame_end_);
+  const bool frame_is_prefetched = (frame >= prefetched_frame_start_ &&
+                                    frame <= prefetched_frame_end_);
+
+  if (need_reload || !frame_is_cached) {
+    if (!need_reload && frame_is_prefetched) {
+      /* Move on to the prefetched frames, freeing the frames which were rendered. */
+      for (Node *node : nodes) {
+        AlembicObject *object = static_cast<AlembicObject *>(node);
+        std::swap(object->cached_data_, object->prefetched_data_);
+        object->prefetched_data_.clear();
+      }
+
+      cached_frame_start_ = prefetched_frame_start_;
+      cached_frame_end_ = prefetched_frame_end_;
+    }
+    else {
+      /* Nothing usable was prefetched, for example when jumping to another frame. */
+      cached_frame_start_ = frame;
+      cached_frame_end_ = min(frame + static_cast<float>(prefetch_frames - 1), end_frame);
+
+      for (Node *node : nodes) {
+        AlembicObject *object = static_cast<AlembicObject *>(node);
+
+        if (progress.get_cancel()) {
+          return;
+        }
+
+        object->prefetched_data_.clear();
+        load_frames_in_cache(object,
+                             object->cached_data_,
+                             cached_frame_start_,
+                             cached_frame_end_,
+                             object->get_used_shaders(),
+                             object->get_requested_attributes(),
+                             progress);
+      }
+    }
+
+    prefetched_frame_end_ = prefetched_frame_start_ - 1.0f;
+  }
+
+  size_t memory_used = 0;
+  for (Node *node : nodes) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+    memory_used += object->get_cached_data().memory_used();
+  }
+
+  if (memory_used > get_prefetch_cache_size_in_bytes()) {
+    progress.set_error("Error: Alembic Procedural memory limit reached");
+    return;
+  }
+
+  VLOG_WORK << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used)
+            << " for frames " << cached_frame_start_ << " to " << cached_frame_end_;
+
+  if (cached_frame_end_ >= end_frame || prefetched_frame_end_ >= prefetched_frame_start_) {
+    return;
+  }
+
+  /* Read the next frames in the background while the current ones are rendered. Both sets of
+   * frames have to fit in the memory limit, otherwise the next frames are dropped and read when
+   * they are needed. */
+  prefetched_frame_start_ = cached_frame_end_ + 1.0f;
+  prefetched_frame_end_ = min(prefetched_frame_start_ + static_cast<float>(prefetch_frames - 1),
+                              end_frame);
+
+  /* The shaders and their attribute requests can be modified by the next call to generate()
+   * while the frames are loaded, so copy them before starting the task. */
+  struct PrefetchObject {
+    AlembicObject *object;
+    array<Node *> used_shaders;
+    AttributeRequestSet requested_attributes;
+  };
+  vector<PrefetchObject> prefetch_objects;
+  prefetch_objects.reserve(nodes.size());
+  for (Node *node : nodes) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+    prefetch_objects.push_back(
+        {object, object->get_used_shaders(), object->get_requested_attributes()});
+  }
+
+  const size_t memory_limit = get_prefetch_cache_size_in_bytes();
+  const float start = prefetched_frame_start_;
+  const float end = prefetched_frame_end_;
+  prefetch_pool_.push([this,
+                       prefetch_objects = std::move(prefetch_objects),
+                       start,
+                       end,
+                       memory_used,
+                       memory_limit]() {
+    size_t prefetch_memory_used = 0;
+
+    for (const PrefetchObject &prefetch_object : prefetch_objects) {
+      AlembicObject *object = prefetch_object.object;
+
+      if (prefetch_progress_.get_cancel()) {
+        return;
+      }
+
+      load_frames_in_cache(object,
+                           object->prefetched_data_,
+                           start,
+                           end,
+                           prefetch_object.used_shaders,
+                           prefetch_object.requested_attributes,
+                           prefetch_progress_);
+
+      prefetch_memory_used += object->prefetched_data_.memory_used();
+      if (memory_used + prefetch_memory_used > memory_limit) {
+        break;
+      }
+    }
+
+    if (memory_used + prefetch_memory_used > memory_limit) {
+      VLOG_WORK << "AlembicProcedural memory limit reached while prefetching frames " << start
+                << " to " << end;
+
+      for (const PrefetchObject &prefetch_object : prefetch_objects) {
+        prefetch_object.object->prefetched_data_.clear();
+      }
+      prefetched_frame_end_ = prefetched_frame_start_ - 1.0f;
+    }
+  });
+}
+
 CCL_NAMESPACE_END
 
 #endif
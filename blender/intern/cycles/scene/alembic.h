@@ -7,6 +7,8 @@
 #include "graph/node.h"
 #include "scene/attribute.h"
 #include "scene/procedural.h"
+#include "util/progress.h"
+#include "util/task.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -134,6 +136,9 @@ template<typename T> class DataStore {
 
   Alembic::AbcCoreAbstract::TimeSampling time_sampling{};
 
+  /* Index of the time sample of the first entry, when only a range of the animation is loaded. */
+  size_t first_sample_index = 0;
+
   double last_loaded_time = std::numeric_limits<double>::max();
 
  public:
@@ -141,9 +146,11 @@ template<typename T> class DataStore {
   Alembic::AbcCoreAbstract::ArraySample::Key key1;
   Alembic::AbcCoreAbstract::ArraySample::Key key2;
 
-  void set_time_sampling(Alembic::AbcCoreAbstract::TimeSampling time_sampling_)
+  void set_time_sampling(Alembic::AbcCoreAbstract::TimeSampling time_sampling_,
+                         const size_t first_sample_index_ = 0)
   {
     time_sampling = time_sampling_;
+    first_sample_index = first_sample_index_;
   }
 
   Alembic::AbcCoreAbstract::TimeSampling get_time_sampling() const
@@ -234,6 +241,7 @@ template<typename T> class DataStore {
     invalidate_last_loaded_time();
     data.clear();
     index_data_map.clear();
+    first_sample_index = 0;
   }
 
   void invalidate_last_loaded_time()
@@ -276,8 +284,11 @@ template<typename T> class DataStore {
   const TimeIndexPair &get_index_for_time(const double time) const
   {
     std::pair<size_t, Alembic::Abc::chrono_t> index_pair;
-    index_pair = time_sampling.getNearIndex(time, index_data_map.size());
-    return index_data_map[index_pair.first];
+    index_pair = time_sampling.getNearIndex(time, first_sample_index + index_data_map.size());
+    const size_t index = (index_pair.first > first_sample_index) ?
+                             index_pair.first - first_sample_index :
+                             0;
+    return index_data_map[index];
   }
 };
 
@@ -329,6 +340,12 @@ struct CachedData {
 
   vector<CachedAttribute> attributes{};
 
+  /* Range of frames to load, instead of the range decided by the procedural. Used when streaming
+   * the animation, this is not reset when clearing the data. */
+  bool use_frame_range = false;
+  double frame_range_start = 0.0;
+  double frame_range_end = 0.0;
+
   void clear();
 
   CachedAttribute &add_attribute(const ustring &name,
@@ -338,7 +355,8 @@ struct CachedData {
 
   void invalidate_last_loaded_time(bool attributes_only = false);
 
-  void set_time_sampling(Alembic::AbcCoreAbstract::TimeSampling time_sampling);
+  void set_time_sampling(Alembic::AbcCoreAbstract::TimeSampling time_sampling,
+                         const size_t first_sample_index = 0);
 
   size_t memory_used() const;
 };
@@ -387,18 +405,26 @@ class AlembicObject : public Node {
   void load_data_in_cache(CachedData &cached_data,
                           AlembicProcedural *proc,
                           Alembic::AbcGeom::IPolyMeshSchema &schema,
+                          const array<Node *> &used_shaders,
+                          const AttributeRequestSet &requested_attributes,
                           Progress &progress);
   void load_data_in_cache(CachedData &cached_data,
                           AlembicProcedural *proc,
                           Alembic::AbcGeom::ISubDSchema &schema,
+                          const array<Node *> &used_shaders,
+                          const AttributeRequestSet &requested_attributes,
                           Progress &progress);
   void load_data_in_cache(CachedData &cached_data,
                           AlembicProcedural *proc,
                           const Alembic::AbcGeom::ICurvesSchema &schema,
+                          const array<Node *> &used_shaders,
+                          const AttributeRequestSet &requested_attributes,
                           Progress &progress);
   void load_data_in_cache(CachedData &cached_data,
                           AlembicProcedural *proc,
                           const Alembic::AbcGeom::IPointsSchema &schema,
+                          const array<Node *> &used_shaders,
+                          const AttributeRequestSet &requested_attributes,
                           Progress &progress);
 
   bool has_data_loaded() const;
@@ -437,6 +463,9 @@ class AlembicObject : public Node {
   void clear_cache()
   {
     cached_data_.clear();
+    cached_data_.use_frame_range = false;
+    prefetched_data_.clear();
+    data_loaded = false;
   }
 
   Object *object = nullptr;
@@ -445,6 +474,10 @@ class AlembicObject : public Node {
 
   CachedData cached_data_;
 
+  /* Data for the frames following the ones in cached_data_, loaded in the background when
+   * streaming the animation. */
+  CachedData prefetched_data_;
+
   void setup_transform_cache(CachedData &cached_data, const float scale);
 
   AttributeRequestSet get_requested_attributes();
@@ -458,6 +491,9 @@ class AlembicObject : public Node {
  * This procedural will load the data set for the entire animation in memory on the first frame,
  * and directly set the data for the new frames on the created Nodes if needed. This allows for
  * faster updates between frames as it avoids reseeking the data on disk.
+ *
+ * For long animations, the data can instead be streamed: only a window of frames starting at
+ * the current one is kept in memory, while the next window is read in a background thread.
  */
 class AlembicProcedural : public Procedural {
   Alembic::AbcGeom::IArchive archive;
@@ -505,6 +541,11 @@ class AlembicProcedural : public Procedural {
    */
   NODE_SOCKET_API(int, prefetch_cache_size)
 
+  /* Number of frames to load ahead of the current frame when prefetching. The data is streamed in
+   * windows of this many frames, with the next window being read in the background while the
+   * current one is rendered. Zero loads the entire animation at once. */
+  NODE_SOCKET_API(int, prefetch_frames)
+
   AlembicProcedural();
   ~AlembicProcedural() override;
 
@@ -556,6 +597,32 @@ class AlembicProcedural : public Procedural {
 
   void build_caches(Progress &progress);
 
+  /* Make sure the caches contain the data for the current frame when streaming, and start loading
+   * the following frames in the background. */
+  void build_streamed_caches(Progress &progress);
+
+  /* Load the data for the given range of frames of the object in the cache. */
+  void load_frames_in_cache(AlembicObject *object,
+                            CachedData &cached_data,
+                            const float start_frame,
+                            const float end_frame,
+                            const array<Node *> &used_shaders,
+                            const AttributeRequestSet &requested_attributes,
+                            Progress &progress);
+
+  /* Wait for the frames being loaded in the background. */
+  void wait_prefetch();
+
+  /* Frames in the caches used for rendering, and the frames loaded by the background prefetch
+   * when streaming. The ranges are empty if the end is before the start. */
+  float cached_frame_start_ = 0.0f;
+  float cached_frame_end_ = -1.0f;
+  float prefetched_frame_start_ = 0.0f;
+  float prefetched_frame_end_ = -1.0f;
+
+  TaskPool prefetch_pool_;
+  Progress prefetch_progress_;
+
   size_t get_prefetch_cache_size_in_bytes() const
   {
     /* prefetch_cache_size is in megabytes, so convert to bytes. */
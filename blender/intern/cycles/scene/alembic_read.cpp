@@ -22,12 +22,17 @@ static float3 make_float3_from_yup(const V3f &v)
   return make_float3(v.x, -v.z, v.y);
 }
 
-/* get the sample times to load data for the given the start and end frame of the procedural */
+/* get the sample times to load data for the given the start and end frame of the procedural, or
+ * the frame range of the cache if it has one. The index of the first sample is returned in
+ * r_first_sample_index. */
 static set<chrono_t> get_relevant_sample_times(AlembicProcedural *proc,
+                                               const CachedData &cached_data,
                                                const TimeSampling &time_sampling,
-                                               const size_t num_samples)
+                                               const size_t num_samples,
+                                               size_t *r_first_sample_index)
 {
   set<chrono_t> result;
+  *r_first_sample_index = 0;
 
   if (num_samples < 2) {
     result.insert(0.0);
@@ -37,7 +42,12 @@ static set<chrono_t> get_relevant_sample_times(AlembicProcedural *proc,
   double start_frame;
   double end_frame;
 
-  if (proc->get_use_prefetch()) {
+  if (cached_data.use_frame_range) {
+    // load the data for the frames streamed by the procedural
+    start_frame = cached_data.frame_range_start;
+    end_frame = cached_data.frame_range_end;
+  }
+  else if (proc->get_use_prefetch()) {
     // load the data for the entire animation
     start_frame = static_cast<double>(proc->get_start_frame());
     end_frame = static_cast<double>(proc->get_end_frame());
@@ -59,6 +69,7 @@ static set<chrono_t> get_relevant_sample_times(AlembicProcedural *proc,
     result.insert(time_sampling.getSampleTime(i));
   }
 
+  *r_first_sample_index = start_index;
   return result;
 }
 
@@ -72,10 +83,11 @@ static void read_data_loop(AlembicProcedural *proc,
                            DataReadingFunc &&func,
                            Progress &progress)
 {
+  size_t first_sample_index;
   const std::set<chrono_t> times = get_relevant_sample_times(
-      proc, *params.time_sampling, params.num_samples);
+      proc, cached_data, *params.time_sampling, params.num_samples, &first_sample_index);
 
-  cached_data.set_time_sampling(*params.time_sampling);
+  cached_data.set_time_sampling(*params.time_sampling, first_sample_index);
 
   for (const chrono_t time : times) {
     if (progress.get_cancel()) {
@@ -900,8 +912,9 @@ static void read_attribute_loop(AlembicProcedural *proc,
                                 Progress &progress,
                                 AttributeStandard std = ATTR_STD_NONE)
 {
+  size_t first_sample_index;
   const std::set<chrono_t> times = get_relevant_sample_times(
-      proc, *param.getTimeSampling(), param.getNumSamples());
+      proc, cache, *param.getTimeSampling(), param.getNumSamples(), &first_sample_index);
 
   if (times.empty()) {
     return;
@@ -925,7 +938,7 @@ static void read_attribute_loop(AlembicProcedural *proc,
 
   using abc_type = typename TRAIT::value_type;
 
-  attribute.data.set_time_sampling(*param.getTimeSampling());
+  attribute.data.set_time_sampling(*param.getTimeSampling(), first_sample_index);
   attribute.std = std;
   attribute.type_desc = value_type_converter<abc_type>::type_desc;
 
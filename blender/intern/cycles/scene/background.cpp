@@ -55,7 +55,7 @@ void Background::device_update(Device *device, DeviceScene *dscene, Scene *scene
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->background.times.add_entry({"device_update", time});
+      scene->update_stats->background.add_entry({"device_update", time});
     }
   });
 
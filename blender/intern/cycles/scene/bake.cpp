@@ -67,7 +67,7 @@ void BakeManager::device_update(Device * /*device*/,
   if (use_baking_) {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->bake.times.add_entry({"device_update", time});
+        scene->update_stats->bake.add_entry({"device_update", time});
       }
     });
 
@@ -233,7 +233,7 @@ void Camera::update(Scene *scene)
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->camera.times.add_entry({"update", time});
+      scene->update_stats->camera.add_entry({"update", time});
     }
   });
 
@@ -493,7 +493,7 @@ void Camera::device_update(Device * /*device*/, DeviceScene *dscene, Scene *scen
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->camera.times.add_entry({"device_update", time});
+      scene->update_stats->camera.add_entry({"device_update", time});
     }
   });
 
@@ -530,6 +530,12 @@ void Camera::device_update_volume(Device * /*device*/, DeviceScene *dscene, Scen
     return;
   }
 
+  const scoped_callback_timer timer([scene](double time) {
+    if (scene->update_stats) {
+      scene->update_stats->camera.add_entry({"device_update_volume", time});
+    }
+  });
+
   KernelIntegrator *kintegrator = &dscene->data.integrator;
   if (kintegrator->use_volumes) {
     KernelCamera *kcam = &dscene->data.cam;
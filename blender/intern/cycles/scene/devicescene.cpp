@@ -20,6 +20,7 @@ DeviceScene::DeviceScene(Device *device)
       tri_verts(device, "tri_verts", MEM_GLOBAL),
       tri_shader(device, "tri_shader", MEM_GLOBAL),
       tri_vnormal(device, "tri_vnormal", MEM_GLOBAL),
+      tri_vnormal_compact(device, "tri_vnormal_compact", MEM_GLOBAL),
       tri_vindex(device, "tri_vindex", MEM_GLOBAL),
       tri_patch(device, "tri_patch", MEM_GLOBAL),
       tri_patch_uv(device, "tri_patch_uv", MEM_GLOBAL),
@@ -30,6 +31,7 @@ DeviceScene::DeviceScene(Device *device)
       points(device, "points", MEM_GLOBAL),
       points_shader(device, "points_shader", MEM_GLOBAL),
       objects(device, "objects", MEM_GLOBAL),
+      object_light_linking(device, "object_light_linking", MEM_GLOBAL),
       object_motion_pass(device, "object_motion_pass", MEM_GLOBAL),
       object_motion(device, "object_motion", MEM_GLOBAL),
       object_flag(device, "object_flag", MEM_GLOBAL),
@@ -141,7 +141,7 @@ void Film::device_update(Device *device, DeviceScene *dscene, Scene *scene)
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->film.times.add_entry({"update", time});
+      scene->update_stats->film.add_entry({"update", time});
     }
   });
 
@@ -200,6 +200,8 @@ void Film::device_update(Device *device, DeviceScene *dscene, Scene *scene)
   kfilm->pass_guiding_probability = PASS_UNUSED;
   kfilm->pass_guiding_avg_roughness = PASS_UNUSED;
 
+  kfilm->pass_render_time = PASS_UNUSED;
+
   bool have_cryptomatte = false;
   bool have_aov_color = false;
   bool have_aov_value = false;
@@ -391,6 +393,9 @@ void Film::device_update(Device *device, DeviceScene *dscene, Scene *scene)
       case PASS_GUIDING_AVG_ROUGHNESS:
         kfilm->pass_guiding_avg_roughness = kfilm->pass_stride;
         break;
+      case PASS_RENDER_TIME:
+        kfilm->pass_render_time = kfilm->pass_stride;
+        break;
       default:
         assert(false);
         break;
@@ -355,7 +355,7 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->geometry.times.add_entry({"device_update_preprocess", time});
+      scene->update_stats->geometry.add_entry({"device_update_preprocess", time});
     }
   });
 
@@ -515,6 +515,7 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
     if (device_update_flags & DEVICE_MESH_DATA_NEEDS_REALLOC) {
       dscene->tri_verts.tag_realloc();
       dscene->tri_vnormal.tag_realloc();
+      dscene->tri_vnormal_compact.tag_realloc();
       dscene->tri_vindex.tag_realloc();
       dscene->tri_patch.tag_realloc();
       dscene->tri_patch_uv.tag_realloc();
@@ -583,6 +584,7 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
      * these are the only arrays that can be updated */
     dscene->tri_verts.tag_modified();
     dscene->tri_vnormal.tag_modified();
+    dscene->tri_vnormal_compact.tag_modified();
     dscene->tri_shader.tag_modified();
   }
 
@@ -722,7 +724,7 @@ void GeometryManager::device_update(Device *device,
   {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry({"device_update (normals)", time});
+        scene->update_stats->geometry.add_entry({"device_update (normals)", time});
       }
     });
 
@@ -780,8 +782,7 @@ void GeometryManager::device_update(Device *device,
   if (total_tess_needed) {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry(
-            {"device_update (adaptive subdivision)", time});
+        scene->update_stats->geometry.add_entry({"device_update (adaptive subdivision)", time});
       }
     });
 
@@ -830,7 +831,7 @@ void GeometryManager::device_update(Device *device,
   if (true_displacement_used || curve_shadow_transparency_used) {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry(
+        scene->update_stats->geometry.add_entry(
             {"device_update (displacement: load images)", time});
       }
     });
@@ -847,7 +848,7 @@ void GeometryManager::device_update(Device *device,
   if (true_displacement_used || curve_shadow_transparency_used) {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry(
+        scene->update_stats->geometry.add_entry(
             {"device_update (displacement: copy meshes to device)", time});
       }
     });
@@ -860,7 +861,7 @@ void GeometryManager::device_update(Device *device,
   {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry({"device_update (attributes)", time});
+        scene->update_stats->geometry.add_entry({"device_update (attributes)", time});
       }
     });
     device_update_attributes(device, dscene, scene, progress);
@@ -880,7 +881,7 @@ void GeometryManager::device_update(Device *device,
 
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry({"device_update (displacement)", time});
+        scene->update_stats->geometry.add_entry({"device_update (displacement)", time});
       }
     });
 
@@ -920,7 +921,7 @@ void GeometryManager::device_update(Device *device,
   if (displacement_done || curve_shadow_transparency_done) {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry(
+        scene->update_stats->geometry.add_entry(
             {"device_update (displacement: attributes)", time});
       }
     });
@@ -942,7 +943,7 @@ void GeometryManager::device_update(Device *device,
   {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry({"device_update (build object BVHs)", time});
+        scene->update_stats->geometry.add_entry({"device_update (build object BVHs)", time});
       }
     });
     TaskPool pool;
@@ -952,6 +953,11 @@ void GeometryManager::device_update(Device *device,
       if (geom->is_modified() || geom->need_update_bvh_for_offset) {
         need_update_scene_bvh = true;
         pool.push([geom, device, dscene, scene, &progress, i, num_bvh] {
+          const scoped_callback_timer timer([geom, scene](double time) {
+            if (scene->update_stats) {
+              scene->update_stats->timeline.add_event("Geometry BVH", geom->name.string(), time);
+            }
+          });
           geom->compute_bvh(device, dscene, &scene->params, &progress, i, num_bvh);
         });
         if (geom->need_build_bvh(bvh_layout)) {
@@ -978,7 +984,7 @@ void GeometryManager::device_update(Device *device,
   {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry({"device_update (compute bounds)", time});
+        scene->update_stats->geometry.add_entry({"device_update (compute bounds)", time});
       }
     });
     for (Object *object : scene->objects) {
@@ -993,7 +999,7 @@ void GeometryManager::device_update(Device *device,
   if (need_update_scene_bvh) {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry({"device_update (build scene BVH)", time});
+        scene->update_stats->geometry.add_entry({"device_update (build scene BVH)", time});
       }
     });
     device_update_bvh(device, dscene, scene, progress);
@@ -1010,8 +1016,7 @@ void GeometryManager::device_update(Device *device,
   {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->geometry.times.add_entry(
-            {"device_update (copy meshes to device)", time});
+        scene->update_stats->geometry.add_entry({"device_update (copy meshes to device)", time});
       }
     });
     device_update_mesh(device, dscene, scene, progress);
@@ -1047,6 +1052,7 @@ void GeometryManager::device_update(Device *device,
   dscene->tri_vindex.clear_modified();
   dscene->tri_patch.clear_modified();
   dscene->tri_vnormal.clear_modified();
+  dscene->tri_vnormal_compact.clear_modified();
   dscene->tri_patch_uv.clear_modified();
   dscene->curves.clear_modified();
   dscene->curve_keys.clear_modified();
@@ -1075,6 +1081,7 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool forc
   dscene->tri_verts.free_if_need_realloc(force_free);
   dscene->tri_shader.free_if_need_realloc(force_free);
   dscene->tri_vnormal.free_if_need_realloc(force_free);
+  dscene->tri_vnormal_compact.free_if_need_realloc(force_free);
   dscene->tri_vindex.free_if_need_realloc(force_free);
   dscene->tri_patch.free_if_need_realloc(force_free);
   dscene->tri_patch_uv.free_if_need_realloc(force_free);
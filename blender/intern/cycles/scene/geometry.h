@@ -256,7 +256,8 @@ class GeometryManager {
                              DeviceScene *dscene,
                              Scene *scene,
                              vector<AttributeRequestSet> &geom_attributes,
-                             vector<AttributeRequestSet> &object_attributes);
+                             vector<AttributeRequestSet> &object_attributes,
+                             const vector<int> &object_attribute_source);
 
   /* Compute verts/triangles/curves offsets in global arrays. */
   void geom_calc_offset(Scene *scene, BVHLayout bvh_layout);
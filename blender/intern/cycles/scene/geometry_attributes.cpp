@@ -153,7 +153,8 @@ void GeometryManager::update_svm_attributes(Device * /*unused*/,
                                             DeviceScene *dscene,
                                             Scene *scene,
                                             vector<AttributeRequestSet> &geom_attributes,
-                                            vector<AttributeRequestSet> &object_attributes)
+                                            vector<AttributeRequestSet> &object_attributes,
+                                            const vector<int> &object_attribute_source)
 {
   /* for SVM, the attributes_map table is used to lookup the offset of an
    * attribute, based on a unique shader attribute id. */
@@ -188,7 +189,10 @@ void GeometryManager::update_svm_attributes(Device * /*unused*/,
     Object *object = scene->objects[i];
 
     /* only allocate a table for the object if it actually has attributes */
-    if (object_attributes[i].size() == 0) {
+    if (object_attribute_source[i] != i) {
+      object->attr_map_offset = scene->objects[object_attribute_source[i]]->attr_map_offset;
+    }
+    else if (object_attributes[i].size() == 0) {
       object->attr_map_offset = 0;
     }
     else {
@@ -540,6 +544,35 @@ void GeometryManager::device_update_attributes(Device *device,
     }
   }
 
+  /* Objects that instance the same geometry with identical attribute values share a single
+   * attribute map and storage, so scenes with many instances of few prototypes do not store
+   * the same values once per instance. */
+  vector<int> object_attribute_source(scene->objects.size());
+  unordered_map<string, int> object_attribute_keys;
+
+  for (size_t i = 0; i < scene->objects.size(); i++) {
+    object_attribute_source[i] = i;
+
+    if (object_attributes[i].size() == 0) {
+      continue;
+    }
+
+    const Geometry *geom = scene->objects[i]->geometry;
+    string key((const char *)&geom, sizeof(geom));
+    for (const Attribute &attr : object_attribute_values[i].attributes) {
+      key += attr.name.string();
+      key.append((const char *)&attr.type, sizeof(attr.type));
+      key.append(attr.buffer.data(), attr.buffer.size());
+    }
+
+    const auto [it, inserted] = object_attribute_keys.emplace(key, i);
+    if (!inserted) {
+      object_attribute_source[i] = it->second;
+      object_attributes[i].clear();
+      object_attribute_values[i].clear();
+    }
+  }
+
   /* mesh attribute are stored in a single array per data type. here we fill
    * those arrays, and set the offset and element type to create attribute
    * maps next */
@@ -726,7 +759,8 @@ void GeometryManager::device_update_attributes(Device *device,
     update_osl_globals(device, scene);
   }
 
-  update_svm_attributes(device, dscene, scene, geom_attributes, object_attributes);
+  update_svm_attributes(
+      device, dscene, scene, geom_attributes, object_attributes, object_attribute_source);
 
   if (progress.get_cancel()) {
     return;
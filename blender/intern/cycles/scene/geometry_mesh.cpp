@@ -79,9 +79,15 @@ void GeometryManager::device_update_mesh(Device * /*unused*/,
     /* normals */
     progress.set_status("Updating Mesh", "Computing normals");
 
+    /* Compact geometry stores octahedral encoded normals, 4 instead of 12 bytes per vertex. */
+    const bool use_compact_normals = scene->params.use_compact_geometry;
+    dscene->data.bvh.use_compact_normals = use_compact_normals;
+
     packed_float3 *tri_verts = dscene->tri_verts.alloc(vert_size);
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
-    packed_float3 *vnormal = dscene->tri_vnormal.alloc(vert_size);
+    packed_float3 *vnormal = use_compact_normals ? nullptr : dscene->tri_vnormal.alloc(vert_size);
+    uint *vnormal_compact = use_compact_normals ? dscene->tri_vnormal_compact.alloc(vert_size) :
+                                                  nullptr;
     packed_uint3 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
     uint *tri_patch = dscene->tri_patch.alloc(tri_size);
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
@@ -89,6 +95,7 @@ void GeometryManager::device_update_mesh(Device * /*unused*/,
     const bool copy_all_data = dscene->tri_shader.need_realloc() ||
                                dscene->tri_vindex.need_realloc() ||
                                dscene->tri_vnormal.need_realloc() ||
+                               dscene->tri_vnormal_compact.need_realloc() ||
                                dscene->tri_patch.need_realloc() ||
                                dscene->tri_patch_uv.need_realloc();
 
@@ -103,7 +110,12 @@ void GeometryManager::device_update_mesh(Device * /*unused*/,
         }
 
         if (mesh->verts_is_modified() || copy_all_data) {
-          mesh->pack_normals(&vnormal[mesh->vert_offset]);
+          if (use_compact_normals) {
+            mesh->pack_normals_compact(&vnormal_compact[mesh->vert_offset]);
+          }
+          else {
+            mesh->pack_normals(&vnormal[mesh->vert_offset]);
+          }
         }
 
         if (mesh->verts_is_modified() || mesh->triangles_is_modified() ||
@@ -127,6 +139,7 @@ void GeometryManager::device_update_mesh(Device * /*unused*/,
     dscene->tri_verts.copy_to_device_if_modified();
     dscene->tri_shader.copy_to_device_if_modified();
     dscene->tri_vnormal.copy_to_device_if_modified();
+    dscene->tri_vnormal_compact.copy_to_device_if_modified();
     dscene->tri_vindex.copy_to_device_if_modified();
     dscene->tri_patch.copy_to_device_if_modified();
     dscene->tri_patch_uv.copy_to_device_if_modified();
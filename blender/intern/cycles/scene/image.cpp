@@ -692,6 +692,12 @@ void ImageManager::device_load_image(Device *device,
 
   progress.set_status("Updating Images", "Loading " + img->loader->name());
 
+  const scoped_callback_timer timer([scene, img](double time) {
+    if (scene->update_stats) {
+      scene->update_stats->timeline.add_event("Image Load", img->loader->name(), time);
+    }
+  });
+
   const int texture_limit = scene->params.texture_limit;
 
   load_image_metadata(img);
@@ -851,7 +857,7 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->image.times.add_entry({"device_update", time});
+      scene->update_stats->image.add_entry({"device_update", time});
     }
   });
 
@@ -176,7 +176,7 @@ void Integrator::device_update(Device *device, DeviceScene *dscene, Scene *scene
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->integrator.times.add_entry({"device_update", time});
+      scene->update_stats->integrator.add_entry({"device_update", time});
     }
   });
 
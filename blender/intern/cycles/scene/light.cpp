@@ -149,7 +149,7 @@ Light::Light() : Node(get_node_type())
 void Light::tag_update(Scene *scene)
 {
   if (is_modified()) {
-    scene->light_manager->tag_update(scene, LightManager::LIGHT_MODIFIED);
+    scene->light_manager->tag_emitter_modified(scene, this);
   }
 }
 
@@ -217,6 +217,8 @@ LightManager::LightManager()
   last_background_resolution = 0;
 }
 
+LightManager::~LightManager() = default;
+
 bool LightManager::has_background_light(Scene *scene)
 {
   for (Light *light : scene->lights) {
@@ -486,20 +488,26 @@ struct LightTreeFlatten {
   std::unordered_map<LightTreeNode *, int> instances;
 };
 
+static void light_tree_measure_copy_to_device(KernelLightTreeNode &knode,
+                                              const LightTreeMeasure &measure)
+{
+  knode.energy = measure.energy;
+
+  knode.bbox.min = measure.bbox.min;
+  knode.bbox.max = measure.bbox.max;
+
+  knode.bcone.axis = measure.bcone.axis;
+  knode.bcone.theta_o = measure.bcone.theta_o;
+  knode.bcone.theta_e = measure.bcone.theta_e;
+}
+
 static void light_tree_node_copy_to_device(KernelLightTreeNode &knode,
                                            const LightTreeNode &node,
                                            const int left_child,
                                            const int right_child)
 {
   /* Convert node to kernel representation. */
-  knode.energy = node.measure.energy;
-
-  knode.bbox.min = node.measure.bbox.min;
-  knode.bbox.max = node.measure.bbox.max;
-
-  knode.bcone.axis = node.measure.bcone.axis;
-  knode.bcone.theta_o = node.measure.bcone.theta_o;
-  knode.bcone.theta_e = node.measure.bcone.theta_e;
+  light_tree_measure_copy_to_device(knode, node.measure);
 
   knode.bit_trail = node.bit_trail;
   knode.bit_skip = 0;
@@ -517,7 +525,7 @@ static void light_tree_node_copy_to_device(KernelLightTreeNode &knode,
 }
 
 static int light_tree_flatten(LightTreeFlatten &flatten,
-                              const LightTreeNode *node,
+                              LightTreeNode *node,
                               KernelLightTreeNode *knodes,
                               KernelLightTreeEmitter *kemitters,
                               int &next_node_index);
@@ -594,39 +602,44 @@ static void light_tree_leaf_emitters_copy_and_flatten(LightTreeFlatten &flatten,
 
       auto map_it = flatten.instances.find(reference_node);
       if (map_it == flatten.instances.end()) {
-        if (instance_node != reference_node) {
-          /* Flatten the node with the subtree first so the subsequent instances know the index. */
-          std::swap(instance_node->type, reference_node->type);
-          std::swap(instance_node->variant_type, reference_node->variant_type);
-        }
-        instance_node->type &= ~LIGHT_TREE_INSTANCE;
-      }
-
-      kemitter.mesh.node_id = light_tree_flatten(
-          flatten, instance_node, knodes, kemitters, next_node_index);
-
-      KernelLightTreeNode &kinstance_node = knodes[kemitter.mesh.node_id];
-      kinstance_node.bit_trail = node.bit_trail;
+        /* Flatten the subtree at the first instance so the subsequent instances know the index.
+         * The tree itself is left unchanged, so it can be flattened again after refitting. */
+        kemitter.mesh.node_id = light_tree_flatten(
+            flatten, reference_node, knodes, kemitters, next_node_index);
+        flatten.instances[reference_node] = kemitter.mesh.node_id;
 
-      if (map_it != flatten.instances.end()) {
-        kinstance_node.instance.reference = map_it->second;
+        KernelLightTreeNode &kinstance_node = knodes[kemitter.mesh.node_id];
+        kinstance_node.type = static_cast<LightTreeNodeType>(kinstance_node.type &
+                                                             ~LIGHT_TREE_INSTANCE);
+        light_tree_measure_copy_to_device(kinstance_node, instance_node->measure);
       }
       else {
-        flatten.instances[reference_node] = kemitter.mesh.node_id;
+        /* Instance node that only references the subtree. This may be the reference node itself,
+         * when another instance was flattened first. */
+        kemitter.mesh.node_id = next_node_index++;
+
+        KernelLightTreeNode &kinstance_node = knodes[kemitter.mesh.node_id];
+        light_tree_node_copy_to_device(kinstance_node, *instance_node, -1, -1);
+        kinstance_node.type = LIGHT_TREE_INSTANCE;
+        kinstance_node.num_emitters = -1;
+        kinstance_node.instance.reference = map_it->second;
       }
+
+      knodes[kemitter.mesh.node_id].bit_trail = node.bit_trail;
     }
     kemitter.bit_trail = node.bit_trail;
   }
 }
 
 static int light_tree_flatten(LightTreeFlatten &flatten,
-                              const LightTreeNode *node,
+                              LightTreeNode *node,
                               KernelLightTreeNode *knodes,
                               KernelLightTreeEmitter *kemitters,
                               int &next_node_index)
 {
   /* Convert both inner nodes and primitives to device representation. */
   const int node_index = next_node_index++;
+  node->device_index = node_index;
   int left_child = -1;
   int right_child = -1;
 
@@ -791,6 +804,57 @@ static std::pair<int, LightTreeMeasure> light_tree_specialize_nodes_flatten(
   return std::make_pair(node_index, new_node.measure);
 }
 
+/* Copy the elements at the given indices to the device, merging consecutive indices into a single
+ * copy. */
+template<typename T>
+static void light_tree_copy_indices_to_device(device_vector<T> &array, vector<int> &indices)
+{
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  for (size_t i = 0; i < indices.size();) {
+    size_t end = i + 1;
+    while (end < indices.size() && indices[end] == indices[end - 1] + 1) {
+      end++;
+    }
+    array.copy_to_device(indices[i], indices[end - 1] - indices[i] + 1);
+    i = end;
+  }
+}
+
+/* Update the nodes and emitters changed by refitting the light tree in the flattened arrays, and
+ * copy only those to the device. */
+static void light_tree_refit_copy_to_device(DeviceScene *dscene, const LightTree &light_tree)
+{
+  KernelLightTreeNode *knodes = dscene->light_tree_nodes.data();
+  KernelLightTreeEmitter *kemitters = dscene->light_tree_emitters.data();
+  const LightTreeEmitter *emitters = light_tree.get_emitters();
+
+  vector<int> node_indices;
+  for (const LightTreeNode *node : light_tree.refit_nodes) {
+    light_tree_measure_copy_to_device(knodes[node->device_index], node->measure);
+    node_indices.push_back(node->device_index);
+  }
+
+  vector<int> emitter_indices = light_tree.refit_emitters;
+  for (const int emitter_index : emitter_indices) {
+    const LightTreeEmitter &emitter = emitters[emitter_index];
+    KernelLightTreeEmitter &kemitter = kemitters[emitter_index];
+    kemitter.energy = emitter.measure.energy;
+    kemitter.theta_o = emitter.measure.bcone.theta_o;
+    kemitter.theta_e = emitter.measure.bcone.theta_e;
+
+    if (emitter.is_mesh()) {
+      /* The instance node holds the measure of the mesh transformed by the object. */
+      light_tree_measure_copy_to_device(knodes[kemitter.mesh.node_id], emitter.root->measure);
+      node_indices.push_back(kemitter.mesh.node_id);
+    }
+  }
+
+  light_tree_copy_indices_to_device(dscene->light_tree_nodes, node_indices);
+  light_tree_copy_indices_to_device(dscene->light_tree_emitters, emitter_indices);
+}
+
 void LightManager::device_update_tree(Device * /*unused*/,
                                       DeviceScene *dscene,
                                       Scene *scene,
@@ -799,49 +863,70 @@ void LightManager::device_update_tree(Device * /*unused*/,
   KernelIntegrator *kintegrator = &dscene->data.integrator;
 
   if (!kintegrator->use_light_tree) {
+    device_free_tree(dscene);
     return;
   }
 
   /* Update light tree. */
   progress.set_status("Updating Lights", "Computing tree");
 
-  /* TODO: For now, we'll start with a smaller number of max lights in a node.
-   * More benchmarking is needed to determine what number works best. */
-  LightTree light_tree(scene, dscene, progress, 8);
-  LightTreeNode *root = light_tree.build(scene, dscene);
-  if (progress.get_cancel()) {
-    return;
+  /* When only lights and emissive object transforms changed, refit the existing tree instead of
+   * building a new one. Unless subtrees had to be built again, only the changed nodes and emitters
+   * are updated on the device. */
+  const uint32_t refit_flags = EMITTER_MODIFIED | OBJECT_MODIFIED;
+  if (light_tree && !(update_flags & ~refit_flags) &&
+      light_tree->refit(scene, dscene, modified_lights, modified_objects))
+  {
+    if (!light_tree->refit_topology_changed) {
+      VLOG_INFO << "Refitted light tree, updated " << light_tree->refit_emitters.size()
+                << " emitters and " << light_tree->refit_nodes.size() << " nodes.";
+      light_tree_refit_copy_to_device(dscene, *light_tree);
+      return;
+    }
+    VLOG_INFO << "Refitted light tree, with subtrees built again.";
   }
+  else {
+    /* TODO: For now, we'll start with a smaller number of max lights in a node.
+     * More benchmarking is needed to determine what number works best. */
+    light_tree = make_unique<LightTree>(scene, dscene, progress, 8);
+    light_tree->build(scene, dscene);
+    if (progress.get_cancel()) {
+      light_tree.reset();
+      return;
+    }
+  }
+
+  LightTreeNode *root = light_tree->get_root();
 
   /* Create arguments for recursive tree flatten. */
   LightTreeFlatten flatten;
   flatten.scene = scene;
-  flatten.emitters = light_tree.get_emitters();
+  flatten.emitters = light_tree->get_emitters();
   flatten.object_lookup_offset = dscene->object_lookup_offset.data();
   /* We want to create separate arrays corresponding to triangles and lights,
    * which will be used to index back into the light tree for PDF calculations. */
   flatten.light_array = dscene->light_to_tree.alloc(kintegrator->num_lights);
   flatten.mesh_array = dscene->object_to_tree.alloc(scene->objects.size());
-  flatten.triangle_array = dscene->triangle_to_tree.alloc(light_tree.num_triangles);
+  flatten.triangle_array = dscene->triangle_to_tree.alloc(light_tree->num_triangles);
 
   /* Allocate emitters */
-  const size_t num_emitters = light_tree.num_emitters();
+  const size_t num_emitters = light_tree->num_emitters();
   KernelLightTreeEmitter *kemitters = dscene->light_tree_emitters.alloc(num_emitters);
 
   /* Update integrator state. */
   kintegrator->use_direct_light = num_emitters > 0;
 
   /* Test if light linking is used. */
-  const bool use_light_linking = root && (light_tree.light_link_receiver_used != 1);
+  const bool use_light_linking = root && (light_tree->light_link_receiver_used != 1);
   KernelLightLinkSet *klight_link_sets = dscene->data.light_link_sets;
   memset(klight_link_sets, 0, sizeof(dscene->data.light_link_sets));
 
-  VLOG_INFO << "Use light tree with " << num_emitters << " emitters and " << light_tree.num_nodes
+  VLOG_INFO << "Use light tree with " << num_emitters << " emitters and " << light_tree->num_nodes
             << " nodes.";
 
   if (!use_light_linking) {
     /* Regular light tree without linking. */
-    KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(light_tree.num_nodes);
+    KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(light_tree->num_nodes);
 
     if (root) {
       int next_node_index = 0;
@@ -857,7 +942,7 @@ void LightManager::device_update_tree(Device * /*unused*/,
     if (root) {
       /* Reserve enough size of all instance subtrees, then shrink back to
        * actual number of nodes used. */
-      light_link_nodes.resize(light_tree.num_nodes);
+      light_link_nodes.resize(light_tree->num_nodes);
       light_tree_emitters_copy_and_flatten(
           flatten, root, light_link_nodes.data(), kemitters, next_node_index);
       light_link_nodes.resize(next_node_index);
@@ -866,7 +951,7 @@ void LightManager::device_update_tree(Device * /*unused*/,
     /* Specialized light trees for linking. */
     for (uint64_t tree_index = 0; tree_index < LIGHT_LINK_SET_MAX; tree_index++) {
       const uint64_t tree_mask = uint64_t(1) << tree_index;
-      if (!(light_tree.light_link_receiver_used & tree_mask)) {
+      if (!(light_tree->light_link_receiver_used & tree_mask)) {
         continue;
       }
 
@@ -883,7 +968,7 @@ void LightManager::device_update_tree(Device * /*unused*/,
     memcpy(knodes, light_link_nodes.data(), light_link_nodes.size() * sizeof(*knodes));
 
     VLOG_INFO << "Specialized light tree for light linking, with "
-              << light_link_nodes.size() - light_tree.num_nodes << " additional nodes.";
+              << light_link_nodes.size() - light_tree->num_nodes << " additional nodes.";
   }
 
   /* Copy arrays to device. */
@@ -1419,7 +1504,7 @@ void LightManager::device_update(Device *device,
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->light.times.add_entry({"device_update", time});
+      scene->update_stats->light.add_entry({"device_update", time});
     }
   });
 
@@ -1428,7 +1513,8 @@ void LightManager::device_update(Device *device,
   /* Detect which lights are enabled, also determines if we need to update the background. */
   test_enabled_lights(scene);
 
-  device_free(device, dscene, need_update_background);
+  /* The light tree arrays are kept, so they can be updated in place after refitting. */
+  device_free(device, dscene, need_update_background, false);
 
   device_update_lights(dscene, scene);
   if (progress.get_cancel()) {
@@ -1448,6 +1534,8 @@ void LightManager::device_update(Device *device,
   }
 
   device_update_tree(device, dscene, scene, progress);
+  modified_lights.clear();
+  modified_objects.clear();
   if (progress.get_cancel()) {
     return;
   }
@@ -1457,20 +1545,35 @@ void LightManager::device_update(Device *device,
     return;
   }
 
+  /* Only lights modified after this update are tagged again. */
+  for (Light *light : scene->lights) {
+    light->clear_modified();
+  }
+
   update_flags = UPDATE_NONE;
   need_update_background = false;
 }
 
-void LightManager::device_free(Device * /*unused*/,
-                               DeviceScene *dscene,
-                               const bool free_background)
+void LightManager::device_free_tree(DeviceScene *dscene)
 {
+  light_tree.reset();
+
   dscene->light_tree_nodes.free();
   dscene->light_tree_emitters.free();
   dscene->light_to_tree.free();
   dscene->object_to_tree.free();
   dscene->object_lookup_offset.free();
   dscene->triangle_to_tree.free();
+}
+
+void LightManager::device_free(Device * /*unused*/,
+                               DeviceScene *dscene,
+                               const bool free_background,
+                               const bool free_light_tree)
+{
+  if (free_light_tree) {
+    device_free_tree(dscene);
+  }
 
   dscene->light_distribution.free();
   dscene->lights.free();
@@ -1486,6 +1589,20 @@ void LightManager::tag_update(Scene * /*scene*/, uint32_t flag)
   update_flags |= flag;
 }
 
+void LightManager::tag_emitter_modified(Scene * /*scene*/, Light *light)
+{
+  const thread_scoped_lock lock(modified_emitters_mutex);
+  modified_lights.insert(light);
+  update_flags |= EMITTER_MODIFIED;
+}
+
+void LightManager::tag_emitter_modified(Scene * /*scene*/, Object *object)
+{
+  const thread_scoped_lock lock(modified_emitters_mutex);
+  modified_objects.insert(object);
+  update_flags |= EMITTER_MODIFIED;
+}
+
 bool LightManager::need_update() const
 {
   return update_flags != UPDATE_NONE;
@@ -13,6 +13,7 @@
 #include "scene/shader.h"
 
 #include "util/ies.h"
+#include "util/set.h"
 #include "util/thread.h"
 #include "util/types.h"
 #include "util/unique_ptr.h"
@@ -22,6 +23,8 @@ CCL_NAMESPACE_BEGIN
 
 class Device;
 class DeviceScene;
+class LightTree;
+class Object;
 class Progress;
 class Scene;
 class Shader;
@@ -107,6 +110,10 @@ class LightManager {
     OBJECT_MANAGER = (1 << 5),
     SHADER_COMPILED = (1 << 6),
     SHADER_MODIFIED = (1 << 7),
+    /* Objects changed, without adding or removing emitters of the light tree. */
+    OBJECT_MODIFIED = (1 << 8),
+    /* Lights or emissive object transforms changed, see #tag_emitter_modified. */
+    EMITTER_MODIFIED = (1 << 9),
 
     /* tag everything in the manager for an update */
     UPDATE_ALL = ~0u,
@@ -118,6 +125,7 @@ class LightManager {
   bool need_update_background;
 
   LightManager();
+  ~LightManager();
 
   /* IES texture management */
   int add_ies(const string &content);
@@ -125,10 +133,19 @@ class LightManager {
   void remove_ies(const int slot);
 
   void device_update(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
-  void device_free(Device *device, DeviceScene *dscene, const bool free_background = true);
+  void device_free(Device *device,
+                   DeviceScene *dscene,
+                   const bool free_background = true,
+                   const bool free_light_tree = true);
 
   void tag_update(Scene *scene, const uint32_t flag);
 
+  /* Tag a modified light, or an emissive object of which only the transform changed. When only
+   * such emitters changed, the light tree is refitted around them and updated in place on the
+   * device, instead of being built again. */
+  void tag_emitter_modified(Scene *scene, Light *light);
+  void tag_emitter_modified(Scene *scene, Object *object);
+
   bool need_update() const;
 
   /* Check whether there is a background light. */
@@ -147,6 +164,7 @@ class LightManager {
                                   Scene *scene,
                                   Progress &progress);
   void device_update_tree(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
+  void device_free_tree(DeviceScene *dscene);
   void device_update_background(Device *device,
                                 DeviceScene *dscene,
                                 Scene *scene,
@@ -165,6 +183,14 @@ class LightManager {
   bool last_background_enabled;
   int last_background_resolution;
 
+  /* Light tree of the previous update, refitted when only lights or transforms changed. */
+  unique_ptr<LightTree> light_tree;
+
+  /* Emitters tagged with #tag_emitter_modified since the last update. */
+  set<Light *> modified_lights;
+  set<Object *> modified_objects;
+  thread_mutex modified_emitters_mutex;
+
   uint32_t update_flags;
 };
 
@@ -240,6 +240,36 @@ LightTreeEmitter::LightTreeEmitter(Scene *scene,
   }
 }
 
+/* Measure of a node in its own space, from its children or emitters. */
+static LightTreeMeasure light_tree_local_measure(const LightTreeNode *node,
+                                                 const LightTreeEmitter *emitters)
+{
+  if (node->is_inner()) {
+    return node->get_inner().children[LightTree::left]->measure +
+           node->get_inner().children[LightTree::right]->measure;
+  }
+
+  LightTreeMeasure measure = LightTreeMeasure::empty;
+  const LightTreeNode::Leaf &leaf = node->get_leaf();
+  for (int i = 0; i < leaf.num_emitters; i++) {
+    measure.add(emitters[leaf.first_emitter_index + i].measure);
+  }
+  return measure;
+}
+
+static bool light_tree_measure_equal(const LightTreeMeasure &a, const LightTreeMeasure &b)
+{
+  return a.energy == b.energy && a.bbox.min == b.bbox.min && a.bbox.max == b.bbox.max &&
+         a.bcone.axis == b.bcone.axis && a.bcone.theta_o == b.bcone.theta_o &&
+         a.bcone.theta_e == b.bcone.theta_e;
+}
+
+/* Cost of the tree independent of emitter strength, to compare its quality after refitting. */
+static float light_tree_spatial_cost(LightTreeMeasure measure)
+{
+  return measure.is_zero() ? 0.0f : measure.calculate() / measure.energy;
+}
+
 static void sort_leaf(const int start, const int end, LightTreeEmitter *emitters)
 {
   /* Sort primitive by light link mask so that specialized trees can use a subset of these. */
@@ -304,8 +334,10 @@ LightTree::LightTree(Scene *scene,
 
     scene_light_index++;
   }
+  num_lights_ = device_light_index;
 
   /* Similarly, we also want to keep track of the index of triangles of emissive objects. */
+  num_objects_ = scene->objects.size();
   int object_id = 0;
   for (Object *object : scene->objects) {
     if (progress_.get_cancel()) {
@@ -446,9 +478,262 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
 
   std::move(distant_lights_.begin(), distant_lights_.end(), std::back_inserter(emitters_));
 
+  num_emissive_triangles_ = num_emissive_triangles;
+  num_local_emitters_ = num_local_lights;
+  emitter_leaf_.resize(emitters_.size(), nullptr);
+  link_refit_nodes(scene, root_.get());
+
   return root_.get();
 }
 
+void LightTree::link_refit_nodes(Scene *scene, LightTreeNode *node)
+{
+  node->build_cost = light_tree_spatial_cost(node->measure);
+
+  if (node->is_leaf() || node->is_distant()) {
+    const LightTreeNode::Leaf &leaf = node->get_leaf();
+    for (int i = 0; i < leaf.num_emitters; i++) {
+      const int emitter_index = leaf.first_emitter_index + i;
+      const LightTreeEmitter &emitter = emitters_[emitter_index];
+      emitter_leaf_[emitter_index] = node;
+      if (emitter.is_mesh()) {
+        emitter_index_[scene->objects[emitter.object_id]] = emitter_index;
+      }
+      else {
+        emitter_index_[scene->lights[emitter.object_id]] = emitter_index;
+      }
+    }
+    return;
+  }
+
+  for (int child = left; child <= right; child++) {
+    LightTreeNode *child_node = node->get_inner().children[child].get();
+    child_node->parent = node;
+    link_refit_nodes(scene, child_node);
+  }
+}
+
+/* Number of nodes in a subtree of the top level tree. Mesh subtrees belong to their emitters and
+ * are not counted. */
+static int light_tree_num_nodes(const LightTreeNode *node)
+{
+  if (!node->is_inner()) {
+    return 1;
+  }
+  return 1 + light_tree_num_nodes(node->get_inner().children[LightTree::left].get()) +
+         light_tree_num_nodes(node->get_inner().children[LightTree::right].get());
+}
+
+void LightTree::refit_emitter(const int emitter_index,
+                              const LightTreeMeasure &measure,
+                              const float3 centroid,
+                              vector<LightTreeNode *> &changed_leaves)
+{
+  LightTreeEmitter &emitter = emitters_[emitter_index];
+  if (light_tree_measure_equal(measure, emitter.measure) && centroid == emitter.centroid) {
+    return;
+  }
+
+  emitter.measure = measure;
+  emitter.centroid = centroid;
+  if (emitter.is_mesh()) {
+    emitter.root->measure = measure;
+  }
+  refit_emitters.push_back(emitter_index);
+  changed_leaves.push_back(emitter_leaf_[emitter_index]);
+}
+
+void LightTree::rebuild_subtree(Scene *scene, LightTreeNode *node, const int depth)
+{
+  LightTreeNode *parent = node->parent;
+  const Child child = (parent->get_inner().children[left].get() == node) ? left : right;
+  const uint bit_trail = node->bit_trail;
+
+  /* The emitters below a node are contiguous, from its leftmost to its rightmost leaf. */
+  const LightTreeNode *first_leaf = node;
+  while (first_leaf->is_inner()) {
+    first_leaf = first_leaf->get_inner().children[left].get();
+  }
+  const LightTreeNode *last_leaf = node;
+  while (last_leaf->is_inner()) {
+    last_leaf = last_leaf->get_inner().children[right].get();
+  }
+  const int start = first_leaf->get_leaf().first_emitter_index;
+  const int end = last_leaf->get_leaf().first_emitter_index + last_leaf->get_leaf().num_emitters;
+
+  /* Replaces the node and frees the old subtree. */
+  num_nodes -= light_tree_num_nodes(node);
+  recursive_build(child, parent, start, end, emitters_.data(), bit_trail, depth);
+  task_pool.wait_work();
+
+  if (progress_.get_cancel()) {
+    return;
+  }
+
+  LightTreeNode *new_node = parent->get_inner().children[child].get();
+  new_node->parent = parent;
+  link_refit_nodes(scene, new_node);
+}
+
+bool LightTree::refit(Scene *scene,
+                      DeviceScene *dscene,
+                      const set<Light *> &lights,
+                      const set<Object *> &objects)
+{
+  refit_emitters.clear();
+  refit_nodes.clear();
+  refit_topology_changed = false;
+
+  if (!root_ || light_link_receiver_used != 1) {
+    return false;
+  }
+
+  /* Device light and object indices must be the same, so no lights may have been enabled or
+   * disabled, and no objects added or removed. */
+  if (dscene->data.integrator.num_lights != num_lights_ || scene->objects.size() != num_objects_)
+  {
+    return false;
+  }
+
+  vector<LightTreeNode *> changed_leaves;
+
+  for (Light *light : lights) {
+    const auto it = emitter_index_.find(light);
+    const bool in_tree = (it != emitter_index_.end());
+    if (in_tree != light->is_enabled) {
+      return false;
+    }
+    if (!in_tree) {
+      continue;
+    }
+
+    const int emitter_index = it->second;
+    const LightTreeEmitter &emitter = emitters_[emitter_index];
+    const LightTreeEmitter updated(scene, emitter.light_id, emitter.object_id);
+    const LightType type = light->get_light_type();
+    const bool is_distant = (type == LIGHT_BACKGROUND || type == LIGHT_DISTANT);
+    if (is_distant != (emitter_index >= num_local_emitters_) ||
+        updated.light_set_membership != emitter.light_set_membership)
+    {
+      return false;
+    }
+    refit_emitter(emitter_index, updated.measure, updated.centroid, changed_leaves);
+  }
+
+  for (Object *object : objects) {
+    const auto it = emitter_index_.find(object);
+    const bool in_tree = (it != emitter_index_.end());
+    if (in_tree != object->usable_as_light()) {
+      return false;
+    }
+    if (!in_tree) {
+      continue;
+    }
+
+    const int emitter_index = it->second;
+    const LightTreeEmitter &emitter = emitters_[emitter_index];
+    Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+    if (offset_map_.find(mesh) == offset_map_.end() ||
+        object->get_light_set_membership() != emitter.light_set_membership)
+    {
+      return false;
+    }
+
+    /* Same as in build(), objects with non-uniform scale need all triangles to be recounted. */
+    LightTreeMeasure measure = light_tree_local_measure(emitter.root->get_reference(),
+                                                        emitters_.data());
+    if (!mesh->transform_applied && !measure.transform(object->get_tfm())) {
+      measure.reset();
+      const size_t mesh_num_triangles = mesh->num_triangles();
+      for (size_t i = 0; i < mesh_num_triangles; i++) {
+        if (triangle_usable_as_light(mesh, i)) {
+          measure.add(LightTreeEmitter(scene, i, emitter.object_id, true).measure);
+        }
+      }
+    }
+    refit_emitter(emitter_index, measure, object->bounds.center(), changed_leaves);
+  }
+
+  if (changed_leaves.empty()) {
+    return true;
+  }
+
+  /* Collect the nodes on the paths from the changed leaves to the root, each node once. */
+  std::unordered_map<LightTreeNode *, int> node_depth;
+  for (LightTreeNode *leaf : changed_leaves) {
+    int depth = 0;
+    for (const LightTreeNode *node = leaf->parent; node; node = node->parent) {
+      depth++;
+    }
+    for (LightTreeNode *node = leaf; node && node_depth.emplace(node, depth).second;
+         node = node->parent)
+    {
+      depth--;
+    }
+  }
+
+  /* Refit bottom up, children before their parents. */
+  vector<std::pair<int, LightTreeNode *>> path_nodes;
+  path_nodes.reserve(node_depth.size());
+  for (const auto &[node, depth] : node_depth) {
+    path_nodes.emplace_back(depth, node);
+  }
+  std::sort(path_nodes.begin(), path_nodes.end(), [](const auto &a, const auto &b) {
+    return a.first > b.first;
+  });
+  for (const auto &[depth, node] : path_nodes) {
+    node->measure = light_tree_local_measure(node, emitters_.data());
+  }
+
+  /* Emitters that moved far from where they were when building make the subtrees containing them
+   * a poor fit. Find the highest such subtrees on the paths, to build them again over their own
+   * emitters and keep the rest of the tree. */
+  vector<std::pair<int, LightTreeNode *>> rebuild_nodes;
+  unordered_set<const LightTreeNode *> rebuild_set;
+  for (auto it = path_nodes.rbegin(); it != path_nodes.rend(); ++it) {
+    const auto &[depth, node] = *it;
+    if (depth == 0 || node->is_distant() ||
+        light_tree_spatial_cost(node->measure) <= 2.0f * node->build_cost)
+    {
+      continue;
+    }
+    bool ancestor_rebuilt = false;
+    for (const LightTreeNode *parent = node->parent; parent; parent = parent->parent) {
+      if (rebuild_set.count(parent)) {
+        ancestor_rebuilt = true;
+        break;
+      }
+    }
+    if (!ancestor_rebuilt) {
+      rebuild_nodes.emplace_back(depth, node);
+      rebuild_set.insert(node);
+    }
+  }
+
+  if (rebuild_nodes.empty()) {
+    for (const auto &[depth, node] : path_nodes) {
+      refit_nodes.push_back(node);
+    }
+    return true;
+  }
+
+  for (const auto &[depth, node] : rebuild_nodes) {
+    LightTreeNode *parent = node->parent;
+    rebuild_subtree(scene, node, depth);
+    if (progress_.get_cancel()) {
+      return false;
+    }
+
+    /* Merging orientation bounds depends on the order, so refit the parents again. */
+    for (LightTreeNode *ancestor = parent; ancestor; ancestor = ancestor->parent) {
+      ancestor->measure = light_tree_local_measure(ancestor, emitters_.data());
+    }
+  }
+
+  refit_topology_changed = true;
+  return true;
+}
+
 void LightTree::recursive_build(const Child child,
                                 LightTreeNode *inner,
                                 const int start,
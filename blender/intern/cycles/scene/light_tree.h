@@ -8,6 +8,7 @@
 #include "scene/scene.h"
 
 #include "util/boundbox.h"
+#include "util/set.h"
 #include "util/task.h"
 #include "util/types.h"
 #include "util/vector.h"
@@ -246,6 +247,14 @@ struct LightTreeNode {
   uint bit_trail;
   int object_id;
 
+  /* Parent in the top level tree, used for refitting. Null for the root and mesh subtrees. */
+  LightTreeNode *parent = nullptr;
+  /* Spatial cost of a top level node right after it was built, to detect when refitting made it a
+   * poor fit. */
+  float build_cost = 0.0f;
+  /* Index of the node in the flattened device array. */
+  int device_index = -1;
+
   /* A bitmask of `LightTreeNodeType`, as in the building process an instance node can also be a
    * leaf or an inner node. */
   int type;
@@ -392,6 +401,18 @@ class LightTree {
 
   uint max_lights_in_leaf_;
 
+  /* State of the scene the tree was built for, to detect changes that need a full rebuild. */
+  int num_lights_ = 0;
+  size_t num_objects_ = 0;
+
+  /* Emitter index ranges of the top level tree, after emissive triangles of mesh subtrees. */
+  int num_emissive_triangles_ = 0;
+  int num_local_emitters_ = 0;
+
+  /* Top level leaf of each emitter, and the emitter index of each light and emissive object. */
+  vector<LightTreeNode *> emitter_leaf_;
+  std::unordered_map<const Node *, int> emitter_index_;
+
  public:
   std::atomic<int> num_nodes = 0;
   size_t num_triangles = 0;
@@ -399,6 +420,13 @@ class LightTree {
   /* Bitmask of receiver light sets used. Default set is always used. */
   uint64_t light_link_receiver_used = 1;
 
+  /* Top level emitters and nodes changed by the last #refit, to update only those on the device.
+   * When subtrees were built again, the node layout changed and the tree must be flattened again
+   * instead. */
+  vector<int> refit_emitters;
+  vector<LightTreeNode *> refit_nodes;
+  bool refit_topology_changed = false;
+
   /* An inner node itself or its left and right child. */
   enum Child {
     self = -1,
@@ -411,6 +439,20 @@ class LightTree {
   /* Returns a pointer to the root node. */
   LightTreeNode *build(Scene *scene, DeviceScene *dscene);
 
+  /* Update the given lights and emissive objects, and refit the nodes on the paths from their
+   * leaves to the root. Subtrees that became a poor fit are built again over their own emitters.
+   * Only light settings and object transforms can change this way, returns false if the tree
+   * must be rebuilt instead. */
+  bool refit(Scene *scene,
+             DeviceScene *dscene,
+             const set<Light *> &lights,
+             const set<Object *> &objects);
+
+  LightTreeNode *get_root() const
+  {
+    return root_.get();
+  }
+
   /* NOTE: Always use this function to create a new node so the number of nodes is in sync. */
   unique_ptr<LightTreeNode> create_node(const LightTreeMeasure &measure, const uint &bit_trial)
   {
@@ -455,6 +497,18 @@ class LightTree {
 
   /* Add all the emissive triangles of a mesh to the light tree. */
   void add_mesh(Scene *scene, Mesh *mesh, const int object_id);
+
+  /* Record parents, leaves and build costs of the top level tree, needed for refitting. */
+  void link_refit_nodes(Scene *scene, LightTreeNode *node);
+
+  /* Set a new measure for a top level emitter, and record its leaf when it changed. */
+  void refit_emitter(const int emitter_index,
+                     const LightTreeMeasure &measure,
+                     const float3 centroid,
+                     vector<LightTreeNode *> &changed_leaves);
+
+  /* Build the subtree of a top level node again, over the same range of emitters. */
+  void rebuild_subtree(Scene *scene, LightTreeNode *node, const int depth);
 };
 
 CCL_NAMESPACE_END
@@ -750,6 +750,32 @@ void Mesh::pack_normals(packed_float3 *vnormal)
   }
 }
 
+void Mesh::pack_normals_compact(uint *vnormal)
+{
+  Attribute *attr_vN = attributes.find(ATTR_STD_VERTEX_NORMAL);
+  if (attr_vN == nullptr) {
+    /* Happens on objects with just hair. */
+    return;
+  }
+
+  const bool do_transform = transform_applied;
+  const Transform ntfm = transform_normal;
+
+  float3 *vN = attr_vN->data_float3();
+  const size_t verts_size = verts.size();
+
+  if (do_transform) {
+    for (size_t i = 0; i < verts_size; i++) {
+      vnormal[i] = encode_normal_octahedral(transform_direction(&ntfm, vN[i]));
+    }
+  }
+  else {
+    for (size_t i = 0; i < verts_size; i++) {
+      vnormal[i] = encode_normal_octahedral(vN[i]);
+    }
+  }
+}
+
 void Mesh::pack_verts(packed_float3 *tri_verts,
                       packed_uint3 *tri_vindex,
                       uint *tri_patch,
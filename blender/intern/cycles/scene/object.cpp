@@ -51,6 +51,7 @@ struct UpdateObjectTransformState {
   uint *object_flag;
   uint *object_visibility;
   KernelObject *objects;
+  KernelObjectLightLinking *object_light_linking;
   Transform *object_motion_pass;
   DecomposedTransform *object_motion;
   float *object_volume_step;
@@ -235,9 +236,26 @@ void Object::tag_update(Scene *scene)
       flag |= ObjectManager::VISIBILITY_MODIFIED;
     }
 
+    bool has_emission = false;
     for (Node *node : geometry->get_used_shaders()) {
       Shader *shader = static_cast<Shader *>(node);
       if (shader->emission_sampling != EMISSION_SAMPLING_NONE) {
+        has_emission = true;
+      }
+    }
+
+    const SocketModifiedFlags transform_flags = get_tfm_socket()->modified_flag_bit |
+                                                get_motion_socket()->modified_flag_bit;
+    if (geometry_is_modified() || receiver_light_set_is_modified()) {
+      /* Emitters may be added or removed, and light linking changed. */
+      scene->light_manager->tag_update(scene, LightManager::OBJECT_MANAGER);
+    }
+    else if (has_emission) {
+      if (is_modified() && !(socket_modified & ~transform_flags)) {
+        /* Only the transform changed, which refits the light tree. */
+        scene->light_manager->tag_emitter_modified(scene, this);
+      }
+      else {
         scene->light_manager->tag_update(scene, LightManager::EMISSIVE_MESH_MODIFIED);
       }
     }
@@ -495,14 +513,18 @@ void ObjectManager::device_update_object_transform(UpdateObjectTransformState *s
   kobject.particle_index = particle_index;
   kobject.motion_offset = 0;
   kobject.ao_distance = ob->ao_distance;
-  kobject.receiver_light_set = ob->receiver_light_set >= LIGHT_LINK_SET_MAX ?
-                                   0 :
-                                   ob->receiver_light_set;
-  kobject.light_set_membership = ob->light_set_membership;
-  kobject.blocker_shadow_set = ob->blocker_shadow_set >= LIGHT_LINK_SET_MAX ?
-                                   0 :
-                                   ob->blocker_shadow_set;
-  kobject.shadow_set_membership = ob->shadow_set_membership;
+
+  if (state->object_light_linking) {
+    KernelObjectLightLinking &klinking = state->object_light_linking[ob->index];
+    klinking.receiver_light_set = ob->receiver_light_set >= LIGHT_LINK_SET_MAX ?
+                                      0 :
+                                      ob->receiver_light_set;
+    klinking.light_set_membership = ob->light_set_membership;
+    klinking.blocker_shadow_set = ob->blocker_shadow_set >= LIGHT_LINK_SET_MAX ?
+                                      0 :
+                                      ob->blocker_shadow_set;
+    klinking.shadow_set_membership = ob->shadow_set_membership;
+  }
 
   if (geom->get_use_motion_blur()) {
     state->have_motion = true;
@@ -639,6 +661,12 @@ void ObjectManager::device_update_object_transform(UpdateObjectTransformState *s
 
 void ObjectManager::device_update_prim_offsets(Device *device, DeviceScene *dscene, Scene *scene)
 {
+  const scoped_callback_timer timer([scene](double time) {
+    if (scene->update_stats) {
+      scene->update_stats->object.add_entry({"device_update_prim_offsets", time});
+    }
+  });
+
   if (!scene->integrator->get_use_light_tree()) {
     const BVHLayoutMask layout_mask = device->get_bvh_layout_mask(dscene->data.kernel_features);
     if (layout_mask != BVH_LAYOUT_METAL && layout_mask != BVH_LAYOUT_MULTI_METAL &&
@@ -684,7 +712,18 @@ void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene,
   state.objects = dscene->objects.alloc(scene->objects.size());
   state.object_flag = dscene->object_flag.alloc(scene->objects.size());
   state.object_volume_step = dscene->object_volume_step.alloc(scene->objects.size());
+  state.object_light_linking = nullptr;
   state.object_motion = nullptr;
+
+  /* Light linking sets are only needed by the kernel when the scene uses linking. */
+  if (dscene->data.kernel_features &
+      (KERNEL_FEATURE_LIGHT_LINKING | KERNEL_FEATURE_SHADOW_LINKING))
+  {
+    state.object_light_linking = dscene->object_light_linking.alloc(scene->objects.size());
+  }
+  else {
+    dscene->object_light_linking.free();
+  }
   state.object_motion_pass = nullptr;
 
   if (state.need_motion == Scene::MOTION_PASS) {
@@ -736,6 +775,9 @@ void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene,
   }
 
   dscene->objects.copy_to_device_if_modified();
+  if (state.object_light_linking) {
+    dscene->object_light_linking.copy_to_device();
+  }
   if (state.need_motion == Scene::MOTION_PASS) {
     dscene->object_motion_pass.copy_to_device();
   }
@@ -749,6 +791,7 @@ void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene,
   dscene->data.bvh.have_volumes = state.have_volumes;
 
   dscene->objects.clear_modified();
+  dscene->object_light_linking.clear_modified();
   dscene->object_motion_pass.clear_modified();
   dscene->object_motion.clear_modified();
 }
@@ -764,6 +807,7 @@ void ObjectManager::device_update(Device *device,
 
   if (update_flags & (OBJECT_ADDED | OBJECT_REMOVED)) {
     dscene->objects.tag_realloc();
+    dscene->object_light_linking.tag_realloc();
     dscene->object_motion_pass.tag_realloc();
     dscene->object_motion.tag_realloc();
     dscene->object_flag.tag_realloc();
@@ -790,7 +834,7 @@ void ObjectManager::device_update(Device *device,
     /* Assign object IDs. */
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->object.times.add_entry({"device_update (assign index)", time});
+        scene->update_stats->object.add_entry({"device_update (assign index)", time});
       }
     });
 
@@ -814,8 +858,7 @@ void ObjectManager::device_update(Device *device,
     /* set object transform matrices, before applying static transforms */
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->object.times.add_entry(
-            {"device_update (copy objects to device)", time});
+        scene->update_stats->object.add_entry({"device_update (copy objects to device)", time});
       }
     });
 
@@ -832,8 +875,7 @@ void ObjectManager::device_update(Device *device,
   if (scene->params.bvh_type == BVH_TYPE_STATIC) {
     const scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
-        scene->update_stats->object.times.add_entry(
-            {"device_update (apply static transforms)", time});
+        scene->update_stats->object.add_entry({"device_update (apply static transforms)", time});
       }
     });
 
@@ -858,7 +900,7 @@ void ObjectManager::device_update_flags(Device * /*unused*/,
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->object.times.add_entry({"device_update_flags", time});
+      scene->update_stats->object.add_entry({"device_update_flags", time});
     }
   });
 
@@ -1004,6 +1046,7 @@ void ObjectManager::device_update_geom_offsets(Device * /*unused*/,
 void ObjectManager::device_free(Device * /*unused*/, DeviceScene *dscene, bool force_free)
 {
   dscene->objects.free_if_need_realloc(force_free);
+  dscene->object_light_linking.free_if_need_realloc(force_free);
   dscene->object_motion_pass.free_if_need_realloc(force_free);
   dscene->object_motion.free_if_need_realloc(force_free);
   dscene->object_flag.free_if_need_realloc(force_free);
@@ -1106,7 +1149,12 @@ void ObjectManager::tag_update(Scene *scene, const uint32_t flag)
     scene->geometry_manager->tag_update(scene, geometry_flag);
   }
 
-  scene->light_manager->tag_update(scene, LightManager::OBJECT_MANAGER);
+  /* Only added or removed objects change the emitters of the light tree, other changes to
+   * emissive objects are tagged by #Object::tag_update. */
+  scene->light_manager->tag_update(scene,
+                                   (flag & (OBJECT_ADDED | OBJECT_REMOVED)) ?
+                                       LightManager::OBJECT_MANAGER :
+                                       LightManager::OBJECT_MODIFIED);
 
   /* Integrator's shadow catcher settings depends on object visibility settings. */
   if (flag & (OBJECT_ADDED | OBJECT_REMOVED | OBJECT_MODIFIED)) {
@@ -1153,4 +1201,60 @@ string ObjectManager::get_cryptomatte_assets(Scene *scene)
   return manifest;
 }
 
+void ObjectManager::collect_statistics(const Scene *scene, RenderStats *stats)
+{
+  /* Object attribute maps are allocated one after the other at the end of the attribute map
+   * array, so the size of a map is the distance to the next one. Instances sharing a map have the
+   * same offset, and the map is only counted once. */
+  vector<size_t> attr_map_offsets;
+  for (const Object *object : scene->objects) {
+    if (object->attr_map_offset != 0) {
+      attr_map_offsets.push_back(object->attr_map_offset);
+    }
+  }
+  std::sort(attr_map_offsets.begin(), attr_map_offsets.end());
+  attr_map_offsets.erase(std::unique(attr_map_offsets.begin(), attr_map_offsets.end()),
+                         attr_map_offsets.end());
+  const size_t attr_map_end = scene->dscene.attributes_map.size();
+
+  struct PrototypeStats {
+    size_t num_instances = 0;
+    size_t size = 0;
+  };
+  unordered_map<const Geometry *, PrototypeStats> prototypes;
+  set<size_t> counted_attr_maps;
+
+  for (const Object *object : scene->objects) {
+    PrototypeStats &prototype = prototypes[object->get_geometry()];
+    prototype.num_instances++;
+
+    /* Host side object and attribute values. */
+    prototype.size += sizeof(Object);
+    for (const ParamValue &param : object->attributes) {
+      prototype.size += param.datasize();
+    }
+
+    /* Device side object data, flag, volume step and primitive offset, excluding motion. */
+    prototype.size += sizeof(KernelObject) + sizeof(uint) + sizeof(float) + sizeof(uint);
+
+    if (object->attr_map_offset != 0 && counted_attr_maps.insert(object->attr_map_offset).second)
+    {
+      const auto next = std::upper_bound(
+          attr_map_offsets.begin(), attr_map_offsets.end(), object->attr_map_offset);
+      const size_t attr_map_next = (next != attr_map_offsets.end()) ? *next : attr_map_end;
+      if (attr_map_next > object->attr_map_offset) {
+        prototype.size += (attr_map_next - object->attr_map_offset) * sizeof(AttributeMap);
+      }
+    }
+  }
+
+  for (const auto &it : prototypes) {
+    const Geometry *geom = it.first;
+    const PrototypeStats &prototype = it.second;
+    stats->mesh.instances.add_entry(NamedSizeEntry(
+        string_printf("%s (%zu instances)", geom->name.c_str(), prototype.num_instances),
+        prototype.size));
+  }
+}
+
 CCL_NAMESPACE_END
@@ -27,6 +27,7 @@ class DeviceScene;
 class Geometry;
 class ParticleSystem;
 class Progress;
+class RenderStats;
 class Scene;
 struct Transform;
 struct UpdateObjectTransformState;
@@ -182,6 +183,9 @@ class ObjectManager {
   string get_cryptomatte_objects(Scene *scene);
   string get_cryptomatte_assets(Scene *scene);
 
+  /* Statistics */
+  void collect_statistics(const Scene *scene, RenderStats *stats);
+
  protected:
   void device_update_object_transform(UpdateObjectTransformState *state,
                                       Object *ob,
@@ -105,7 +105,7 @@ void OSLShaderManager::device_update_specific(Device *device,
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->osl.times.add_entry({"device_update", time});
+      scene->update_stats->osl.add_entry({"device_update", time});
     }
   });
 
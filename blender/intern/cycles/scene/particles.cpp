@@ -95,7 +95,7 @@ void ParticleSystemManager::device_update(Device *device,
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->particles.times.add_entry({"device_update", time});
+      scene->update_stats->particles.add_entry({"device_update", time});
     }
   });
 
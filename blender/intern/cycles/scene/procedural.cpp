@@ -37,7 +37,7 @@ void ProceduralManager::update(Scene *scene, Progress &progress)
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->procedurals.times.add_entry({"update", time});
+      scene->update_stats->procedurals.add_entry({"update", time});
     }
   });
 
@@ -177,11 +177,13 @@ void Scene::device_update(Device *device_, Progress &progress)
 
   const scoped_callback_timer timer([this, print_stats](double time) {
     if (update_stats) {
-      update_stats->scene.times.add_entry({"device_update", time});
+      update_stats->scene.add_entry({"device_update", time});
 
       if (print_stats) {
         printf("Update statistics:\n%s\n", update_stats->full_report().c_str());
       }
+
+      update_stats->timeline.flush();
     }
   });
 
@@ -446,6 +448,7 @@ void Scene::device_free()
 void Scene::collect_statistics(RenderStats *stats)
 {
   geometry_manager->collect_statistics(this, stats);
+  object_manager->collect_statistics(this, stats);
   image_manager->collect_statistics(stats);
 }
 
@@ -456,6 +459,14 @@ void Scene::enable_update_stats()
   }
 }
 
+void Scene::enable_update_timeline(const string &filepath)
+{
+  enable_update_stats();
+  if (!update_stats->timeline.open(filepath)) {
+    LOG(ERROR) << "Failed to open scene update timeline file " << filepath;
+  }
+}
+
 void Scene::update_kernel_features()
 {
   if (!need_update()) {
@@ -470,9 +481,6 @@ void Scene::update_kernel_features()
 
   const bool use_motion = need_motion() == Scene::MotionType::MOTION_BLUR;
   kernel_features |= KERNEL_FEATURE_PATH_TRACING;
-  if (params.hair_shape == CURVE_THICK) {
-    kernel_features |= KERNEL_FEATURE_HAIR_THICK;
-  }
 
   /* Figure out whether the scene will use shader ray-trace we need at least
    * one caustic light, one caustic caster and one caustic receiver to use
@@ -507,6 +515,11 @@ void Scene::update_kernel_features()
     }
     else if (geom->is_hair()) {
       kernel_features |= KERNEL_FEATURE_HAIR;
+      /* Only request thick curves when there are curves, so that scenes without hair can still
+       * use the specialized kernels. */
+      if (params.hair_shape == CURVE_THICK) {
+        kernel_features |= KERNEL_FEATURE_HAIR_THICK;
+      }
     }
     else if (geom->is_pointcloud()) {
       kernel_features |= KERNEL_FEATURE_POINTCLOUD;
@@ -550,6 +563,13 @@ void Scene::update_kernel_features()
   kernel_features |= film->get_kernel_features(this);
   kernel_features |= integrator->get_kernel_features();
 
+  /* The per-object light linking array is only allocated when linking is used, so it needs to be
+   * filled in or freed when that changes. */
+  const uint linking_features = KERNEL_FEATURE_LIGHT_LINKING | KERNEL_FEATURE_SHADOW_LINKING;
+  if ((kernel_features ^ dscene.data.kernel_features) & linking_features) {
+    object_manager->tag_update(this, ObjectManager::OBJECT_MODIFIED);
+  }
+
   dscene.data.kernel_features = kernel_features;
 
   /* Currently viewport render is faster with higher max_closures, needs
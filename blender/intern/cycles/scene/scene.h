@@ -72,6 +72,9 @@ class SceneParams {
   CurveShapeType hair_shape;
   int texture_limit;
 
+  /* Store geometry in reduced precision to save memory. */
+  bool use_compact_geometry;
+
   bool background;
 
   SceneParams()
@@ -86,6 +89,7 @@ class SceneParams {
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    use_compact_geometry = false;
     background = true;
   }
 
@@ -98,7 +102,8 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             use_compact_geometry == params.use_compact_geometry);
   }
 
   int curve_subdivisions()
@@ -193,6 +198,10 @@ class Scene : public NodeOwner {
 
   void enable_update_stats();
 
+  /* Enable update statistics and append new update timeline events to the given file after
+   * every device update. */
+  void enable_update_timeline(const string &filepath);
+
   bool load_kernels(Progress &progress);
   bool update(Progress &progress);
 
@@ -2,11 +2,15 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include <atomic>
+
 #include "scene/stats.h"
 #include "scene/object.h"
 #include "util/algorithm.h"
 
+#include "util/path.h"
 #include "util/string.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -210,6 +214,7 @@ string MeshStats::full_report(const int indent_level)
   const string indent(indent_level * kIndentNumSpaces, ' ');
   string result;
   result += indent + "Geometry:\n" + geometry.full_report(indent_level + 1);
+  result += indent + "Instances:\n" + instances.full_report(indent_level + 1);
   return result;
 }
 
@@ -305,12 +310,163 @@ string RenderStats::full_report()
 
 NamedTimeStats::NamedTimeStats() : total_time(0.0) {}
 
+/* Scene update timeline. */
+
+namespace {
+
+/* Small sequential index of the calling thread, used as thread identifier in the trace. */
+int timeline_thread_index()
+{
+  static std::atomic<int> num_threads = 0;
+  thread_local const int index = num_threads++;
+  return index;
+}
+
+}  // namespace
+
+SceneUpdateTimeline::SceneUpdateTimeline() : time_start_(time_dt()) {}
+
+SceneUpdateTimeline::~SceneUpdateTimeline()
+{
+  close();
+}
+
+bool SceneUpdateTimeline::open(const string &filepath)
+{
+  close();
+
+  const thread_scoped_lock lock(mutex_);
+  file_ = path_fopen(filepath, "wb");
+  if (file_ == nullptr) {
+    return false;
+  }
+
+  /* Use the JSON array format of the trace, in which the closing bracket is optional. Events can
+   * then be appended as they come in, and a trace of a session which did not end properly can
+   * still be opened. */
+  fputs("[\n", file_);
+  events_.clear();
+  num_events_written_ = 0;
+  num_threads_ = 0;
+  time_start_ = time_dt();
+  return true;
+}
+
+void SceneUpdateTimeline::close()
+{
+  const thread_scoped_lock lock(mutex_);
+  if (file_ == nullptr) {
+    return;
+  }
+
+  flush_locked();
+
+  /* Name the process and threads, the trace ends with a metadata event so that there is no
+   * trailing comma. */
+  for (int thread = 0; thread < num_threads_; thread++) {
+    fprintf(file_,
+            "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": %d, "
+            "\"args\": {\"name\": \"Thread %d\"}},\n",
+            thread,
+            thread);
+  }
+  fputs(
+      "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, "
+      "\"args\": {\"name\": \"Cycles Scene Update\"}}\n"
+      "]\n",
+      file_);
+
+  fclose(file_);
+  file_ = nullptr;
+}
+
+bool SceneUpdateTimeline::is_open() const
+{
+  const thread_scoped_lock lock(mutex_);
+  return file_ != nullptr;
+}
+
+void SceneUpdateTimeline::add_event(const string &category,
+                                    const string &name,
+                                    const double duration)
+{
+  const double time_end = time_dt();
+  const int thread = timeline_thread_index();
+
+  const thread_scoped_lock lock(mutex_);
+  if (file_ != nullptr && num_events_written_ + events_.size() < MAX_EVENTS) {
+    events_.push_back({category, name, time_end - duration - time_start_, duration, thread});
+  }
+}
+
+void SceneUpdateTimeline::flush()
+{
+  const thread_scoped_lock lock(mutex_);
+  flush_locked();
+}
+
+void SceneUpdateTimeline::flush_locked()
+{
+  if (file_ == nullptr || events_.empty()) {
+    return;
+  }
+
+  /* Complete events, with timestamps in microseconds. */
+  string json;
+  for (const Event &event : events_) {
+    json += string_printf(
+        "{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, "
+        "\"ts\": %.3f, \"dur\": %.3f},\n",
+        string_json_escape(event.name).c_str(),
+        string_json_escape(event.category).c_str(),
+        event.thread,
+        event.start * 1e6,
+        event.duration * 1e6);
+    num_threads_ = max(num_threads_, event.thread + 1);
+  }
+  fwrite(json.data(), 1, json.size(), file_);
+  fflush(file_);
+
+  num_events_written_ += events_.size();
+  events_.clear();
+}
+
+/* Scene update statistics. */
+
+UpdateTimeStats::UpdateTimeStats(const char *category, SceneUpdateTimeline *timeline)
+    : category_(category), timeline_(timeline)
+{
+}
+
+void UpdateTimeStats::add_entry(const NamedTimeEntry &entry)
+{
+  times.add_entry(entry);
+  timeline_->add_event(category_, entry.name, entry.time);
+}
+
 string UpdateTimeStats::full_report(const int indent_level)
 {
   return times.full_report(indent_level + 1);
 }
 
-SceneUpdateStats::SceneUpdateStats() = default;
+SceneUpdateStats::SceneUpdateStats()
+    : geometry("Geometry", &timeline),
+      image("Image", &timeline),
+      light("Light", &timeline),
+      object("Object", &timeline),
+      background("Background", &timeline),
+      bake("Bake", &timeline),
+      camera("Camera", &timeline),
+      film("Film", &timeline),
+      integrator("Integrator", &timeline),
+      osl("OSL", &timeline),
+      particles("Particles", &timeline),
+      scene("Scene", &timeline),
+      svm("SVM", &timeline),
+      tables("Tables", &timeline),
+      procedurals("Procedurals", &timeline)
+{
+}
 
 string SceneUpdateStats::full_report()
 {
@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <cstdio>
+
 #include "scene/scene.h"
 
 #include "util/string.h"
+#include "util/thread.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
@@ -146,6 +149,10 @@ class MeshStats {
    * memory like BVH.
    */
   NamedSizeStats geometry;
+
+  /* Memory used by objects, per instanced geometry. This is the per instance overhead, which
+   * dominates in scenes with many instances of few prototypes. */
+  NamedSizeStats instances;
 };
 
 /* Statistics about images held in memory. */
@@ -179,18 +186,81 @@ class RenderStats {
   NamedSampleCountStats objects;
 };
 
+/* Timeline of scene update events, with the start time and thread of every event, which is
+ * written to a file in the Chrome trace event format and can be opened in chrome://tracing or
+ * Perfetto.
+ *
+ * Unlike the time statistics it is not cleared on every scene update, so the events of Blender
+ * sync and of successive interactive updates show up on the same timeline. Events may be added
+ * from any thread. They are buffered until the next flush, which appends them to the file, so the
+ * cost of writing does not grow with the length of the session. */
+class SceneUpdateTimeline {
+ public:
+  SceneUpdateTimeline();
+  ~SceneUpdateTimeline();
+
+  /* Start writing the timeline to the given file, returns false if it can not be opened. */
+  bool open(const string &filepath);
+
+  /* Finish the trace and close the file. Called on destruction. */
+  void close();
+
+  bool is_open() const;
+
+  /* Add event which ended just now, after running for the given duration in seconds. */
+  void add_event(const string &category, const string &name, const double duration);
+
+  /* Append the events added since the previous flush to the file. */
+  void flush();
+
+ protected:
+  struct Event {
+    string category;
+    string name;
+    double start;
+    double duration;
+    int thread;
+  };
+
+  void flush_locked();
+
+  /* Events beyond this number are dropped, to bound the file size of long interactive
+   * sessions. */
+  static const size_t MAX_EVENTS = 1 << 20;
+
+  mutable thread_mutex mutex_;
+  vector<Event> events_;
+  size_t num_events_written_ = 0;
+  int num_threads_ = 0;
+  FILE *file_ = nullptr;
+  double time_start_;
+};
+
 class UpdateTimeStats {
  public:
+  UpdateTimeStats(const char *category, SceneUpdateTimeline *timeline);
+
+  /* Add entry to the time statistics and the timeline. */
+  void add_entry(const NamedTimeEntry &entry);
+
   /* Generate full human-readable report. */
   string full_report(const int indent_level = 0);
 
   NamedTimeStats times;
+
+ protected:
+  const char *category_;
+  SceneUpdateTimeline *timeline_;
 };
 
 class SceneUpdateStats {
  public:
   SceneUpdateStats();
 
+  /* Declared first, as the time statistics below refer to it. When open, new events are
+   * appended to the file after every scene device update. */
+  SceneUpdateTimeline timeline;
+
   UpdateTimeStats geometry;
   UpdateTimeStats image;
   UpdateTimeStats light;
@@ -209,6 +279,7 @@ class SceneUpdateStats {
 
   string full_report();
 
+  /* Clear the time statistics for the next update, the timeline is kept. */
   void clear();
 };
 
@@ -17,6 +17,7 @@
 #include "scene/svm.h"
 
 #include "util/log.h"
+#include "util/md5.h"
 #include "util/progress.h"
 #include "util/task.h"
 
@@ -30,6 +31,66 @@ SVMShaderManager::~SVMShaderManager() = default;
 
 void SVMShaderManager::reset(Scene * /*scene*/) {}
 
+/* Hash everything the SVM compiler reads from a finalized shader graph: node sockets, links
+ * and image slots, along with the shader settings that affect compilation. Returns false if the
+ * compiled nodes depend on state outside of the graph, in which case the shader is not cached.
+ * This is the case for images that are only added to the image manager during compilation. */
+static bool svm_shader_hash(Shader *shader,
+                            const bool has_bump,
+                            const bool background,
+                            string &r_key)
+{
+  MD5Hash md5;
+
+  const int settings[4] = {int(shader->get_displacement_method()),
+                           int(has_bump),
+                           int(background),
+                           int(shader->reference_count() != 0)};
+  md5.append((const uint8_t *)settings, sizeof(settings));
+
+  for (ShaderNode *node : shader->graph->nodes) {
+    const ImageHandle *handle = nullptr;
+    if (node->special_type == SHADER_SPECIAL_TYPE_IMAGE_SLOT) {
+      handle = &static_cast<ImageSlotTextureNode *>(node)->handle;
+    }
+    else if (node->type == SkyTextureNode::get_node_type()) {
+      handle = &static_cast<SkyTextureNode *>(node)->handle;
+    }
+    else if (node->type == PointDensityTextureNode::get_node_type()) {
+      handle = &static_cast<PointDensityTextureNode *>(node)->handle;
+    }
+    else if (node->special_type == SHADER_SPECIAL_TYPE_OUTPUT_AOV ||
+             node->type == IESLightNode::get_node_type())
+    {
+      /* AOV offsets come from the film, IES slots from the light manager. */
+      return false;
+    }
+
+    if (handle) {
+      if (handle->empty()) {
+        return false;
+      }
+      for (int i = 0; i < handle->num_tiles(); i++) {
+        const int slot = handle->svm_slot(i);
+        md5.append((const uint8_t *)&slot, sizeof(slot));
+      }
+    }
+
+    md5.append((const uint8_t *)&node->id, sizeof(node->id));
+    node->hash(md5);
+
+    for (ShaderInput *input : node->inputs) {
+      if (input->link) {
+        md5.append((const uint8_t *)&input->link->parent->id, sizeof(input->link->parent->id));
+        md5.append(input->link->name().string());
+      }
+    }
+  }
+
+  r_key = md5.get_hex();
+  return true;
+}
+
 void SVMShaderManager::device_update_shader(Scene *scene,
                                             Shader *shader,
                                             Progress &progress,
@@ -43,7 +104,72 @@ void SVMShaderManager::device_update_shader(Scene *scene,
   SVMCompiler::Summary summary;
   SVMCompiler compiler(scene);
   compiler.background = (shader == scene->background->get_shader(scene));
-  compiler.compile(shader, *svm_nodes, 0, &summary);
+
+  /* The graph is finalized first, so that constant folding and other simplifications are done
+   * before hashing and graphs that only differ in folded constants share the compiled nodes. */
+  const bool has_bump = compiler.finalize(shader, &summary);
+
+  string key;
+  const bool use_cache = svm_shader_hash(shader, has_bump, compiler.background, key);
+  bool cache_hit = false;
+
+  if (use_cache) {
+    const thread_scoped_lock lock(compile_cache_mutex);
+    const auto it = compile_cache.find(key);
+    if (it != compile_cache.end()) {
+      CompiledShader &compiled = it->second;
+      compiled.used = true;
+
+      *svm_nodes = compiled.svm_nodes;
+
+      shader->has_surface = compiled.has_surface;
+      shader->has_surface_transparent = compiled.has_surface_transparent;
+      shader->has_surface_raytrace = compiled.has_surface_raytrace;
+      shader->has_surface_bssrdf = compiled.has_surface_bssrdf;
+      shader->has_bump = compiled.has_bump;
+      shader->has_bssrdf_bump = compiled.has_bssrdf_bump;
+      shader->has_volume = compiled.has_volume;
+      shader->has_displacement = compiled.has_displacement;
+      shader->has_surface_spatial_varying = compiled.has_surface_spatial_varying;
+      shader->has_volume_spatial_varying = compiled.has_volume_spatial_varying;
+      shader->has_volume_attribute_dependency = compiled.has_volume_attribute_dependency;
+
+      compile_cache_hits++;
+      cache_hit = true;
+    }
+  }
+
+  if (cache_hit) {
+    /* Estimate emission for MIS, as done at the end of compilation. */
+    shader->estimate_emission();
+
+    VLOG_WORK << "Reused compiled nodes for shader " << shader->name;
+    return;
+  }
+
+  compiler.generate(shader, has_bump, *svm_nodes, 0, &summary);
+
+  if (use_cache) {
+    CompiledShader compiled;
+    compiled.svm_nodes = *svm_nodes;
+
+    compiled.has_surface = shader->has_surface;
+    compiled.has_surface_transparent = shader->has_surface_transparent;
+    compiled.has_surface_raytrace = shader->has_surface_raytrace;
+    compiled.has_surface_bssrdf = shader->has_surface_bssrdf;
+    compiled.has_bump = shader->has_bump;
+    compiled.has_bssrdf_bump = shader->has_bssrdf_bump;
+    compiled.has_volume = shader->has_volume;
+    compiled.has_displacement = shader->has_displacement;
+    compiled.has_surface_spatial_varying = shader->has_surface_spatial_varying;
+    compiled.has_volume_spatial_varying = shader->has_volume_spatial_varying;
+    compiled.has_volume_attribute_dependency = shader->has_volume_attribute_dependency;
+
+    compiled.used = true;
+
+    const thread_scoped_lock lock(compile_cache_mutex);
+    compile_cache.emplace(key, compiled);
+  }
 
   VLOG_WORK << "Compilation summary:\n"
             << "Shader name: " << shader->name << "\n"
@@ -61,7 +187,7 @@ void SVMShaderManager::device_update_specific(Device *device,
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->svm.times.add_entry({"device_update", time});
+      scene->update_stats->svm.add_entry({"device_update", time});
     }
   });
 
@@ -75,6 +201,11 @@ void SVMShaderManager::device_update_specific(Device *device,
   device_free(device, dscene, scene);
 
   /* Build all shaders. */
+  compile_cache_hits = 0;
+  for (auto &it : compile_cache) {
+    it.second.used = false;
+  }
+
   TaskPool task_pool;
   vector<array<int4>> shader_svm_nodes(num_shaders);
   for (int i = 0; i < num_shaders; i++) {
@@ -84,6 +215,14 @@ void SVMShaderManager::device_update_specific(Device *device,
   }
   task_pool.wait_work();
 
+  /* Remove compiled shaders that are no longer used by any shader. */
+  for (auto it = compile_cache.begin(); it != compile_cache.end();) {
+    it = it->second.used ? std::next(it) : compile_cache.erase(it);
+  }
+
+  VLOG_INFO << "Reused compiled nodes for " << compile_cache_hits << " of " << num_shaders
+            << " shaders, " << compile_cache.size() << " distinct shaders in cache.";
+
   if (progress.get_cancel()) {
     return;
   }
@@ -876,23 +1015,35 @@ void SVMCompiler::compile(Shader *shader,
                           const int index,
                           Summary *summary)
 {
-  svm_node_types_used[NODE_SHADER_JUMP] = true;
-  svm_nodes.push_back_slow(make_int4(NODE_SHADER_JUMP, 0, 0, 0));
+  const bool has_bump = finalize(shader, summary);
+  generate(shader, has_bump, svm_nodes, index, summary);
+}
 
-  /* copy graph for shader with bump mapping */
+bool SVMCompiler::finalize(Shader *shader, Summary *summary)
+{
   ShaderNode *output = shader->graph->output();
-  const int start_num_svm_nodes = svm_nodes.size();
-
-  const double time_start = time_dt();
 
   const bool has_bump = (shader->get_displacement_method() != DISPLACE_TRUE) &&
                         output->input("Surface")->link && output->input("Displacement")->link;
 
-  /* finalize */
-  {
-    const scoped_timer timer((summary != nullptr) ? &summary->time_finalize : nullptr);
-    shader->graph->finalize(scene, has_bump, shader->get_displacement_method() == DISPLACE_BOTH);
-  }
+  const scoped_timer timer((summary != nullptr) ? &summary->time_finalize : nullptr);
+  shader->graph->finalize(scene, has_bump, shader->get_displacement_method() == DISPLACE_BOTH);
+
+  return has_bump;
+}
+
+void SVMCompiler::generate(Shader *shader,
+                           const bool has_bump,
+                           array<int4> &svm_nodes,
+                           const int index,
+                           Summary *summary)
+{
+  svm_node_types_used[NODE_SHADER_JUMP] = true;
+  svm_nodes.push_back_slow(make_int4(NODE_SHADER_JUMP, 0, 0, 0));
+
+  const int start_num_svm_nodes = svm_nodes.size();
+
+  const double time_start = time_dt();
 
   current_shader = shader;
 
@@ -947,7 +1098,7 @@ void SVMCompiler::compile(Shader *shader,
 
   /* Fill in summary information. */
   if (summary != nullptr) {
-    summary->time_total = time_dt() - time_start;
+    summary->time_total = summary->time_finalize + (time_dt() - time_start);
     summary->peak_stack_usage = max_stack_use;
     summary->num_svm_nodes = svm_nodes.size() - start_num_svm_nodes;
   }
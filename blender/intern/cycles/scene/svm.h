@@ -10,7 +10,9 @@
 #include "scene/shader_graph.h"
 
 #include "util/array.h"
+#include "util/map.h"
 #include "util/string.h"
+#include "util/thread.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -43,6 +45,31 @@ class SVMShaderManager : public ShaderManager {
                             Shader *shader,
                             Progress &progress,
                             array<int4> *svm_nodes);
+
+  /* Compiled shaders, keyed by a hash of the finalized graph and the shader settings that affect
+   * compilation. Shaders with identical graphs share the compiled nodes, and unmodified shaders
+   * reuse them across updates. Entries not used by an update are removed at its end. */
+  struct CompiledShader {
+    array<int4> svm_nodes;
+
+    bool has_surface;
+    bool has_surface_transparent;
+    bool has_surface_raytrace;
+    bool has_surface_bssrdf;
+    bool has_bump;
+    bool has_bssrdf_bump;
+    bool has_volume;
+    bool has_displacement;
+    bool has_surface_spatial_varying;
+    bool has_volume_spatial_varying;
+    bool has_volume_attribute_dependency;
+
+    bool used;
+  };
+
+  unordered_map<string, CompiledShader> compile_cache;
+  thread_mutex compile_cache_mutex;
+  std::atomic<int> compile_cache_hits = 0;
 };
 
 /* Graph Compiler */
@@ -86,6 +113,15 @@ class SVMCompiler {
                const int index,
                Summary *summary = nullptr);
 
+  /* Compilation split in two steps, so the finalized graph can be inspected before generating
+   * nodes. finalize() returns whether a bump shader is needed. */
+  bool finalize(Shader *shader, Summary *summary = nullptr);
+  void generate(Shader *shader,
+                const bool has_bump,
+                array<int4> &svm_nodes,
+                const int index,
+                Summary *summary = nullptr);
+
   int stack_assign(ShaderOutput *output);
   int stack_assign(ShaderInput *input);
   bool is_linked(ShaderInput *input);
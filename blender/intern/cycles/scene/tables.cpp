@@ -32,7 +32,7 @@ void LookupTables::device_update(Device * /*unused*/, DeviceScene *dscene, Scene
 
   const scoped_callback_timer timer([scene](double time) {
     if (scene->update_stats) {
-      scene->update_stats->tables.times.add_entry({"device_update", time});
+      scene->update_stats->tables.add_entry({"device_update", time});
     }
   });
 
@@ -51,6 +51,14 @@ class OutputDriver {
   /* Write tile once it has finished rendering. */
   virtual void write_render_tile(const Tile &tile) = 0;
 
+  /* Return true if write_render_tile() can be called with tiles that only cover a part of the
+   * full frame once rendering is finished. Otherwise the full frame is read from disk at once,
+   * even when it would be cheaper on memory to write it in parts. */
+  virtual bool supports_partial_tiles() const
+  {
+    return false;
+  }
+
   /* Update tile while rendering is in progress. Return true if any update
    * was performed. */
   virtual bool update_render_tile(const Tile & /* tile */)
@@ -661,4 +661,73 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
   return true;
 }
 
+bool TileManager::read_buffer_band_from_disk(const string_view filename,
+                                             const int y,
+                                             RenderBuffers *buffers,
+                                             DenoiseParams *denoise_params,
+                                             int *r_full_height)
+{
+  unique_ptr<ImageInput> in(ImageInput::open(filename));
+  if (!in) {
+    LOG(ERROR) << "Error opening tile file " << filename;
+    return false;
+  }
+
+  const ImageSpec &image_spec = in->spec();
+
+  BufferParams buffer_params;
+  if (!buffer_params_from_image_spec_atttributes(&buffer_params, image_spec)) {
+    return false;
+  }
+
+  if (!node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX)) {
+    return false;
+  }
+
+  const int full_height = buffer_params.height;
+  *r_full_height = full_height;
+
+  /* Read whole rows of image tiles, as many as fit into the memory budget. */
+  const int64_t row_size = int64_t(buffer_params.width) * buffer_params.pass_stride *
+                           sizeof(float);
+  const int budget_rows = int(BAND_READ_MAX_BYTES / std::max(row_size, int64_t(1)));
+  const int max_band_height = max(budget_rows / IMAGE_TILE_SIZE * IMAGE_TILE_SIZE,
+                                  IMAGE_TILE_SIZE);
+  const int band_height = min(max_band_height, full_height - y);
+
+  if (band_height <= 0) {
+    LOG(ERROR) << "Band is outside of the tile file " << filename;
+    return false;
+  }
+
+  /* The band is a part of the full frame, with the window covering the whole band. */
+  buffer_params.full_y += y;
+  buffer_params.height = band_height;
+  buffer_params.window_y = 0;
+  buffer_params.window_height = band_height;
+  buffers->reset(buffer_params);
+
+  const int num_channels = image_spec.nchannels;
+  if (!in->read_scanlines(0,
+                          0,
+                          image_spec.y + y,
+                          image_spec.y + y + band_height,
+                          0,
+                          0,
+                          num_channels,
+                          TypeDesc::FLOAT,
+                          buffers->buffer.data()))
+  {
+    LOG(ERROR) << "Error reading pixels from the tile file " << in->geterror();
+    return false;
+  }
+
+  if (!in->close()) {
+    LOG(ERROR) << "Error closing tile file " << in->geterror();
+    return false;
+  }
+
+  return true;
+}
+
 CCL_NAMESPACE_END
@@ -107,6 +107,18 @@ class TileManager {
                                   RenderBuffers *buffers,
                                   DenoiseParams *denoise_params);
 
+  /* Read a band of rows of the full frame render buffer from tiles file on disk, starting at
+   * row y. The band height is chosen to fit BAND_READ_MAX_BYTES, so that the full frame can be
+   * processed without holding it in memory at once. The full frame height is returned in
+   * r_full_height.
+   *
+   * Returns true on success. */
+  bool read_buffer_band_from_disk(string_view filename,
+                                  const int y,
+                                  RenderBuffers *buffers,
+                                  DenoiseParams *denoise_params,
+                                  int *r_full_height);
+
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
 
@@ -119,6 +131,9 @@ class TileManager {
    * Use conservative value which is safe for most of OpenGL drivers and GPUs. */
   static const int MAX_TILE_SIZE = 8192;
 
+  /* Memory budget of a band of rows read from the tiles file on disk. */
+  static const int64_t BAND_READ_MAX_BYTES = 256 * 1024 * 1024;
+
  protected:
   /* Get tile configuration for its index.
    * The tile index must be within [0, state_.tile_state_). */
@@ -46,4 +46,26 @@ TEST(math, reverse_integer_bits)
   EXPECT_EQ(reverse_integer_bits(0xAAAAAAAA), 0x55555555);
 }
 
+TEST(math, normal_octahedral)
+{
+  const float3 normals[] = {make_float3(1.0f, 0.0f, 0.0f),
+                            make_float3(0.0f, -1.0f, 0.0f),
+                            make_float3(0.0f, 0.0f, 1.0f),
+                            make_float3(0.0f, 0.0f, -1.0f),
+                            normalize(make_float3(1.0f, 2.0f, 3.0f)),
+                            normalize(make_float3(-3.0f, 0.5f, -2.0f)),
+                            normalize(make_float3(-1.0f, -1.0f, -1.0f))};
+
+  for (const float3 N : normals) {
+    const float3 decoded = decode_normal_octahedral(encode_normal_octahedral(N));
+    EXPECT_NEAR(decoded.x, N.x, 1e-4f);
+    EXPECT_NEAR(decoded.y, N.y, 1e-4f);
+    EXPECT_NEAR(decoded.z, N.z, 1e-4f);
+  }
+
+  /* Degenerate normals decode to a valid unit vector. */
+  const float3 zero = decode_normal_octahedral(encode_normal_octahedral(zero_float3()));
+  EXPECT_NEAR(len(zero), 1.0f, 1e-6f);
+}
+
 CCL_NAMESPACE_END
@@ -305,4 +305,16 @@ TEST(string_endswith, basic)
   EXPECT_FALSE(string_endswith("Hello", "WorldHello"));
 }
 
+/* ******** Tests for string_json_escape() ******** */
+
+TEST(string_json_escape, basic)
+{
+  EXPECT_EQ(string_json_escape(""), "");
+  EXPECT_EQ(string_json_escape("Hello"), "Hello");
+  EXPECT_EQ(string_json_escape("say \"hi\""), "say \\\"hi\\\"");
+  EXPECT_EQ(string_json_escape("C:\\path"), "C:\\\\path");
+  EXPECT_EQ(string_json_escape("a\nb"), "a\\nb");
+  EXPECT_EQ(string_json_escape("a\tb"), "a\\u0009b");
+}
+
 CCL_NAMESPACE_END
@@ -31,6 +31,11 @@ void DebugFlags::CPU::reset()
 #undef STRINGIFY
 #undef CHECK_CPU_FLAGS
 
+  specialized_kernels = (getenv("CYCLES_CPU_NO_SPECIALIZED_KERNELS") == nullptr);
+  if (!specialized_kernels) {
+    VLOG_INFO << "Disabling specialized kernels.";
+  }
+
   bvh_layout = BVH_LAYOUT_AUTO;
 }
 
@@ -39,6 +39,9 @@ class DebugFlags {
       return sse42;
     }
 
+    /* Use path tracing kernels specialized for the features used by the scene. */
+    bool specialized_kernels = true;
+
     /* Requested BVH layout.
      *
      * By default the fastest will be used. For debugging the BVH used by other
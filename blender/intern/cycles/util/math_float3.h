@@ -430,6 +430,40 @@ ccl_device_inline float3 safe_normalize_len(const float3 a, ccl_private float *t
   return (*t != 0.0f) ? a / (*t) : a;
 }
 
+/* Encode a unit vector in 32 bits, as two 16 bit coordinates on the octahedron folded into the
+ * unit square. The decoded vector has an error well below what is visible in shading normals. */
+ccl_device_inline uint encode_normal_octahedral(const float3 n)
+{
+  /* Zero length vectors decode to +Z. */
+  const float l1 = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+  const float inv_l1 = (l1 != 0.0f) ? 1.0f / l1 : 0.0f;
+
+  float u = n.x * inv_l1;
+  float v = n.y * inv_l1;
+  if (n.z < 0.0f) {
+    const float fold_u = (1.0f - fabsf(v)) * signf(u);
+    const float fold_v = (1.0f - fabsf(u)) * signf(v);
+    u = fold_u;
+    v = fold_v;
+  }
+
+  const uint qu = uint(float_to_int((clamp(u, -1.0f, 1.0f) * 0.5f + 0.5f) * 65535.0f + 0.5f));
+  const uint qv = uint(float_to_int((clamp(v, -1.0f, 1.0f) * 0.5f + 0.5f) * 65535.0f + 0.5f));
+  return qu | (qv << 16);
+}
+
+ccl_device_inline float3 decode_normal_octahedral(const uint packed)
+{
+  const float u = float(packed & 0xFFFF) * (2.0f / 65535.0f) - 1.0f;
+  const float v = float(packed >> 16) * (2.0f / 65535.0f) - 1.0f;
+
+  const float w = 1.0f - fabsf(u) - fabsf(v);
+  if (w < 0.0f) {
+    return normalize(make_float3((1.0f - fabsf(v)) * signf(u), (1.0f - fabsf(u)) * signf(v), w));
+  }
+  return normalize(make_float3(u, v, w));
+}
+
 ccl_device_inline float3 safe_divide(const float3 a, const float3 b)
 {
   return make_float3((b.x != 0.0f) ? a.x / b.x : 0.0f,
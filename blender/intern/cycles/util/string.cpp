@@ -205,6 +205,28 @@ string string_to_lower(const string &s)
   return r;
 }
 
+string string_json_escape(const string &s)
+{
+  string result;
+  result.reserve(s.size());
+  for (const char c : s) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if (c == '\n') {
+      result += "\\n";
+    }
+    else if (static_cast<unsigned char>(c) < 0x20) {
+      result += string_printf("\\u%04x", int(c));
+    }
+    else {
+      result += c;
+    }
+  }
+  return result;
+}
+
 /* Wide char strings helpers for Windows. */
 
 #ifdef _WIN32
@@ -2834,6 +2834,9 @@ class USERPREF_PT_experimental_new_features(ExperimentalPanel, Panel):
                 ({"property": "use_new_volume_nodes"}, ("blender/blender/issues/103248", "#103248")),
                 ({"property": "use_new_file_import_nodes"}, ("blender/blender/issues/122846", "#122846")),
                 ({"property": "use_shader_node_previews"}, ("blender/blender/issues/110353", "#110353")),
+                ({"property": "use_geometry_nodes_memoization"}, None),
+                ({"property": "use_depsgraph_critical_path_scheduling"}, None),
+                ({"property": "use_depsgraph_incremental_relations"}, None),
             ),
         )
 
@@ -31,6 +31,23 @@ enum class CacheStatus {
   Baked,
 };
 
+/**
+ * Compact in-memory representation of a #BakeState that is used by the compressed simulation
+ * cache. All blobs of the state are concatenated and compressed with zstd. Consecutive simulation
+ * states usually have the same layout and change only slightly, so most frames only store the
+ * difference to the blobs of a previous keyframe, which compresses much better.
+ */
+struct CompressedBakeState {
+  /** Meta data written by #serialize_bake. It references slices in the decompressed blob. */
+  std::string meta;
+  /** Compressed blob data. For delta frames, this is the difference to the keyframe's blob. */
+  Array<std::byte> compressed_blob;
+  /** Size of the blob after decompression. */
+  int64_t blob_size = 0;
+  /** Keyframe that the blob is relative to. This is null for keyframes. */
+  std::shared_ptr<const CompressedBakeState> keyframe;
+};
+
 /**
  * Stores the state for a specific frame.
  */
@@ -42,6 +59,26 @@ struct FrameCache {
    * or from an in-memory buffer.
    */
   std::optional<std::variant<std::string, Span<std::byte>>> meta_data_source;
+  /**
+   * Used when the frame is kept compressed in memory. The #state is then empty, and the frame is
+   * only decompressed temporarily while it is used.
+   */
+  std::shared_ptr<const CompressedBakeState> compressed_state;
+  /**
+   * Decompressed state of a compressed frame. It is owned by the evaluations that use it, so
+   * that concurrent evaluations share it, and it is freed once the last of them is done.
+   */
+  std::weak_ptr<const BakeState> decompressed_state;
+};
+
+/**
+ * Settings for the compressed in-memory simulation cache.
+ */
+struct FrameCacheCompression {
+  /** Positions and velocities are rounded to this distance when positive. */
+  float quantize_precision = 0.0f;
+  /** Maximum size of all cached frames in bytes. Zero means that there is no limit. */
+  int64_t memory_limit = 0;
 };
 
 /**
@@ -70,6 +107,9 @@ struct NodeBakeCache {
   /** Used to avoid checking if a bake exists many times. */
   bool failed_finding_bake = false;
 
+  /** Total size of the compressed frames, see #FrameCache::compressed_state. */
+  int64_t compressed_frames_size = 0;
+
   /** Range spanning from the first to the last baked frame. */
   IndexRange frame_range() const;
 
@@ -110,6 +150,20 @@ struct ModifierCache {
   void reset_cache(int id);
 };
 
+/**
+ * Compresses the states of all cached frames except for the last two, which may still be used to
+ * continue the simulation. Afterwards, frames are removed until the memory limit is met. Removed
+ * frames are spread out evenly, so that the remaining frames can still be interpolated.
+ */
+void compress_frame_caches(NodeBakeCache &bake_cache, const FrameCacheCompression &compression);
+
+/**
+ * Get the decompressed state of a compressed frame, which is reused while another user still
+ * holds it. The caller keeps the state alive for as long as it references its items. Returns
+ * null when the frame is not compressed or could not be decompressed.
+ */
+std::shared_ptr<const BakeState> ensure_frame_cache_decompressed(FrameCache &frame_cache);
+
 /**
  * Reset all simulation caches in the scene, for use when some fundamental change made them
  * impossible to reuse.
@@ -10,6 +10,8 @@
 
 #include "BKE_bake_items.hh"
 
+struct BLI_mmap_file;
+
 namespace blender::bke::bake {
 
 /**
@@ -37,6 +39,15 @@ class BlobReader {
    */
   [[nodiscard]] virtual bool read(const BlobSlice &slice, void *r_data) const = 0;
 
+  /**
+   * Read zstd compressed data from the given slice and decompress it into the provided memory
+   * buffer, which has to be large enough for the uncompressed data.
+   * \return True on success, otherwise false.
+   */
+  [[nodiscard]] virtual bool read_compressed(const BlobSlice &slice,
+                                             int64_t uncompressed_size,
+                                             void *r_data) const;
+
   /**
    * Provides an #istream that can be used to read the data from the given slice.
    * \return True on success, otherwise false.
@@ -45,12 +56,27 @@ class BlobReader {
                                             FunctionRef<bool(std::istream &)> fn) const;
 };
 
+/**
+ * Settings for how data is stored by a #BlobWriter.
+ */
+struct BlobWriteOptions {
+  /** Compress blobs with zstd. Reading compressed blobs is always supported. */
+  bool compress = false;
+  /**
+   * When positive, positions and velocities are rounded before they are written. The rounding step
+   * is the largest power of two that is not larger than this distance, so the error is at most
+   * half of that. This loses precision but makes the data compress much better.
+   */
+  float quantize_precision = 0.0f;
+};
+
 /**
  * Abstract base class for writing binary data.
  */
 class BlobWriter {
  protected:
   int64_t total_written_size_ = 0;
+  BlobWriteOptions options_;
 
  public:
   virtual ~BlobWriter() = default;
@@ -74,6 +100,16 @@ class BlobWriter {
   {
     return total_written_size_;
   }
+
+  const BlobWriteOptions &options() const
+  {
+    return options_;
+  }
+
+  void set_options(const BlobWriteOptions &options)
+  {
+    options_ = options;
+  }
 };
 
 /**
@@ -101,11 +137,17 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    */
   Map<const ImplicitSharingInfo *, StoredByRuntimeValue> stored_by_runtime_;
 
+  struct StoredByContentHashValue {
+    BlobSlice slice;
+    /** Size of the data before compression, or -1 if the slice is not compressed. */
+    int64_t uncompressed_size = -1;
+  };
+
   /**
    * Remembers where data was stored based on the hash of the data. This allows us to skip writing
    * the same array again if it has the same hash.
    */
-  Map<uint64_t, BlobSlice> slice_by_content_hash_;
+  Map<uint64_t, StoredByContentHashValue> stored_by_content_hash_;
 
  public:
   ~BlobWriteSharing();
@@ -123,7 +165,8 @@ class BlobWriteSharing : NonCopyable, NonMovable {
   /**
    * Checks if the given data was written before. If it was, it's not written again, but a
    * reference to the previously written data is returned. If the data is new, it's written now.
-   * Its hash is remembered so that the same data won't be written again.
+   * Its hash is remembered so that the same data won't be written again. The data is compressed
+   * if that is enabled in the options of the writer.
    */
   [[nodiscard]] std::shared_ptr<io::serialize::DictionaryValue> write_deduplicated(
       BlobWriter &writer, const void *data, int64_t size_in_bytes);
@@ -157,16 +200,22 @@ class BlobReadSharing : NonCopyable, NonMovable {
 };
 
 /**
- * A specific #BlobReader that reads from disk.
+ * A specific #BlobReader that reads from disk. Blob files are memory-mapped, so that only the
+ * parts of a file that are actually read have to be loaded, and reads can happen in parallel.
  */
-class DiskBlobReader : public BlobReader {
+class DiskBlobReader : public BlobReader, NonCopyable, NonMovable {
  private:
   const std::string blobs_dir_;
+  /** Protects #mapped_files_. The mapped memory itself can be read without locking. */
   mutable std::mutex mutex_;
-  mutable Map<std::string, std::unique_ptr<fstream>> open_input_streams_;
+  /** Memory-mapped blob files by their name. Null if the file could not be mapped. */
+  mutable Map<std::string, BLI_mmap_file *> mapped_files_;
+
+  BLI_mmap_file *ensure_mapped_file(StringRef name) const;
 
  public:
   DiskBlobReader(std::string blobs_dir);
+  ~DiskBlobReader();
   [[nodiscard]] bool read(const BlobSlice &slice, void *r_data) const override;
 };
 
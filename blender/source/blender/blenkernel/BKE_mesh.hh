@@ -11,6 +11,7 @@
 #include "BLI_index_mask_fwd.hh"
 #include "BLI_offset_indices.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_virtual_array.hh"
 
 #include "BKE_mesh.h"         // IWYU pragma: export
 #include "BKE_mesh_types.hh"  // IWYU pragma: export
@@ -356,6 +357,53 @@ inline int edge_other_vert(const int2 edge, const int vert)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Derived Data Cache
+ * \{ */
+
+/**
+ * Get an array derived from the mesh from the mesh's #MeshDerivedDataCache, or compute and cache
+ * it when it isn't available yet. The array is shared with copies of the mesh and is kept until
+ * the data it depends on changes.
+ *
+ * \param key: Identifies the data. It has to be unique for the way the data is computed and for
+ * the type of the array.
+ */
+template<typename T>
+VArray<T> derived_data_lookup_or_compute(const Mesh &mesh,
+                                         const MeshDerivedDataDependency dependency,
+                                         const StringRef key,
+                                         const FunctionRef<Array<T>()> compute_fn)
+{
+  using SharedArray = ImplicitSharedValue<Array<T>>;
+  /* Keeps the cached array alive while the virtual array is used. */
+  struct SharedSpan {
+    using value_type = T;
+    ImplicitSharingPtr<> sharing_info;
+    Span<T> span;
+    const T *data() const
+    {
+      return span.data();
+    }
+    int64_t size() const
+    {
+      return span.size();
+    }
+  };
+
+  SharedCache<MeshDerivedDataCache> &shared_cache =
+      dependency == MeshDerivedDataDependency::Topology ?
+          mesh.runtime->topology_derived_data_cache :
+          mesh.runtime->positions_derived_data_cache;
+  shared_cache.ensure([](MeshDerivedDataCache &cache) { cache.clear(); });
+  ImplicitSharingPtr<> sharing_info = shared_cache.data().lookup_or_compute(
+      key, [&]() { return ImplicitSharingPtr<>(new SharedArray(compute_fn())); });
+  const Span<T> span = static_cast<const SharedArray *>(sharing_info.get())->data;
+  return VArray<T>::ForContainer(SharedSpan{std::move(sharing_info), span});
+}
+
+/** \} */
+
 }  // namespace mesh
 
 /** Create a mesh with no built-in attributes. */
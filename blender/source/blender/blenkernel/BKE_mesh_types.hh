@@ -10,14 +10,19 @@
 
 #include <memory>
 #include <mutex>
+#include <string>
 
 #include "BLI_array.hh"
 #include "BLI_bit_vector.hh"
 #include "BLI_bounds_types.hh"
+#include "BLI_function_ref.hh"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_kdopbvh.hh"
+#include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_shared_cache.hh"
+#include "BLI_utility_mixins.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_customdata_types.h"
@@ -108,6 +113,40 @@ struct TrianglesCache {
   void tag_dirty();
 };
 
+/**
+ * Generic cache for data that is derived from a mesh, like face areas or island indices that are
+ * computed by field inputs. Entries are identified by a key chosen by the code that computes them
+ * and are computed at most once. Like the other caches in #MeshRuntime, this is shared between
+ * copies of the mesh until the data it depends on changes.
+ * Use #mesh::derived_data_lookup_or_compute to access it.
+ */
+class MeshDerivedDataCache : NonCopyable, NonMovable {
+ private:
+  struct Entry {
+    CacheMutex mutex;
+    ImplicitSharingPtr<> data;
+  };
+  mutable std::mutex mutex_;
+  mutable Map<std::string, std::unique_ptr<Entry>> entries_;
+
+ public:
+  /**
+   * Get the data stored for the key, or compute it when it's not available yet. Different threads
+   * can compute data for different keys at the same time.
+   */
+  ImplicitSharingPtr<> lookup_or_compute(StringRef key,
+                                         FunctionRef<ImplicitSharingPtr<>()> compute_fn) const;
+  void clear();
+};
+
+/** The data that a #MeshDerivedDataCache entry depends on. */
+enum class MeshDerivedDataDependency {
+  /** The data depends on the topology of the mesh only, e.g. vertex neighbor counts. */
+  Topology,
+  /** The data depends on vertex positions as well, e.g. face areas. */
+  Positions,
+};
+
 struct MeshRuntime {
   /**
    * "Evaluated" mesh owned by this mesh. Used for objects which don't have effective modifiers, so
@@ -228,6 +267,11 @@ struct MeshRuntime {
   /** Cache of non-manifold boundary data for shrinkwrap target Project. */
   SharedCache<ShrinkwrapBoundaryData> shrinkwrap_boundary_cache;
 
+  /** Cache of derived data that only depends on the mesh topology. */
+  SharedCache<MeshDerivedDataCache> topology_derived_data_cache;
+  /** Cache of derived data that also depends on vertex positions. */
+  SharedCache<MeshDerivedDataCache> positions_derived_data_cache;
+
   /**
    * A bit vector the size of the number of vertices, set to true for the center vertices of
    * subdivided faces. The values are set by the subdivision surface modifier and used by
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <sstream>
+#include <zstd.h>
 
 #include "BKE_bake_geometry_nodes_modifier.hh"
 #include "BKE_collection.hh"
@@ -11,8 +12,10 @@
 #include "DNA_modifier_types.h"
 #include "DNA_node_types.h"
 
+#include "BLI_memory_counter.hh"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 
 #include "MOD_nodes.hh"
 
@@ -79,6 +82,215 @@ void ModifierCache::reset_cache(const int id)
   }
 }
 
+/** Name of the single blob that all data of a compressed frame is written to. */
+static constexpr const char *compressed_blob_name = "memory";
+
+/**
+ * Number of frames after which a new keyframe is stored. Shorter intervals make the deltas
+ * smaller, longer intervals avoid storing full frames.
+ */
+static constexpr float compressed_keyframe_interval = 10.0f;
+
+/**
+ * A #BlobWriter that writes all blobs into one contiguous buffer.
+ */
+class ContiguousBlobWriter : public BlobWriter {
+ public:
+  Vector<std::byte> buffer;
+
+  BlobSlice write(const void *data, const int64_t size) override
+  {
+    const int64_t offset = this->buffer.size();
+    this->buffer.extend(Span(static_cast<const std::byte *>(data), size));
+    total_written_size_ += size;
+    return {compressed_blob_name, IndexRange::from_begin_size(offset, size)};
+  }
+};
+
+static void xor_blob(const Span<std::byte> src, MutableSpan<std::byte> dst)
+{
+  const int64_t size = std::min(src.size(), dst.size());
+  threading::parallel_for(IndexRange(size), 1 << 16, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      dst[i] = std::byte(uint8_t(dst[i]) ^ uint8_t(src[i]));
+    }
+  });
+}
+
+static std::optional<Array<std::byte>> decompress_blob(const CompressedBakeState &compressed)
+{
+  Array<std::byte> blob(compressed.blob_size, NoInitialization());
+  const size_t result = ZSTD_decompress(blob.data(),
+                                        blob.size(),
+                                        compressed.compressed_blob.data(),
+                                        compressed.compressed_blob.size());
+  if (ZSTD_isError(result) || int64_t(result) != compressed.blob_size) {
+    return std::nullopt;
+  }
+  if (compressed.keyframe) {
+    const std::optional<Array<std::byte>> keyframe_blob = decompress_blob(*compressed.keyframe);
+    if (!keyframe_blob) {
+      return std::nullopt;
+    }
+    xor_blob(*keyframe_blob, blob);
+  }
+  return blob;
+}
+
+static std::shared_ptr<const CompressedBakeState> compress_bake_state(
+    const BakeState &state,
+    std::shared_ptr<const CompressedBakeState> keyframe,
+    const float quantize_precision)
+{
+  ContiguousBlobWriter blob_writer;
+  BlobWriteOptions options;
+  options.quantize_precision = quantize_precision;
+  blob_writer.set_options(options);
+  BlobWriteSharing blob_sharing;
+  std::ostringstream meta_stream{std::ios::binary};
+  serialize_bake(state, blob_writer, blob_sharing, meta_stream);
+
+  MutableSpan<std::byte> blob = blob_writer.buffer;
+  if (keyframe) {
+    /* Consecutive states are typically written in the same order with the same sizes, so the
+     * difference contains mostly zeros. This is lossless, even if the layout has changed. */
+    const std::optional<Array<std::byte>> keyframe_blob = decompress_blob(*keyframe);
+    if (!keyframe_blob) {
+      return {};
+    }
+    xor_blob(*keyframe_blob, blob);
+  }
+
+  Array<std::byte> compressed_blob(ZSTD_compressBound(blob.size()), NoInitialization());
+  /* Use a fast compression level, because frames are compressed during playback. */
+  const size_t compressed_size = ZSTD_compress(
+      compressed_blob.data(), compressed_blob.size(), blob.data(), blob.size(), 1);
+  if (ZSTD_isError(compressed_size)) {
+    return {};
+  }
+
+  auto compressed = std::make_shared<CompressedBakeState>();
+  compressed->meta = meta_stream.str();
+  compressed->compressed_blob = Array<std::byte>(
+      compressed_blob.as_span().take_front(compressed_size));
+  compressed->blob_size = blob.size();
+  compressed->keyframe = std::move(keyframe);
+  return compressed;
+}
+
+static int64_t compressed_state_size(const CompressedBakeState &compressed)
+{
+  return compressed.compressed_blob.size() + int64_t(compressed.meta.size());
+}
+
+/**
+ * Removes compressed frames until the memory limit is met. Every time, the frame that leaves the
+ * smallest gap between its neighbors is removed, so that the remaining frames stay evenly spread.
+ * Keyframes that other frames depend on are kept, because removing them would not free memory.
+ * Temporarily decompressed states are not counted. They are owned by the evaluations that use
+ * them, so frames can be removed while they are decompressed.
+ */
+static void thin_out_frame_caches(NodeBakeCache &bake_cache, const int64_t memory_limit)
+{
+  Vector<std::unique_ptr<FrameCache>> &frames = bake_cache.frames;
+  int64_t memory_size = bake_cache.compressed_frames_size;
+  MemoryCount uncompressed_memory;
+  MemoryCounter memory_counter{uncompressed_memory};
+  for (const std::unique_ptr<FrameCache> &frame_cache : frames) {
+    if (!frame_cache->compressed_state) {
+      frame_cache->state.count_memory(memory_counter);
+    }
+  }
+  memory_size += uncompressed_memory.total_bytes;
+  while (memory_size > memory_limit && frames.size() > 2) {
+    std::optional<int> remove_index;
+    float min_gap = FLT_MAX;
+    for (const int i : frames.index_range().drop_front(1).drop_back(1)) {
+      const FrameCache &frame_cache = *frames[i];
+      if (!frame_cache.compressed_state || frame_cache.compressed_state.use_count() > 1) {
+        continue;
+      }
+      const float gap = float(frames[i + 1]->frame) - float(frames[i - 1]->frame);
+      if (gap < min_gap) {
+        min_gap = gap;
+        remove_index = i;
+      }
+    }
+    if (!remove_index) {
+      break;
+    }
+    const int64_t removed_size = compressed_state_size(*frames[*remove_index]->compressed_state);
+    bake_cache.compressed_frames_size -= removed_size;
+    memory_size -= removed_size;
+    frames.remove(*remove_index);
+  }
+}
+
+void compress_frame_caches(NodeBakeCache &bake_cache, const FrameCacheCompression &compression)
+{
+  Vector<std::unique_ptr<FrameCache>> &frames = bake_cache.frames;
+  std::shared_ptr<const CompressedBakeState> keyframe;
+  float keyframe_frame = 0.0f;
+  for (const int i : frames.index_range().drop_back(2)) {
+    FrameCache &frame_cache = *frames[i];
+    if (frame_cache.compressed_state) {
+      if (!frame_cache.compressed_state->keyframe) {
+        keyframe = frame_cache.compressed_state;
+        keyframe_frame = float(frame_cache.frame);
+      }
+      continue;
+    }
+    if (frame_cache.state.items_by_id.is_empty()) {
+      continue;
+    }
+    const bool use_keyframe = keyframe && float(frame_cache.frame) - keyframe_frame <
+                                              compressed_keyframe_interval;
+    std::shared_ptr<const CompressedBakeState> compressed = compress_bake_state(
+        frame_cache.state, use_keyframe ? keyframe : nullptr, compression.quantize_precision);
+    if (!compressed) {
+      continue;
+    }
+    if (!use_keyframe) {
+      keyframe = compressed;
+      keyframe_frame = float(frame_cache.frame);
+    }
+    bake_cache.compressed_frames_size += compressed_state_size(*compressed);
+    frame_cache.compressed_state = std::move(compressed);
+    frame_cache.state = {};
+  }
+  if (compression.memory_limit > 0) {
+    thin_out_frame_caches(bake_cache, compression.memory_limit);
+  }
+}
+
+std::shared_ptr<const BakeState> ensure_frame_cache_decompressed(FrameCache &frame_cache)
+{
+  if (!frame_cache.compressed_state) {
+    return nullptr;
+  }
+  if (std::shared_ptr<const BakeState> state = frame_cache.decompressed_state.lock()) {
+    return state;
+  }
+  const CompressedBakeState &compressed = *frame_cache.compressed_state;
+  const std::optional<Array<std::byte>> blob = decompress_blob(compressed);
+  if (!blob) {
+    return nullptr;
+  }
+  MemoryBlobReader blob_reader;
+  blob_reader.add(compressed_blob_name, *blob);
+  /* Use a separate read sharing, because the decompressed blob only exists temporarily. */
+  BlobReadSharing blob_sharing;
+  std::istringstream meta_stream{compressed.meta, std::ios::binary};
+  std::optional<BakeState> state = deserialize_bake(meta_stream, blob_reader, blob_sharing);
+  if (!state) {
+    return nullptr;
+  }
+  std::shared_ptr<const BakeState> shared_state = std::make_shared<const BakeState>(
+      std::move(*state));
+  frame_cache.decompressed_state = shared_state;
+  return shared_state;
+}
+
 void scene_simulation_states_reset(Scene &scene)
 {
   FOREACH_SCENE_OBJECT_BEGIN (&scene, ob) {
@@ -0,0 +1,162 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "testing/testing.h"
+
+#include "BKE_bake_geometry_nodes_modifier.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_idtype.hh"
+#include "BKE_pointcloud.hh"
+
+#include "DNA_pointcloud_types.h"
+
+namespace blender::bke::bake::tests {
+
+static constexpr int points_num = 1000;
+
+static float3 point_position(const int point, const int frame)
+{
+  return {float(point), float(frame) * 0.25f, float(point % 7)};
+}
+
+static std::unique_ptr<FrameCache> make_frame_cache(const int frame)
+{
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(points_num);
+  MutableSpan<float3> positions = pointcloud->positions_for_write();
+  for (const int i : positions.index_range()) {
+    positions[i] = point_position(i, frame);
+  }
+  auto frame_cache = std::make_unique<FrameCache>();
+  frame_cache->frame = SubFrame(frame);
+  frame_cache->state.items_by_id.add_new(
+      0, std::make_unique<GeometryBakeItem>(GeometrySet::from_pointcloud(pointcloud)));
+  return frame_cache;
+}
+
+static void expect_frame_positions(const BakeState &state, const int frame)
+{
+  const std::unique_ptr<BakeItem> *item = state.items_by_id.lookup_ptr(0);
+  ASSERT_NE(item, nullptr);
+  const auto *geometry_item = dynamic_cast<const GeometryBakeItem *>(item->get());
+  ASSERT_NE(geometry_item, nullptr);
+  const PointCloud *pointcloud = geometry_item->geometry.get_pointcloud();
+  ASSERT_NE(pointcloud, nullptr);
+  const Span<float3> positions = pointcloud->positions();
+  ASSERT_EQ(positions.size(), points_num);
+  for (const int i : positions.index_range()) {
+    EXPECT_EQ(positions[i], point_position(i, frame));
+  }
+}
+
+class bake_frame_cache_compression : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+TEST_F(bake_frame_cache_compression, keyframe_and_delta_round_trip)
+{
+  NodeBakeCache bake_cache;
+  for (const int frame : IndexRange(1, 14)) {
+    bake_cache.frames.append(make_frame_cache(frame));
+  }
+
+  compress_frame_caches(bake_cache, {});
+
+  const Span<std::unique_ptr<FrameCache>> frames = bake_cache.frames;
+  /* The last two frames are still used to continue the simulation. */
+  for (const int i : frames.index_range().take_back(2)) {
+    EXPECT_EQ(frames[i]->compressed_state, nullptr);
+    EXPECT_FALSE(frames[i]->state.items_by_id.is_empty());
+  }
+  for (const int i : frames.index_range().drop_back(2)) {
+    ASSERT_NE(frames[i]->compressed_state, nullptr);
+    EXPECT_TRUE(frames[i]->state.items_by_id.is_empty());
+  }
+  EXPECT_GT(bake_cache.compressed_frames_size, 0);
+
+  /* Frames 1 and 11 are keyframes, the others store the difference to the previous keyframe. */
+  const CompressedBakeState &keyframe = *frames[0]->compressed_state;
+  const CompressedBakeState &delta_frame = *frames[4]->compressed_state;
+  EXPECT_EQ(keyframe.keyframe, nullptr);
+  EXPECT_EQ(delta_frame.keyframe.get(), &keyframe);
+  EXPECT_EQ(frames[10]->compressed_state->keyframe, nullptr);
+  EXPECT_EQ(frames[11]->compressed_state->keyframe, frames[10]->compressed_state);
+  EXPECT_LT(delta_frame.compressed_blob.size(), keyframe.compressed_blob.size());
+
+  for (const int i : frames.index_range().drop_back(2)) {
+    const std::shared_ptr<const BakeState> state = ensure_frame_cache_decompressed(*frames[i]);
+    ASSERT_NE(state, nullptr);
+    expect_frame_positions(*state, frames[i]->frame.frame());
+  }
+}
+
+TEST_F(bake_frame_cache_compression, decompressed_state_shared_by_users)
+{
+  NodeBakeCache bake_cache;
+  for (const int frame : IndexRange(1, 4)) {
+    bake_cache.frames.append(make_frame_cache(frame));
+  }
+  compress_frame_caches(bake_cache, {});
+  FrameCache &frame_cache = *bake_cache.frames.first();
+  ASSERT_NE(frame_cache.compressed_state, nullptr);
+  EXPECT_EQ(ensure_frame_cache_decompressed(*bake_cache.frames.last()), nullptr);
+
+  /* Concurrent users share the decompressed state. */
+  std::shared_ptr<const BakeState> state_a = ensure_frame_cache_decompressed(frame_cache);
+  std::shared_ptr<const BakeState> state_b = ensure_frame_cache_decompressed(frame_cache);
+  ASSERT_NE(state_a, nullptr);
+  EXPECT_EQ(state_a, state_b);
+  EXPECT_TRUE(frame_cache.state.items_by_id.is_empty());
+
+  /* The state stays valid while a user holds it, also when the frame is removed. */
+  state_a.reset();
+  EXPECT_FALSE(frame_cache.decompressed_state.expired());
+  bake_cache.frames.remove(0);
+  expect_frame_positions(*state_b, 1);
+
+  /* It is freed when the last user is done. */
+  const std::weak_ptr<const BakeState> weak_state = state_b;
+  state_b.reset();
+  EXPECT_TRUE(weak_state.expired());
+}
+
+TEST_F(bake_frame_cache_compression, memory_limit)
+{
+  NodeBakeCache bake_cache;
+  for (const int frame : IndexRange(1, 30)) {
+    bake_cache.frames.append(make_frame_cache(frame));
+  }
+  compress_frame_caches(bake_cache, {});
+  const int64_t full_size = bake_cache.compressed_frames_size;
+
+  FrameCacheCompression compression;
+  compression.memory_limit = full_size / 2;
+  compress_frame_caches(bake_cache, compression);
+
+  EXPECT_LT(bake_cache.frames.size(), 30);
+  EXPECT_EQ(bake_cache.frames.first()->frame, SubFrame(1));
+  EXPECT_EQ(bake_cache.frames.last()->frame, SubFrame(30));
+
+  int64_t compressed_size = 0;
+  for (const std::unique_ptr<FrameCache> &frame_cache : bake_cache.frames) {
+    if (frame_cache->compressed_state) {
+      compressed_size += frame_cache->compressed_state->compressed_blob.size() +
+                         int64_t(frame_cache->compressed_state->meta.size());
+      const std::shared_ptr<const BakeState> state = ensure_frame_cache_decompressed(
+          *frame_cache);
+      ASSERT_NE(state, nullptr);
+      expect_frame_positions(*state, frame_cache->frame.frame());
+    }
+  }
+  EXPECT_EQ(bake_cache.compressed_frames_size, compressed_size);
+}
+
+}  // namespace blender::bke::bake::tests
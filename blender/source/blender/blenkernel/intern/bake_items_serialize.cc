@@ -13,12 +13,16 @@
 #include "BKE_pointcloud.hh"
 #include "BKE_volume.hh"
 
+#include "BLI_array.hh"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix_types.hh"
+#include "BLI_mmap.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 
 #include "DNA_object_types.h"
 #include "DNA_volume_types.h"
@@ -27,8 +31,18 @@
 #include "RNA_enum_types.hh"
 
 #include <fmt/format.h>
+#include <algorithm>
+#include <cmath>
+#include <fcntl.h>
 #include <sstream>
 #include <xxhash.h>
+#include <zstd.h>
+
+#ifndef _WIN32
+#  include <unistd.h> /* For close. */
+#else
+#  include <io.h> /* For close. */
+#endif
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
@@ -87,27 +101,60 @@ bool BlobReader::read_as_stream(const BlobSlice &slice, FunctionRef<bool(std::is
   return true;
 }
 
+bool BlobReader::read_compressed(const BlobSlice &slice,
+                                 const int64_t uncompressed_size,
+                                 void *r_data) const
+{
+  Array<std::byte> compressed_data(slice.range.size(), NoInitialization());
+  if (!this->read(slice, compressed_data.data())) {
+    return false;
+  }
+  const size_t result = ZSTD_decompress(
+      r_data, uncompressed_size, compressed_data.data(), compressed_data.size());
+  if (ZSTD_isError(result)) {
+    return false;
+  }
+  return result == size_t(uncompressed_size);
+}
+
 DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blobs_dir)) {}
 
-[[nodiscard]] bool DiskBlobReader::read(const BlobSlice &slice, void *r_data) const
+DiskBlobReader::~DiskBlobReader()
 {
-  if (slice.range.is_empty()) {
-    return true;
+  for (BLI_mmap_file *mapped_file : mapped_files_.values()) {
+    if (mapped_file) {
+      BLI_mmap_free(mapped_file);
+    }
   }
+}
 
-  char blob_path[FILE_MAX];
-  BLI_path_join(blob_path, sizeof(blob_path), blobs_dir_.c_str(), slice.name.c_str());
-
+BLI_mmap_file *DiskBlobReader::ensure_mapped_file(const StringRef name) const
+{
   std::lock_guard lock{mutex_};
-  std::unique_ptr<fstream> &blob_file = open_input_streams_.lookup_or_add_cb_as(blob_path, [&]() {
-    return std::make_unique<fstream>(blob_path, std::ios::in | std::ios::binary);
+  return mapped_files_.lookup_or_add_cb_as(name, [&]() -> BLI_mmap_file * {
+    char blob_path[FILE_MAX];
+    BLI_path_join(blob_path, sizeof(blob_path), blobs_dir_.c_str(), std::string(name).c_str());
+    const int file = BLI_open(blob_path, O_BINARY | O_RDONLY, 0);
+    if (file == -1) {
+      return nullptr;
+    }
+    /* The mapping stays valid after the file is closed. */
+    BLI_mmap_file *mapped_file = BLI_mmap_open(file);
+    close(file);
+    return mapped_file;
   });
-  blob_file->seekg(slice.range.start());
-  blob_file->read(static_cast<char *>(r_data), slice.range.size());
-  if (blob_file->gcount() != slice.range.size()) {
+}
+
+[[nodiscard]] bool DiskBlobReader::read(const BlobSlice &slice, void *r_data) const
+{
+  if (slice.range.is_empty()) {
+    return true;
+  }
+  BLI_mmap_file *mapped_file = this->ensure_mapped_file(slice.name);
+  if (!mapped_file) {
     return false;
   }
-  return true;
+  return BLI_mmap_read(mapped_file, r_data, slice.range.start(), slice.range.size());
 }
 
 DiskBlobWriter::DiskBlobWriter(std::string blob_dir, std::string base_name)
@@ -251,13 +298,36 @@ DictionaryValuePtr BlobWriteSharing::write_implicitly_shared(
       });
 }
 
+/** Smaller blobs are not compressed, because the gain is negligible. */
+static constexpr int64_t min_compressed_blob_size = 256;
+
 std::shared_ptr<io::serialize::DictionaryValue> BlobWriteSharing::write_deduplicated(
     BlobWriter &writer, const void *data, const int64_t size_in_bytes)
 {
   const uint64_t content_hash = XXH3_64bits(data, size_in_bytes);
-  const BlobSlice slice = slice_by_content_hash_.lookup_or_add_cb(
-      content_hash, [&]() { return writer.write(data, size_in_bytes); });
-  return slice.serialize();
+  const StoredByContentHashValue &stored = stored_by_content_hash_.lookup_or_add_cb(
+      content_hash, [&]() -> StoredByContentHashValue {
+        if (writer.options().compress && size_in_bytes >= min_compressed_blob_size) {
+          Array<std::byte> compressed_data(ZSTD_compressBound(size_in_bytes),
+                                           NoInitialization());
+          const size_t compressed_size = ZSTD_compress(compressed_data.data(),
+                                                       compressed_data.size(),
+                                                       data,
+                                                       size_in_bytes,
+                                                       ZSTD_CLEVEL_DEFAULT);
+          /* Keep the data uncompressed if compression does not help. */
+          if (!ZSTD_isError(compressed_size) && int64_t(compressed_size) < size_in_bytes) {
+            return {writer.write(compressed_data.data(), compressed_size), size_in_bytes};
+          }
+        }
+        return {writer.write(data, size_in_bytes)};
+      });
+  DictionaryValuePtr io_data = stored.slice.serialize();
+  if (stored.uncompressed_size != -1) {
+    io_data->append_str("compression", "zstd");
+    io_data->append_int("uncompressed_size", stored.uncompressed_size);
+  }
+  return io_data;
 }
 
 std::optional<ImplicitSharingInfoAndData> BlobReadSharing::read_shared(
@@ -327,6 +397,35 @@ static std::optional<eCustomDataType> get_data_type_from_io_name(const StringRef
   return eCustomDataType(domain);
 }
 
+/**
+ * Read the data of a slice that was written with #BlobWriteSharing::write_deduplicated, which may
+ * have been compressed.
+ */
+[[nodiscard]] static bool read_blob_slice(const BlobReader &blob_reader,
+                                          const DictionaryValue &io_data,
+                                          const int64_t size_in_bytes,
+                                          void *r_data)
+{
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  if (!slice) {
+    return false;
+  }
+  const std::optional<StringRefNull> compression = io_data.lookup_str("compression");
+  if (!compression) {
+    if (slice->range.size() != size_in_bytes) {
+      return false;
+    }
+    return blob_reader.read(*slice, r_data);
+  }
+  if (*compression != "zstd") {
+    return false;
+  }
+  if (io_data.lookup_int("uncompressed_size") != size_in_bytes) {
+    return false;
+  }
+  return blob_reader.read_compressed(*slice, size_in_bytes, r_data);
+}
+
 /**
  * Write the data and remember which endianness the data had.
  */
@@ -352,14 +451,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
                                                          const int64_t elements_num,
                                                          void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
-  if (!slice) {
-    return false;
-  }
-  if (slice->range.size() != element_size * elements_num) {
-    return false;
-  }
-  if (!blob_reader.read(*slice, r_data)) {
+  if (!read_blob_slice(blob_reader, io_data, element_size * elements_num, r_data)) {
     return false;
   }
   const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
@@ -400,14 +492,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_wr
                                               const int64_t bytes_num,
                                               void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
-  if (!slice) {
-    return false;
-  }
-  if (slice->range.size() != bytes_num) {
-    return false;
-  }
-  return blob_reader.read(*slice, r_data);
+  return read_blob_slice(blob_reader, io_data, bytes_num, r_data);
 }
 
 static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob_writer,
@@ -1041,6 +1126,56 @@ static std::shared_ptr<io::serialize::ArrayValue> serialize_materials(
   return io_materials;
 }
 
+/**
+ * Clear the mantissa bits of the value that are not needed to keep the rounding error below
+ * `2^precision_exponent`. The zeroed bits make the data compress much better.
+ */
+static float quantize_float(const float value, const int precision_exponent)
+{
+  if (!std::isfinite(value)) {
+    return value;
+  }
+  int exponent;
+  std::frexp(value, &exponent);
+  const int bits_to_clear = std::clamp(precision_exponent - exponent + 24, 0, 23);
+  if (bits_to_clear == 0) {
+    return value;
+  }
+  const uint32_t mask = (uint32_t(1) << bits_to_clear) - 1;
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(float));
+  /* Round to the nearest representable value instead of truncating. */
+  bits = (bits + (mask >> 1) + 1) & ~mask;
+  float result;
+  memcpy(&result, &bits, sizeof(float));
+  return result;
+}
+
+static Array<float3> quantize_float3s(const Span<float3> src, const float precision)
+{
+  const int precision_exponent = int(std::floor(std::log2(precision)));
+  Array<float3> dst(src.size(), NoInitialization());
+  threading::parallel_for(src.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      dst[i] = float3(quantize_float(src[i].x, precision_exponent),
+                      quantize_float(src[i].y, precision_exponent),
+                      quantize_float(src[i].z, precision_exponent));
+    }
+  });
+  return dst;
+}
+
+static bool should_quantize_attribute(const AttributeIter &iter, const BlobWriter &blob_writer)
+{
+  if (blob_writer.options().quantize_precision <= 0.0f) {
+    return false;
+  }
+  if (iter.data_type != CD_PROP_FLOAT3) {
+    return false;
+  }
+  return ELEM(iter.name, "position", "velocity");
+}
+
 static std::shared_ptr<io::serialize::ArrayValue> serialize_attributes(
     const AttributeAccessor &attributes,
     BlobWriter &blob_writer,
@@ -1066,12 +1201,22 @@ static std::shared_ptr<io::serialize::ArrayValue> serialize_attributes(
 
     const GAttributeReader attribute = iter.get();
     const GVArraySpan attribute_span(attribute.varray);
-    io_attribute->append("data",
-                         write_blob_shared_simple_gspan(
-                             blob_writer,
-                             blob_sharing,
-                             attribute_span,
-                             attribute.varray.is_span() ? attribute.sharing_info : nullptr));
+    const ImplicitSharingInfo *sharing_info = attribute.varray.is_span() ?
+                                                  attribute.sharing_info :
+                                                  nullptr;
+    if (should_quantize_attribute(iter, blob_writer)) {
+      /* The quantized data is not deduplicated with the sharing info, because the same array may
+       * also be written unquantized, e.g. when it is shared with an attribute that is not
+       * quantized. */
+      const Array<float3> quantized_data = quantize_float3s(
+          attribute_span.typed<float3>(), blob_writer.options().quantize_precision);
+      io_attribute->append(
+          "data", write_blob_simple_gspan(blob_writer, blob_sharing, quantized_data.as_span()));
+      return;
+    }
+    io_attribute->append(
+        "data",
+        write_blob_shared_simple_gspan(blob_writer, blob_sharing, attribute_span, sharing_info));
   });
   return io_attributes;
 }
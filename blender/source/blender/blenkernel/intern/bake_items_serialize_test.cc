@@ -0,0 +1,100 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "testing/testing.h"
+
+#include "BKE_bake_items.hh"
+#include "BKE_bake_items_serialize.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_idtype.hh"
+#include "BKE_pointcloud.hh"
+
+#include "DNA_pointcloud_types.h"
+
+#include <cmath>
+#include <sstream>
+
+namespace blender::bke::bake::tests {
+
+static constexpr int points_num = 1000;
+
+static float3 point_position(const int point)
+{
+  return {float(point) * 0.1234f, float(point) * -3.7f, 1000.0f + float(point) * 0.01f};
+}
+
+class bake_items_serialize : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+TEST_F(bake_items_serialize, quantized_compressed_round_trip)
+{
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(points_num);
+  MutableSpan<float3> positions = pointcloud->positions_for_write();
+  for (const int i : positions.index_range()) {
+    positions[i] = point_position(i);
+  }
+  BakeState state;
+  state.items_by_id.add_new(
+      0, std::make_unique<GeometryBakeItem>(GeometrySet::from_pointcloud(pointcloud)));
+
+  MemoryBlobWriter blob_writer("test");
+  BlobWriteOptions options;
+  options.compress = true;
+  options.quantize_precision = 0.01f;
+  blob_writer.set_options(options);
+  std::stringstream meta;
+  {
+    BlobWriteSharing blob_sharing;
+    serialize_bake(state, blob_writer, blob_sharing, meta);
+  }
+  /* The positions have to be large enough to be compressed. */
+  EXPECT_NE(meta.str().find("zstd"), std::string::npos);
+
+  const Map<std::string, MemoryBlobWriter::OutputStream> &streams =
+      blob_writer.get_stream_by_name();
+  Array<std::string> blobs(streams.size());
+  MemoryBlobReader blob_reader;
+  int blob_index = 0;
+  for (const auto item : streams.items()) {
+    std::string &blob = blobs[blob_index++];
+    blob = item.value.stream->str();
+    blob_reader.add(item.key, Span(reinterpret_cast<const std::byte *>(blob.data()), blob.size()));
+  }
+  BlobReadSharing blob_read_sharing;
+  const std::optional<BakeState> loaded_state = deserialize_bake(
+      meta, blob_reader, blob_read_sharing);
+  ASSERT_TRUE(loaded_state.has_value());
+  const std::unique_ptr<BakeItem> *item = loaded_state->items_by_id.lookup_ptr(0);
+  ASSERT_NE(item, nullptr);
+  const auto *geometry_item = dynamic_cast<const GeometryBakeItem *>(item->get());
+  ASSERT_NE(geometry_item, nullptr);
+  const PointCloud *loaded_pointcloud = geometry_item->geometry.get_pointcloud();
+  ASSERT_NE(loaded_pointcloud, nullptr);
+  const Span<float3> loaded_positions = loaded_pointcloud->positions();
+  ASSERT_EQ(loaded_positions.size(), points_num);
+
+  /* The rounding step is the largest power of two that is not larger than the precision. */
+  const float step = 1.0f / 128.0f;
+  for (const int i : loaded_positions.index_range()) {
+    for (const int axis : IndexRange(3)) {
+      const float original = point_position(i)[axis];
+      const float loaded = loaded_positions[i][axis];
+      EXPECT_LE(std::abs(loaded - original), step / 2.0f);
+      if (std::abs(original) >= step) {
+        EXPECT_EQ(std::fmod(loaded, step), 0.0f);
+      }
+    }
+  }
+}
+
+}  // namespace blender::bke::bake::tests
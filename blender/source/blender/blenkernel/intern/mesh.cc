@@ -154,6 +154,9 @@ static void mesh_copy_data(Main *bmain,
   mesh_dst->runtime->vert_to_face_map_cache = mesh_src->runtime->vert_to_face_map_cache;
   mesh_dst->runtime->vert_to_corner_map_cache = mesh_src->runtime->vert_to_corner_map_cache;
   mesh_dst->runtime->corner_to_face_map_cache = mesh_src->runtime->corner_to_face_map_cache;
+  mesh_dst->runtime->topology_derived_data_cache = mesh_src->runtime->topology_derived_data_cache;
+  mesh_dst->runtime->positions_derived_data_cache =
+      mesh_src->runtime->positions_derived_data_cache;
   mesh_dst->runtime->bvh_cache_verts = mesh_src->runtime->bvh_cache_verts;
   mesh_dst->runtime->bvh_cache_edges = mesh_src->runtime->bvh_cache_edges;
   mesh_dst->runtime->bvh_cache_faces = mesh_src->runtime->bvh_cache_faces;
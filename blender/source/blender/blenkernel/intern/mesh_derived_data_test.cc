@@ -0,0 +1,104 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "testing/testing.h"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
+
+#include "DNA_mesh_types.h"
+
+namespace blender::bke::mesh::tests {
+
+class mesh_derived_data : public testing::Test {
+ protected:
+  Mesh *mesh_ = nullptr;
+  int computations_num_ = 0;
+
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+
+  void SetUp() override
+  {
+    mesh_ = BKE_mesh_new_nomain(3, 0, 0, 0);
+  }
+
+  void TearDown() override
+  {
+    BKE_id_free(nullptr, mesh_);
+  }
+
+  /** Returns the data for the key, which contains the number of computations so far. */
+  int lookup(const Mesh &mesh, const MeshDerivedDataDependency dependency, const StringRef key)
+  {
+    const VArray<int> data = derived_data_lookup_or_compute<int>(mesh, dependency, key, [&]() {
+      computations_num_++;
+      return Array<int>(mesh.verts_num, computations_num_);
+    });
+    EXPECT_EQ(data.size(), mesh.verts_num);
+    return data[0];
+  }
+};
+
+TEST_F(mesh_derived_data, cache_hit)
+{
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Positions, "a"), 1);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Positions, "a"), 1);
+  EXPECT_EQ(computations_num_, 1);
+
+  /* Other keys are cached separately. */
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Positions, "b"), 2);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Topology, "a"), 3);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Topology, "a"), 3);
+  EXPECT_EQ(computations_num_, 3);
+
+  /* The cache is shared with copies of the mesh. */
+  Mesh *mesh_copy = BKE_mesh_copy_for_eval(*mesh_);
+  EXPECT_EQ(this->lookup(*mesh_copy, MeshDerivedDataDependency::Positions, "a"), 1);
+  EXPECT_EQ(this->lookup(*mesh_copy, MeshDerivedDataDependency::Topology, "a"), 3);
+  EXPECT_EQ(computations_num_, 3);
+  BKE_id_free(nullptr, mesh_copy);
+}
+
+TEST_F(mesh_derived_data, positions_changed)
+{
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Positions, "a"), 1);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Topology, "a"), 2);
+
+  mesh_->tag_positions_changed();
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Positions, "a"), 3);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Topology, "a"), 2);
+
+  mesh_->tag_positions_changed_uniformly();
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Positions, "a"), 4);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Topology, "a"), 2);
+}
+
+TEST_F(mesh_derived_data, topology_changed)
+{
+  Mesh *mesh_copy = BKE_mesh_copy_for_eval(*mesh_);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Positions, "a"), 1);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Topology, "a"), 2);
+
+  mesh_->tag_topology_changed();
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Positions, "a"), 3);
+  EXPECT_EQ(this->lookup(*mesh_, MeshDerivedDataDependency::Topology, "a"), 4);
+
+  /* Tagging a mesh does not affect the cache of its copies. */
+  EXPECT_EQ(this->lookup(*mesh_copy, MeshDerivedDataDependency::Positions, "a"), 1);
+  EXPECT_EQ(this->lookup(*mesh_copy, MeshDerivedDataDependency::Topology, "a"), 2);
+  EXPECT_EQ(computations_num_, 4);
+  BKE_id_free(nullptr, mesh_copy);
+}
+
+}  // namespace blender::bke::mesh::tests
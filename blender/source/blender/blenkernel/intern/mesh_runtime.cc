@@ -232,6 +232,26 @@ void Mesh::tag_overlapping_none()
 
 namespace blender::bke {
 
+ImplicitSharingPtr<> MeshDerivedDataCache::lookup_or_compute(
+    const StringRef key, const FunctionRef<ImplicitSharingPtr<>()> compute_fn) const
+{
+  Entry *entry;
+  {
+    std::lock_guard lock{mutex_};
+    entry = entries_.lookup_or_add_cb_as(key, []() { return std::make_unique<Entry>(); }).get();
+  }
+  /* Entries are never removed while the cache is in use, so the lock is not necessary anymore.
+   * This way, computing one entry does not block computing others. */
+  entry->mutex.ensure([&]() { entry->data = compute_fn(); });
+  return entry->data;
+}
+
+void MeshDerivedDataCache::clear()
+{
+  std::lock_guard lock{mutex_};
+  entries_.clear();
+}
+
 void TrianglesCache::freeze()
 {
   this->frozen = true;
@@ -332,6 +352,8 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->corner_tris_cache.data.tag_dirty();
   mesh->runtime->corner_tri_faces_cache.tag_dirty();
   mesh->runtime->shrinkwrap_boundary_cache.tag_dirty();
+  mesh->runtime->topology_derived_data_cache.tag_dirty();
+  mesh->runtime->positions_derived_data_cache.tag_dirty();
   mesh->runtime->subsurf_face_dot_tags.clear_and_shrink();
   mesh->runtime->subsurf_optimal_display_edges.clear_and_shrink();
   mesh->flag &= ~ME_NO_OVERLAPPING_TOPOLOGY;
@@ -364,6 +386,8 @@ void Mesh::tag_edges_split()
   this->runtime->subsurf_face_dot_tags.clear_and_shrink();
   this->runtime->subsurf_optimal_display_edges.clear_and_shrink();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
+  this->runtime->topology_derived_data_cache.tag_dirty();
+  this->runtime->positions_derived_data_cache.tag_dirty();
 }
 
 void Mesh::tag_sharpness_changed()
@@ -383,6 +407,8 @@ void Mesh::tag_face_winding_changed()
   this->runtime->corner_normals_cache.tag_dirty();
   this->runtime->vert_to_corner_map_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
+  this->runtime->topology_derived_data_cache.tag_dirty();
+  this->runtime->positions_derived_data_cache.tag_dirty();
 }
 
 void Mesh::tag_positions_changed()
@@ -400,6 +426,7 @@ void Mesh::tag_positions_changed_no_normals()
   this->runtime->corner_tris_cache.tag_dirty();
   this->runtime->bounds_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
+  this->runtime->positions_derived_data_cache.tag_dirty();
 }
 
 void Mesh::tag_positions_changed_uniformly()
@@ -407,6 +434,7 @@ void Mesh::tag_positions_changed_uniformly()
   /* The normals and triangulation didn't change, since all verts moved by the same amount. */
   free_bvh_caches(*this->runtime);
   this->runtime->bounds_cache.tag_dirty();
+  this->runtime->positions_derived_data_cache.tag_dirty();
 }
 
 void Mesh::tag_topology_changed()
@@ -13,10 +13,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_bounds.hh"
 #include "BLI_convexhull_2d.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLI_strict_flags.h" /* Keep last. */
 
@@ -180,7 +183,7 @@ static int convexhull_2d_sorted(const float (*points)[2], const int points_num,
   return top + 1;
 }
 
-int BLI_convexhull_2d(const float (*points)[2], const int points_num, int r_points[])
+static int convexhull_2d_unsorted(const float (*points)[2], const int points_num, int r_points[])
 {
   BLI_assert(points_num >= 0);
   if (points_num < 2) {
@@ -235,6 +238,55 @@ int BLI_convexhull_2d(const float (*points)[2], const int points_num, int r_poin
   return points_hull_num;
 }
 
+/**
+ * Larger inputs are split into chunks of this size. Only points on the hull of a chunk can be on
+ * the hull of all points, so the hulls of the chunks are computed in parallel first, and the final
+ * hull is computed from the remaining points.
+ */
+static constexpr int convexhull_2d_chunk_size = 1 << 16;
+
+int BLI_convexhull_2d(const float (*points)[2], const int points_num, int r_points[])
+{
+  if (points_num <= convexhull_2d_chunk_size * 2) {
+    return convexhull_2d_unsorted(points, points_num, r_points);
+  }
+
+  const int chunks_num = (points_num + convexhull_2d_chunk_size - 1) / convexhull_2d_chunk_size;
+  /* The hull of every chunk is written to the start of the chunk's range in #r_points. */
+  Array<int> chunk_hull_sizes(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const int start = int(chunk) * convexhull_2d_chunk_size;
+      const int size = std::min(convexhull_2d_chunk_size, points_num - start);
+      int *chunk_r_points = r_points + start;
+      const int hull_num = convexhull_2d_unsorted(points + start, size, chunk_r_points);
+      for (int i = 0; i < hull_num; i++) {
+        chunk_r_points[i] += start;
+      }
+      chunk_hull_sizes[chunk] = hull_num;
+    }
+  });
+
+  Vector<int> candidates;
+  for (int chunk = 0; chunk < chunks_num; chunk++) {
+    const int start = chunk * convexhull_2d_chunk_size;
+    candidates.extend(Span<int>(r_points + start, chunk_hull_sizes[chunk]));
+  }
+  Array<float2> candidate_points(candidates.size());
+  for (const int64_t i : candidates.index_range()) {
+    candidate_points[i] = float2(points[candidates[i]]);
+  }
+
+  const int points_hull_num = convexhull_2d_unsorted(
+      reinterpret_cast<const float(*)[2]>(candidate_points.data()),
+      int(candidate_points.size()),
+      r_points);
+  for (int i = 0; i < points_hull_num; i++) {
+    r_points[i] = candidates[r_points[i]];
+  }
+  return points_hull_num;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
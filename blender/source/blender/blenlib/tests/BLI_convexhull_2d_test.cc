@@ -27,6 +27,7 @@
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_rand.hh"
+#include "BLI_vector.hh"
 
 using namespace blender;
 
@@ -388,6 +389,62 @@ TEST(convexhull_2d, Complex)
   }
 }
 
+/**
+ * Inputs with more than 131072 points are split into chunks whose hulls are computed separately.
+ * The result has to match the hull of a small input with the same boundary points, which is
+ * computed without chunks. Duplicate and collinear boundary points end up in different chunks.
+ */
+TEST(convexhull_2d, Chunked)
+{
+  const int points_num = 300000;
+  RandomNumberGenerator rng = RandomNumberGenerator(DEFAULT_TEST_RANDOM_SEED);
+
+  { /* Square with duplicate corners and collinear points on the edges. */
+    blender::Vector<float2> boundary;
+    const float2 corners[4] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+    for (const int corner : IndexRange(4)) {
+      const float2 &a = corners[corner];
+      const float2 &b = corners[(corner + 1) % 4];
+      for (int duplicate = 0; duplicate < 3; duplicate++) {
+        boundary.append(a);
+      }
+      for (int i = 1; i < 16; i++) {
+        boundary.append(math::interpolate(a, b, float(i) / 16.0f));
+      }
+    }
+    blender::Array<float2> points(points_num);
+    points.as_mutable_span().take_front(boundary.size()).copy_from(boundary);
+    for (float2 &p : points.as_mutable_span().drop_front(boundary.size())) {
+      p = {(rng.get_float() * 1.8f) - 0.9f, (rng.get_float() * 1.8f) - 0.9f};
+    }
+    rng.shuffle<float2>(points);
+    rng.shuffle<float2>(boundary);
+
+    const blender::Array<float2> hull = convexhull_2d_as_array(points);
+    const blender::Array<float2> hull_reference = convexhull_2d_as_array(boundary);
+    EXPECT_FALSE(hull_reference.is_empty());
+    EXPECT_EQ(hull.as_span(), hull_reference.as_span());
+  }
+
+  { /* All points on a diagonal line, so that they are exactly collinear, with duplicate ends. */
+    const float2 a = {-2.0f, -2.0f};
+    const float2 b = {3.0f, 3.0f};
+    blender::Array<float2> points(points_num);
+    for (float2 &p : points) {
+      p = float2(-2.0f + rng.get_float() * 5.0f);
+    }
+    for (const int i : IndexRange(4)) {
+      points[i] = a;
+      points[points_num - 1 - i] = b;
+    }
+    rng.shuffle<float2>(points);
+
+    const blender::Array<float2> hull = convexhull_2d_as_array(points);
+    const blender::Array<float2> hull_reference = convexhull_2d_as_array({a, b, a, b});
+    EXPECT_EQ(hull.as_span(), hull_reference.as_span());
+  }
+}
+
 /* Keep these as they're handy for generating a lot of random data.
  * To brute force check results are as expected:
  * - Increase #DEFAULT_TEST_ITER to a large number (100k or so).
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "BLI_span.hh"
+
 #include "DNA_ID.h"
 
 /* Dependency Graph */
@@ -192,6 +194,21 @@ void DEG_evaluate_on_framechange(
     float frame,
     DepsgraphEvaluateSyncWriteback sync_writeback = DEG_EVALUATE_SYNC_WRITEBACK_NO);
 
+/**
+ * Evaluate each graph at the frame with the same index, with the graphs evaluated concurrently.
+ * This is the same as calling #DEG_evaluate_on_framechange for every graph, but also gives
+ * parallelism when there are only a few heavy objects to evaluate, e.g. when baking or exporting.
+ *
+ * The graphs are independent evaluation graphs of the same original data (e.g. created with
+ * #DEG_graph_new and built the same way), which only read the original data. Because of that they
+ * are not allowed to be active and their relations must be up to date.
+ *
+ * \note Every graph only sees the frames it is evaluated at, so evaluations which keep state from
+ * one frame to the next (simulations, physics caches) are not to be evaluated this way.
+ */
+void DEG_evaluate_on_framechange_multi(blender::Span<Depsgraph *> graphs,
+                                       blender::Span<float> frames);
+
 /**
  * Data changed recalculation entry point.
  * Evaluate all nodes tagged for updating.
@@ -72,6 +72,12 @@ void DEG_graph_relations_update(Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(Main *bmain);
 
+/**
+ * Tag relations of the given ID for update. Unlike #DEG_relations_tag_update this allows the
+ * dependency graphs to only rebuild relations around the ID, when that is supported.
+ */
+void DEG_relations_tag_update_id(Main *bmain, ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
@@ -0,0 +1,204 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Incremental update of relations.
+ *
+ * Every relation remembers the IDs whose builders created it. When only some IDs are tagged for a
+ * relations update, the relations created by their builders, and by the builders of IDs which
+ * have relations to them, are removed and built again, while all nodes and all other relations
+ * of the graph are kept. Relations which are also created by builders of other IDs are kept.
+ *
+ * This only works when the set of operations of the graph does not change. Relations which can
+ * not be built because an operation is missing make the update fall back to a full rebuild.
+ */
+
+#include "intern/builder/deg_builder_incremental.h"
+
+#include "BLI_time.h"
+#include "BLI_vector.hh"
+
+#include "BKE_global.hh"
+
+#include "DNA_ID.h"
+
+#include "DEG_depsgraph.hh"
+
+#include "intern/builder/deg_builder_cache.h"
+#include "intern/builder/deg_builder_cycle.h"
+#include "intern/builder/deg_builder_relations.h"
+#include "intern/builder/deg_builder_remove_noop.h"
+#include "intern/builder/deg_builder_transitive.h"
+#include "intern/eval/deg_eval_visibility.h"
+#include "intern/node/deg_node.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+#include "intern/debug/deg_debug.h"
+#include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/depsgraph_tag.hh"
+
+namespace blender::deg {
+
+/* Whether relations of the ID can be rebuilt on their own. Scene builders only build parts of the
+ * scene at a time, and are driven by the view layer, so they can not be re-run for the scene
+ * alone. */
+static bool id_supports_incremental_relations(const IDNode *id_node)
+{
+  return id_node != nullptr && id_node->id_type != ID_SCE;
+}
+
+/* Collect IDs whose relations are to be rebuilt: the tagged IDs and the IDs whose builders
+ * created relations to or from operations of the tagged IDs. */
+static bool collect_affected_ids(Depsgraph *graph, Set<ID *> &r_ids)
+{
+  for (ID *id : graph->relations_update_ids) {
+    const IDNode *id_node = graph->find_id_node(id);
+    if (!id_supports_incremental_relations(id_node)) {
+      return false;
+    }
+    r_ids.add(id_node->id_orig);
+  }
+
+  auto add_owner = [&](const Relation *rel) {
+    for (const ID *owner_id : rel->owner_ids) {
+      if (owner_id == nullptr) {
+        continue;
+      }
+      const IDNode *owner_node = graph->find_id_node(owner_id);
+      if (!id_supports_incremental_relations(owner_node)) {
+        return false;
+      }
+      r_ids.add(owner_node->id_orig);
+    }
+    return true;
+  };
+
+  for (ID *id : graph->relations_update_ids) {
+    const IDNode *id_node = graph->find_id_node(id);
+    for (const ComponentNode *comp_node : id_node->components.values()) {
+      for (const OperationNode *op_node : comp_node->operations) {
+        for (const Relation *rel : op_node->inlinks) {
+          if (!add_owner(rel)) {
+            return false;
+          }
+        }
+        for (const Relation *rel : op_node->outlinks) {
+          if (!add_owner(rel)) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/* Remove the rebuilt IDs from the owners of all relations. Relations without any owner left are
+ * removed, the others are still needed by IDs which are not rebuilt. The builders add themselves
+ * as owners again when they create the same relation. */
+static void remove_relations_of_ids(Depsgraph *graph, const Set<ID *> &ids)
+{
+  Vector<Relation *> relations_to_remove;
+  for (OperationNode *op_node : graph->operations) {
+    for (Relation *rel : op_node->inlinks) {
+      rel->owner_ids.remove_if([&](const ID *owner_id) {
+        return owner_id != nullptr && ids.contains(const_cast<ID *>(owner_id));
+      });
+      if (rel->owner_ids.is_empty()) {
+        relations_to_remove.append(rel);
+      }
+    }
+  }
+  for (Relation *rel : relations_to_remove) {
+    rel->unlink();
+    delete rel;
+  }
+}
+
+bool deg_graph_relations_update_incremental(Depsgraph *graph)
+{
+  if (graph->relations_update_ids.is_empty() || graph->id_nodes.is_empty()) {
+    return false;
+  }
+
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = BLI_time_now_seconds();
+  }
+
+  Set<ID *> ids;
+  if (!collect_affected_ids(graph, ids)) {
+    return false;
+  }
+
+  /* Compare against the state before this update when deciding which IDs need to be re-tagged,
+   * rather than against the state before the last full build. */
+  for (IDNode *id_node : graph->id_nodes) {
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+  }
+
+  remove_relations_of_ids(graph, ids);
+
+  DepsgraphBuilderCache builder_cache;
+  DepsgraphRelationBuilder relation_builder(graph->bmain, graph, &builder_cache);
+  relation_builder.begin_build();
+  if (!relation_builder.build_id_relations(ids)) {
+    return false;
+  }
+
+  /* Same finalization steps as for the full build. Those are linear in the size of the graph,
+   * which is cheap compared to running the builders. Cycles are detected from scratch, so that
+   * relations which are not part of a cycle anymore are evaluated in order again. */
+  for (OperationNode *op_node : graph->operations) {
+    for (Relation *rel : op_node->inlinks) {
+      rel->flag &= ~RELATION_FLAG_CYCLIC;
+    }
+  }
+  deg_graph_detect_cycles(graph);
+  if (G.debug_value == 799) {
+    deg_graph_transitive_reduction(graph);
+  }
+  deg_graph_flush_visibility_flags(graph);
+  deg_graph_remove_unused_noops(graph);
+
+  for (IDNode *id_node : graph->id_nodes) {
+    id_node->finalize_build(graph);
+    int flag = 0;
+    if (id_node->eval_flags != id_node->previous_eval_flags) {
+      flag |= ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY;
+    }
+    if (id_node->customdata_masks != id_node->previous_customdata_masks) {
+      flag |= ID_RECALC_GEOMETRY;
+    }
+    if (flag != 0) {
+      graph_id_tag_update(
+          graph->bmain, graph, id_node->id_orig, flag, DEG_UPDATE_SOURCE_RELATIONS);
+    }
+  }
+  /* Re-evaluate the IDs whose dependencies changed. */
+  for (ID *id : graph->relations_update_ids) {
+    graph_id_tag_update(graph->bmain, graph, id, 0, DEG_UPDATE_SOURCE_RELATIONS);
+  }
+  /* Evaluate IDs which became visible by the new relations. */
+  DEG_graph_tag_on_visible_update(reinterpret_cast<::Depsgraph *>(graph), false);
+
+  graph->relations_update_ids.clear();
+  graph->need_update_relations = false;
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph relations of %d IDs updated in %f seconds.\n",
+           int(ids.size()),
+           BLI_time_now_seconds() - start_time);
+  }
+  return true;
+}
+
+}  // namespace blender::deg
@@ -0,0 +1,22 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+namespace blender::deg {
+
+struct Depsgraph;
+
+/* Update relations of the IDs from #Depsgraph::relations_update_ids and of the IDs whose builders
+ * created relations to them, keeping the rest of the graph as-is.
+ *
+ * Returns false if the graph could not be updated this way, in which case it is to be rebuilt
+ * from scratch. The graph might be partially updated at that point. */
+bool deg_graph_relations_update_incremental(Depsgraph *graph);
+
+}  // namespace blender::deg
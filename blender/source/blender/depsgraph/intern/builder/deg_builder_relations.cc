@@ -265,9 +265,11 @@ ComponentNode *DepsgraphRelationBuilder::get_node(const ComponentKey &key) const
 {
   IDNode *id_node = graph_->find_id_node(key.id);
   if (!id_node) {
-    fprintf(stderr,
-            "find_node component: Could not find ID %s\n",
-            (key.id != nullptr) ? key.id->name : "<null>");
+    if (report_failed_relations_) {
+      fprintf(stderr,
+              "find_node component: Could not find ID %s\n",
+              (key.id != nullptr) ? key.id->name : "<null>");
+    }
     return nullptr;
   }
 
@@ -278,7 +280,7 @@ ComponentNode *DepsgraphRelationBuilder::get_node(const ComponentKey &key) const
 OperationNode *DepsgraphRelationBuilder::get_node(const OperationKey &key) const
 {
   OperationNode *op_node = find_node(key);
-  if (op_node == nullptr) {
+  if (op_node == nullptr && report_failed_relations_) {
     fprintf(stderr,
             "find_node_operation: Failed for (%s, '%s')\n",
             operationCodeAsString(key.opcode),
@@ -368,7 +370,7 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
                                                       int flags)
 {
   if (timesrc && node_to) {
-    return graph_->add_new_relation(timesrc, node_to, description, flags);
+    return graph_->add_new_relation(timesrc, node_to, description, flags, stack_.current_id());
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -396,7 +398,8 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
                                                            int flags)
 {
   if (node_from && node_to) {
-    return graph_->add_new_relation(node_from, node_to, description, flags);
+    return graph_->add_new_relation(
+        node_from, node_to, description, flags, stack_.current_id());
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -510,6 +513,30 @@ Depsgraph *DepsgraphRelationBuilder::getGraph()
 
 void DepsgraphRelationBuilder::begin_build() {}
 
+bool DepsgraphRelationBuilder::build_id_relations(const Set<ID *> &ids)
+{
+  scene_ = graph_->scene;
+
+  /* Relations of all other IDs are kept, so do not recurse into their builders. */
+  for (IDNode *id_node : graph_->id_nodes) {
+    if (!ids.contains(id_node->id_orig)) {
+      built_map_.tagBuild(id_node->id_orig);
+    }
+  }
+
+  num_failed_relations_ = 0;
+  report_failed_relations_ = false;
+  for (ID *id : ids) {
+    build_id(id);
+  }
+  for (ID *id : ids) {
+    IDNode *id_node = graph_->find_id_node(id);
+    build_copy_on_write_relations(id_node);
+    build_driver_relations(id_node);
+  }
+  return num_failed_relations_ == 0;
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -667,11 +694,11 @@ void DepsgraphRelationBuilder::build_collection(LayerCollection *from_layer_coll
     return;
   }
 
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(collection->id);
+
   build_idproperties(collection->id.properties);
   build_parameters(&collection->id);
 
-  const BuilderStack::ScopedEntry stack_entry = stack_.trace(collection->id);
-
   const OperationKey collection_geometry_key{
       &collection->id, NodeType::GEOMETRY, OperationCode::GEOMETRY_EVAL_DONE};
 
@@ -1643,8 +1670,11 @@ void DepsgraphRelationBuilder::build_animdata_fcurve_target(
     add_relation(adt_key, pose_init_key, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
     return;
   }
-  graph_->add_new_relation(
-      operation_from, operation_to, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
+  graph_->add_new_relation(operation_from,
+                           operation_to,
+                           "Animation -> Prop",
+                           RELATION_CHECK_BEFORE_ADD,
+                           stack_.current_id());
   /* It is possible that animation is writing to a nested ID data-block,
    * need to make sure animation is evaluated after target ID is copied. */
   const IDNode *id_node_from = operation_from->owner->owner;
@@ -3392,6 +3422,7 @@ void DepsgraphRelationBuilder::build_scene_sequencer(Scene *scene)
   }
 
   /* TODO(sergey): Trace as a scene sequencer. */
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(scene->id);
 
   build_scene_audio(scene);
   ComponentKey scene_audio_key(&scene->id, NodeType::AUDIO);
@@ -3497,6 +3528,8 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
     return;
   }
 
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(*id_orig);
+
   OperationKey copy_on_write_key(id_orig, NodeType::COPY_ON_EVAL, OperationCode::COPY_ON_EVAL);
   /* XXX: This is a quick hack to make Alt-A to work. */
   // add_relation(time_source_key, copy_on_write_key, "Fluxgate capacitor hack");
@@ -3551,16 +3584,18 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * copy of ID. */
     OperationNode *op_entry = comp_node->get_entry_operation();
     if (op_entry != nullptr) {
-      Relation *rel = graph_->add_new_relation(op_cow, op_entry, "Copy-on-Eval Dependency");
+      Relation *rel = graph_->add_new_relation(
+          op_cow, op_entry, "Copy-on-Eval Dependency", 0, id_orig);
       rel->flag |= rel_flag;
     }
     /* All dangling operations should also be executed after copy-on-evaluation. */
-    for (OperationNode *op_node : comp_node->operations_map->values()) {
+    auto build_dangling_operation_relation = [&](OperationNode *op_node) {
       if (op_node == op_entry) {
-        continue;
+        return;
       }
       if (op_node->inlinks.is_empty()) {
-        Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
+        Relation *rel = graph_->add_new_relation(
+            op_cow, op_node, "Copy-on-Eval Dependency", 0, id_orig);
         rel->flag |= rel_flag;
       }
       else {
@@ -3576,10 +3611,23 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
           }
         }
         if (!has_same_comp_dependency) {
-          Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
+          Relation *rel = graph_->add_new_relation(
+              op_cow, op_node, "Copy-on-Eval Dependency", 0, id_orig);
           rel->flag |= rel_flag;
         }
       }
+    };
+    /* The operations map is freed when the graph is finalized, which is already the case when
+     * relations are updated incrementally. */
+    if (comp_node->operations_map != nullptr) {
+      for (OperationNode *op_node : comp_node->operations_map->values()) {
+        build_dangling_operation_relation(op_node);
+      }
+    }
+    else {
+      for (OperationNode *op_node : comp_node->operations) {
+        build_dangling_operation_relation(op_node);
+      }
     }
     /* NOTE: We currently ignore implicit relations to an external
      * data-blocks for copy-on-evaluation operations. This means, for example,
@@ -89,6 +89,12 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   void begin_build();
 
+  /* Rebuild relations created by builders of the given IDs, keeping all other relations as well
+   * as all nodes of the graph. The relations built for those IDs are expected to be removed
+   * already. Returns false if not all relations could be built, for example because the IDs need
+   * operations which do not exist in the graph. */
+  bool build_id_relations(const Set<ID *> &ids);
+
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
                          const KeyTo &key_to,
@@ -348,6 +354,12 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   BuilderMap built_map_;
   RNANodeQuery rna_node_query_;
   BuilderStack stack_;
+
+  /* Number of relations which could not be added because one of their nodes does not exist. */
+  int num_failed_relations_ = 0;
+  /* Print relations which could not be added. Failures are expected when relations are updated
+   * incrementally, those make the update fall back to a full rebuild. */
+  bool report_failed_relations_ = true;
 };
 
 struct DepsNodeHandle {
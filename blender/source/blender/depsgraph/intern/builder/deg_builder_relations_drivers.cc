@@ -163,6 +163,8 @@ void DepsgraphRelationBuilder::build_driver_relations(IDNode *id_node)
     return;
   }
 
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(*id_orig);
+
   /* Mapping from RNA prefix -> set of driver descriptors: */
   Map<string, Vector<DriverDescriptor>> driver_groups;
 
@@ -42,6 +42,11 @@ Relation *DepsgraphRelationBuilder::add_relation(const KeyFrom &key_from,
 
   /* TODO(sergey): Report error in the interface. */
 
+  num_failed_relations_++;
+  if (!report_failed_relations_) {
+    return nullptr;
+  }
+
   std::cerr << "--------------------------------------------------------------------\n";
   std::cerr << "Failed to add relation \"" << description << "\"\n";
 
@@ -90,6 +95,10 @@ Relation *DepsgraphRelationBuilder::add_node_handle_relation(const KeyType &key_
     return add_operation_relation(op_from, op_to, description, flags);
   }
   else {
+    num_failed_relations_++;
+    if (!report_failed_relations_) {
+      return nullptr;
+    }
     if (!op_from) {
       fprintf(stderr,
               "add_node_handle_relation(%s) - Could not find op_from (%s)\n",
@@ -51,6 +51,7 @@ void DepsgraphRelationBuilder::build_scene_parameters(Scene *scene)
   }
 
   /* TODO(sergey): Trace as a scene parameters. */
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(scene->id);
 
   build_idproperties(scene->id.properties);
   build_parameters(&scene->id);
@@ -74,6 +75,7 @@ void DepsgraphRelationBuilder::build_scene_compositor(Scene *scene)
   }
 
   /* TODO(sergey): Trace as a scene compositor. */
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(scene->id);
 
   build_nodetree(scene->nodetree);
 }
@@ -174,7 +174,8 @@ void Depsgraph::clear_id_nodes()
   light_linking_cache.clear();
 }
 
-Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *description, int flags)
+Relation *Depsgraph::add_new_relation(
+    Node *from, Node *to, const char *description, int flags, const ID *owner_id)
 {
   Relation *rel = nullptr;
   if (flags & RELATION_CHECK_BEFORE_ADD) {
@@ -182,6 +183,9 @@ Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *descript
   }
   if (rel != nullptr) {
     rel->flag |= flags;
+    /* The relation may be needed by builders of different IDs, it is only removed when all of
+     * them are rebuilt. */
+    rel->owner_ids.append_non_duplicates(owner_id);
     return rel;
   }
 
@@ -197,6 +201,7 @@ Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *descript
   /* Create new relation, and add it to the graph. */
   rel = new Relation(from, to, description);
   rel->flag |= flags;
+  rel->owner_ids.append(owner_id);
   return rel;
 }
 
@@ -60,7 +60,11 @@ struct Depsgraph {
   void clear_id_nodes();
 
   /** Add new relationship between two nodes. */
-  Relation *add_new_relation(Node *from, Node *to, const char *description, int flags = 0);
+  Relation *add_new_relation(Node *from,
+                             Node *to,
+                             const char *description,
+                             int flags = 0,
+                             const ID *owner_id = nullptr);
 
   /* Check whether two nodes are connected by relation with given
    * description. Description might be nullptr to check ANY relation between
@@ -98,6 +102,11 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update_relations;
 
+  /* Original IDs which only need their own relations to be updated, see
+   * #DEG_relations_tag_update_id. When relations need to be updated and this set is empty, the
+   * whole graph is rebuilt. */
+  Set<ID *> relations_update_ids;
+
   /* Indicates whether indirect effect of nodes on a directly visible ones needs to be updated. */
   bool need_update_nodes_visibility;
 
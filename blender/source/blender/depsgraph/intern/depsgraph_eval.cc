@@ -11,8 +11,10 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
+#include "BKE_global.hh"
 #include "BKE_scene.hh"
 
 #include "DNA_object_types.h"
@@ -92,3 +94,34 @@ void DEG_evaluate_on_framechange(Depsgraph *graph,
   deg_graph->ctime = BKE_scene_frame_to_ctime(scene, frame);
   deg_flush_updates_and_refresh(deg_graph, sync_writeback);
 }
+
+void DEG_evaluate_on_framechange_multi(const blender::Span<Depsgraph *> graphs,
+                                       const blender::Span<float> frames)
+{
+  BLI_assert(graphs.size() == frames.size());
+
+  auto evaluate_graph = [&](const int64_t i) {
+    const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graphs[i]);
+    UNUSED_VARS_NDEBUG(deg_graph);
+    BLI_assert(!deg_graph->is_active);
+    BLI_assert(!deg_graph->need_update_relations);
+    DEG_evaluate_on_framechange(graphs[i], frames[i]);
+  };
+
+  if (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) {
+    for (const int64_t i : graphs.index_range()) {
+      evaluate_graph(i);
+    }
+    return;
+  }
+
+  /* Every graph evaluates its operations in parallel as well, so a single graph per task is
+   * enough to keep all threads busy. */
+  blender::threading::parallel_for(graphs.index_range(), 1, [&](const blender::IndexRange range) {
+    for (const int64_t i : range) {
+      /* Don't let the graph pick up tasks of other graphs while waiting for its own operations,
+       * since those could wait for locks held by the operations of this graph. */
+      blender::threading::isolate_task([&]() { evaluate_graph(i); });
+    }
+  });
+}
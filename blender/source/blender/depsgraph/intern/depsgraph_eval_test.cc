@@ -0,0 +1,108 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "tests/blendfile_loading_base_test.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_collection.hh"
+#include "BKE_layer.hh"
+#include "BKE_main.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
+#include "BKE_modifier.hh"
+#include "BKE_object.hh"
+#include "BKE_scene.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_query.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "GEO_mesh_primitive_grid.hh"
+
+namespace blender::deg::tests {
+
+class depsgraph_eval_multi : public BlendfileLoadingBaseTest {
+ protected:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  ViewLayer *view_layer = nullptr;
+  Object *object = nullptr;
+
+  void SetUp() override
+  {
+    BlendfileLoadingBaseTest::SetUp();
+
+    /* A grid with a wave modifier, so that the evaluated positions depend on the frame. */
+    bmain = BKE_main_new();
+    scene = BKE_scene_add(bmain, "Scene");
+    view_layer = BKE_view_layer_default_view(scene);
+
+    Mesh *mesh = BKE_mesh_add(bmain, "Grid");
+    Mesh *grid = geometry::create_grid_mesh(16, 16, 2.0f, 2.0f, std::nullopt);
+    object = BKE_object_add_only_object(bmain, OB_MESH, "Grid");
+    object->data = mesh;
+    BKE_mesh_nomain_to_mesh(grid, mesh, object);
+    BLI_addtail(&object->modifiers, BKE_modifier_new(eModifierType_Wave));
+    BKE_collection_object_add(bmain, scene->master_collection, object);
+    BKE_view_layer_synced_ensure(scene, view_layer);
+  }
+
+  void TearDown() override
+  {
+    BKE_main_free(bmain);
+    BlendfileLoadingBaseTest::TearDown();
+  }
+
+  Depsgraph *graph_create()
+  {
+    Depsgraph *graph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+    DEG_graph_build_from_view_layer(graph);
+    return graph;
+  }
+
+  Array<float3> evaluated_positions(const Depsgraph *graph)
+  {
+    const Object *object_eval = DEG_get_evaluated_object(graph, object);
+    const Mesh *mesh_eval = BKE_object_get_evaluated_mesh(object_eval);
+    return Array<float3>(mesh_eval->vert_positions());
+  }
+};
+
+TEST_F(depsgraph_eval_multi, matches_sequential_evaluation)
+{
+  const Array<float> frames = {3.0f, 11.0f};
+
+  Depsgraph *sequential_graph = graph_create();
+  Array<Array<float3>> expected_positions(frames.size());
+  for (const int i : frames.index_range()) {
+    DEG_evaluate_on_framechange(sequential_graph, frames[i]);
+    expected_positions[i] = evaluated_positions(sequential_graph);
+  }
+  DEG_graph_free(sequential_graph);
+  /* Make sure the frames give different results, otherwise the test does not check anything. */
+  EXPECT_NE(expected_positions[0].as_span(), expected_positions[1].as_span());
+
+  Array<Depsgraph *> graphs(frames.size());
+  for (const int i : frames.index_range()) {
+    graphs[i] = graph_create();
+  }
+  DEG_evaluate_on_framechange_multi(graphs, frames);
+  for (const int i : frames.index_range()) {
+    EXPECT_EQ(evaluated_positions(graphs[i]).as_span(), expected_positions[i].as_span());
+    DEG_graph_free(graphs[i]);
+  }
+}
+
+}  // namespace blender::deg::tests
@@ -10,6 +10,10 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_vector.hh"
+
+struct ID;
+
 namespace blender::deg {
 
 struct Node;
@@ -48,6 +52,12 @@ struct Relation {
   const char *name; /* label for debugging */
   int flag;         /* Bitmask of RelationFlag) */
 
+  /* Original IDs whose relations builders created this relation. Several builders can add the
+   * same relation. A nullptr entry means that the relation was created outside of any ID builder.
+   * Used to only rebuild relations of specific IDs on incremental relations update: the relation
+   * is removed when all of its owners are rebuilt. */
+  Vector<const ID *, 1> owner_ids;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Relation");
 };
 
@@ -147,6 +147,7 @@ void depsgraph_tag_to_component_opcode(const ID *id,
   }
   switch (tag) {
     case ID_RECALC_TRANSFORM:
+    case ID_RECALC_TRANSFORM_CHANNELS:
       *component_type = NodeType::TRANSFORM;
       break;
     case ID_RECALC_GEOMETRY:
@@ -176,6 +177,7 @@ void depsgraph_tag_to_component_opcode(const ID *id,
       *component_type = NodeType::COPY_ON_EVAL;
       break;
     case ID_RECALC_SHADING:
+    case ID_RECALC_SHADING_PARAMETERS:
       *component_type = NodeType::SHADING;
       break;
     case ID_RECALC_SELECT:
@@ -260,13 +262,25 @@ void depsgraph_update_editors_tag(Main *bmain, Depsgraph *graph, ID *id)
   deg_editors_id_update(&update_ctx, id);
 }
 
-void depsgraph_id_tag_copy_on_write(Depsgraph *graph, IDNode *id_node, eUpdateSource update_source)
+/* Tag the copy-on-evaluation component of the ID for update, because of the given tag.
+ * Unless the tag only requires part of the data-block to be synchronized, the evaluated copy will
+ * be copied from the original again. */
+void depsgraph_id_tag_copy_on_write(Depsgraph *graph,
+                                    IDNode *id_node,
+                                    eUpdateSource update_source,
+                                    const IDRecalcFlag tag)
 {
   ComponentNode *cow_comp = id_node->find_component(NodeType::COPY_ON_EVAL);
   if (cow_comp == nullptr) {
     BLI_assert(!deg_eval_copy_is_needed(GS(id_node->id_orig->name)));
     return;
   }
+  if (deg_eval_copy_is_sync_tag(tag)) {
+    id_node->eval_copy_sync_tags |= tag;
+  }
+  else {
+    id_node->is_cow_full_copy_tagged = true;
+  }
   cow_comp->tag_update(graph, update_source);
 }
 
@@ -274,6 +288,7 @@ void depsgraph_tag_component(Depsgraph *graph,
                              IDNode *id_node,
                              NodeType component_type,
                              OperationCode operation_code,
+                             const IDRecalcFlag tag,
                              eUpdateSource update_source)
 {
   ComponentNode *component_node = id_node->find_component(component_type);
@@ -283,7 +298,7 @@ void depsgraph_tag_component(Depsgraph *graph,
   if (component_node == nullptr) {
     if (component_type == NodeType::ANIMATION) {
       id_node->is_cow_explicitly_tagged = true;
-      depsgraph_id_tag_copy_on_write(graph, id_node, update_source);
+      depsgraph_id_tag_copy_on_write(graph, id_node, update_source, tag);
     }
     return;
   }
@@ -298,7 +313,7 @@ void depsgraph_tag_component(Depsgraph *graph,
   }
   /* If component depends on copy-on-evaluation, tag it as well. */
   if (component_node->need_tag_cow_before_update(IDRecalcFlag(id_node->id_cow->recalc))) {
-    depsgraph_id_tag_copy_on_write(graph, id_node, update_source);
+    depsgraph_id_tag_copy_on_write(graph, id_node, update_source, tag);
   }
   if (component_type == NodeType::COPY_ON_EVAL) {
     id_node->is_cow_explicitly_tagged = true;
@@ -400,7 +415,7 @@ void graph_id_tag_update_single_flag(Main *bmain,
     id_node->tag_update(graph, update_source);
   }
   else {
-    depsgraph_tag_component(graph, id_node, component_type, operation_code, update_source);
+    depsgraph_tag_component(graph, id_node, component_type, operation_code, tag, update_source);
   }
   /* TODO(sergey): Get rid of this once all areas are using proper data ID
    * for tagging. */
@@ -534,7 +549,9 @@ void deg_graph_tag_parameters_if_needed(Main *bmain,
   /* Clear flags which are known to not affect parameters usable by drivers. */
   const uint clean_flags = flags &
                            ~(ID_RECALC_SYNC_TO_EVAL | ID_RECALC_SELECT | ID_RECALC_BASE_FLAGS |
-                             ID_RECALC_SHADING |
+                             ID_RECALC_SHADING | ID_RECALC_SHADING_PARAMETERS |
+                             /* Drivers using transform channels depend on the transform. */
+                             ID_RECALC_TRANSFORM_CHANNELS |
                              /* While drivers may use the current-frame, this value is assigned
                               * explicitly and doesn't require a the scene to be copied again. */
                              ID_RECALC_FRAME_CHANGE);
@@ -758,6 +775,8 @@ const char *DEG_update_tag_as_string(IDRecalcFlag flag)
   switch (flag) {
     case ID_RECALC_TRANSFORM:
       return "TRANSFORM";
+    case ID_RECALC_TRANSFORM_CHANNELS:
+      return "TRANSFORM_CHANNELS";
     case ID_RECALC_GEOMETRY:
       return "GEOMETRY";
     case ID_RECALC_GEOMETRY_ALL_MODES:
@@ -778,6 +797,8 @@ const char *DEG_update_tag_as_string(IDRecalcFlag flag)
       return "COPY_ON_EVAL";
     case ID_RECALC_SHADING:
       return "SHADING";
+    case ID_RECALC_SHADING_PARAMETERS:
+      return "SHADING_PARAMETERS";
     case ID_RECALC_SELECT:
       return "SELECT";
     case ID_RECALC_BASE_FLAGS:
@@ -963,6 +984,8 @@ void DEG_ids_clear_recalc(Depsgraph *depsgraph, const bool backup)
      * the recalc flag. */
     id_node->is_user_modified = false;
     id_node->is_cow_explicitly_tagged = false;
+    id_node->is_cow_full_copy_tagged = false;
+    id_node->eval_copy_sync_tags = 0;
     deg_graph_clear_id_recalc_flags(id_node->id_cow);
     if (deg_graph->is_active) {
       deg_graph_clear_id_recalc_flags(id_node->id_orig);
@@ -10,18 +10,22 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 
 #include "DNA_node_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_query.hh"
@@ -53,6 +57,8 @@ struct DepsgraphEvalState;
 
 void deg_task_run_func(TaskPool *pool, void *taskdata);
 
+void sort_by_critical_path(MutableSpan<OperationNode *> nodes);
+
 void schedule_children(DepsgraphEvalState *state,
                        OperationNode *node,
                        FunctionRef<void(OperationNode *node)> schedule_fn);
@@ -80,6 +86,9 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Run ready operations with the longest chain of dependent operations first, rather than in
+   * the order they became ready. See #calculate_critical_path_times. */
+  bool use_critical_path;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
@@ -92,7 +101,7 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_stats || state->use_critical_path) {
     const double start_time = BLI_time_now_seconds();
     operation_node->evaluate(depsgraph);
     operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
@@ -113,14 +122,40 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+  if (!state->use_critical_path) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
+
+    /* Schedule children. */
+    schedule_children(state, operation_node, [&](OperationNode *node) {
+      BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    });
+    return;
+  }
+
+  /* Keep evaluating the most critical child which became ready in this thread, without going
+   * through the task pool. Other ready children are pushed to the pool, most critical first. */
+  Vector<OperationNode *, 16> ready_children;
+  while (operation_node != nullptr) {
+    evaluate_node(state, operation_node);
+
+    ready_children.clear();
+    schedule_children(
+        state, operation_node, [&](OperationNode *node) { ready_children.append(node); });
+    sort_by_critical_path(ready_children);
+
+    operation_node = nullptr;
+    for (OperationNode *node : ready_children) {
+      if (operation_node == nullptr) {
+        operation_node = node;
+      }
+      else {
+        BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+      }
+    }
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -189,13 +224,85 @@ void calculate_pending_parents_if_needed(DepsgraphEvalState *state)
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   /* Clear tags and other things which needs to be clear. */
-  if (state->do_stats) {
+  if (state->do_stats || state->use_critical_path) {
     for (OperationNode *node : graph->operations) {
       node->stats.reset_current();
     }
   }
 }
 
+/* Time assumed for every operation on top of its measured time. Makes chains with more operations
+ * more critical when there are no timings yet, and accounts for the scheduling overhead. */
+constexpr double OPERATION_BASE_TIME = 1e-6;
+
+enum {
+  CRITICAL_PATH_NOT_VISITED = 0,
+  CRITICAL_PATH_VISITING = 1,
+  CRITICAL_PATH_VISITED = 2,
+};
+
+/* Calculate #OperationNode::critical_path_time for all operations which are to be evaluated: the
+ * averaged time of the operation plus the longest critical path time of the operations depending
+ * on it. Uses a depth-first traversal, so that children are handled before their parents. */
+void calculate_critical_path_times(Depsgraph *graph)
+{
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = CRITICAL_PATH_NOT_VISITED;
+  }
+
+  auto child_to_follow = [](const Relation *rel) -> OperationNode * {
+    if (rel->flag & RELATION_FLAG_CYCLIC) {
+      return nullptr;
+    }
+    OperationNode *child = reinterpret_cast<OperationNode *>(rel->to);
+    if ((child->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0) {
+      return nullptr;
+    }
+    return child;
+  };
+
+  /* Operation and the index of its next outgoing relation to visit. */
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->custom_flags != CRITICAL_PATH_NOT_VISITED ||
+        (root->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0)
+    {
+      continue;
+    }
+    root->custom_flags = CRITICAL_PATH_VISITING;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      auto &[node, link_index] = stack.last();
+      if (link_index < node->outlinks.size()) {
+        OperationNode *child = child_to_follow(node->outlinks[link_index++]);
+        if (child != nullptr && child->custom_flags == CRITICAL_PATH_NOT_VISITED) {
+          child->custom_flags = CRITICAL_PATH_VISITING;
+          stack.append({child, 0});
+        }
+        continue;
+      }
+      double children_time = 0.0;
+      for (const Relation *rel : node->outlinks) {
+        const OperationNode *child = child_to_follow(rel);
+        /* Children which are still being visited form a cycle which is not tagged as such. */
+        if (child != nullptr && child->custom_flags == CRITICAL_PATH_VISITED) {
+          children_time = std::max(children_time, child->critical_path_time);
+        }
+      }
+      node->critical_path_time = OPERATION_BASE_TIME + node->stats.average_time + children_time;
+      node->custom_flags = CRITICAL_PATH_VISITED;
+      stack.pop_last();
+    }
+  }
+}
+
+void sort_by_critical_path(MutableSpan<OperationNode *> nodes)
+{
+  std::stable_sort(nodes.begin(), nodes.end(), [](const OperationNode *a, const OperationNode *b) {
+    return a->critical_path_time > b->critical_path_time;
+  });
+}
+
 bool is_metaball_object_operation(const OperationNode *operation_node)
 {
   const ComponentNode *component_node = operation_node->owner;
@@ -317,9 +424,19 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
-    BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  if (state->use_critical_path) {
+    Vector<OperationNode *> ready_nodes;
+    schedule_graph(state, [&](OperationNode *node) { ready_nodes.append(node); });
+    sort_by_critical_path(ready_nodes);
+    for (OperationNode *node : ready_nodes) {
+      BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
+    }
+  }
+  else {
+    schedule_graph(state, [&](OperationNode *node) {
+      BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
+    });
+  }
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -402,9 +519,14 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.use_critical_path = USER_EXPERIMENTAL_TEST(&U, use_depsgraph_critical_path_scheduling) &&
+                            !(G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS);
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
+  if (state.use_critical_path) {
+    calculate_critical_path_times(graph);
+  }
 
   /* Evaluation happens in several incremental steps:
    *
@@ -456,6 +578,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.use_critical_path) {
+    deg_eval_stats_update_average(graph);
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
@@ -21,6 +21,7 @@
 #include <cstring>
 
 #include "BLI_listbase.h"
+#include "BLI_math_vector.h"
 #include "BLI_string.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
@@ -44,6 +45,7 @@
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
 #include "DNA_gpencil_legacy_types.h"
+#include "DNA_material_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
@@ -844,6 +846,79 @@ ID *deg_expand_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
   return id_cow;
 }
 
+void sync_object_transform_channels(const Object *object_orig, Object *object_cow)
+{
+  copy_v3_v3(object_cow->loc, object_orig->loc);
+  copy_v3_v3(object_cow->dloc, object_orig->dloc);
+  copy_v3_v3(object_cow->scale, object_orig->scale);
+  copy_v3_v3(object_cow->dscale, object_orig->dscale);
+  copy_v3_v3(object_cow->rot, object_orig->rot);
+  copy_v3_v3(object_cow->drot, object_orig->drot);
+  copy_v4_v4(object_cow->quat, object_orig->quat);
+  copy_v4_v4(object_cow->dquat, object_orig->dquat);
+  copy_v3_v3(object_cow->rotAxis, object_orig->rotAxis);
+  copy_v3_v3(object_cow->drotAxis, object_orig->drotAxis);
+  object_cow->rotAngle = object_orig->rotAngle;
+  object_cow->drotAngle = object_orig->drotAngle;
+  object_cow->rotmode = object_orig->rotmode;
+  object_cow->protectflag = object_orig->protectflag;
+}
+
+void sync_material_parameters(const Material *material_orig, Material *material_cow)
+{
+  material_cow->flag = material_orig->flag;
+  material_cow->surface_render_method = material_orig->surface_render_method;
+  material_cow->r = material_orig->r;
+  material_cow->g = material_orig->g;
+  material_cow->b = material_orig->b;
+  material_cow->a = material_orig->a;
+  material_cow->specr = material_orig->specr;
+  material_cow->specg = material_orig->specg;
+  material_cow->specb = material_orig->specb;
+  material_cow->spec = material_orig->spec;
+  material_cow->roughness = material_orig->roughness;
+  material_cow->metallic = material_orig->metallic;
+  material_cow->index = material_orig->index;
+  copy_v4_v4(material_cow->line_col, material_orig->line_col);
+  material_cow->line_priority = material_orig->line_priority;
+  material_cow->displacement_method = material_orig->displacement_method;
+  material_cow->thickness_mode = material_orig->thickness_mode;
+  material_cow->alpha_threshold = material_orig->alpha_threshold;
+  material_cow->refract_depth = material_orig->refract_depth;
+  material_cow->blend_method = material_orig->blend_method;
+  material_cow->blend_shadow = material_orig->blend_shadow;
+  material_cow->blend_flag = material_orig->blend_flag;
+  material_cow->volume_intersection_method = material_orig->volume_intersection_method;
+  material_cow->inflate_bounds = material_orig->inflate_bounds;
+}
+
+/* Synchronize the parts of the original data-block covered by the given sync tags to its
+ * evaluated copy, which is otherwise kept as-is, including its runtime data.
+ *
+ * Returns false if the tags are not supported for the data-block type, in which case a full copy
+ * is needed. */
+bool sync_eval_copy_datablock(const ID *id_orig, ID *id_cow, const uint32_t sync_tags)
+{
+  switch (GS(id_orig->name)) {
+    case ID_OB:
+      if (sync_tags != ID_RECALC_TRANSFORM_CHANNELS) {
+        return false;
+      }
+      sync_object_transform_channels(reinterpret_cast<const Object *>(id_orig),
+                                     reinterpret_cast<Object *>(id_cow));
+      return true;
+    case ID_MA:
+      if (sync_tags != ID_RECALC_SHADING_PARAMETERS) {
+        return false;
+      }
+      sync_material_parameters(reinterpret_cast<const Material *>(id_orig),
+                               reinterpret_cast<Material *>(id_cow));
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace
 
 ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_node)
@@ -879,6 +954,16 @@ ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
     }
   }
 
+  /* Avoid copying the whole data-block when only some of its data changed, e.g. when moving an
+   * object or changing the viewport color of a material. */
+  if (check_datablock_expanded(id_cow) && !id_node->is_cow_explicitly_tagged &&
+      !id_node->is_cow_full_copy_tagged && id_node->eval_copy_sync_tags != 0)
+  {
+    if (sync_eval_copy_datablock(id_orig, id_cow, id_node->eval_copy_sync_tags)) {
+      return id_cow;
+    }
+  }
+
   RuntimeBackup backup(depsgraph);
   backup.init_from_id(id_cow);
   deg_free_eval_copy_datablock(id_cow);
@@ -1057,4 +1142,9 @@ bool deg_eval_copy_is_needed(const ID_Type id_type)
   return ID_TYPE_USE_COPY_ON_EVAL(id_type);
 }
 
+bool deg_eval_copy_is_sync_tag(const IDRecalcFlag tag)
+{
+  return ELEM(tag, ID_RECALC_TRANSFORM_CHANNELS, ID_RECALC_SHADING_PARAMETERS);
+}
+
 }  // namespace blender::deg
@@ -77,4 +77,10 @@ bool deg_eval_copy_is_expanded(const struct ID *id_cow);
 bool deg_eval_copy_is_needed(const ID *id_orig);
 bool deg_eval_copy_is_needed(const ID_Type id_type);
 
+/**
+ * Check whether the tag only requires part of the original data-block to be synchronized to its
+ * evaluated copy, instead of copying the whole data-block again.
+ */
+bool deg_eval_copy_is_sync_tag(const IDRecalcFlag tag);
+
 }  // namespace blender::deg
@@ -39,4 +39,25 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_update_average(Depsgraph *graph)
+{
+  /* Weight of the current evaluation in the averaged timing. Fairly high, so that the estimate
+   * follows changes in the scene quickly, while still smoothing out timing noise. */
+  const double current_weight = 0.25;
+  for (OperationNode *op_node : graph->operations) {
+    Node::Stats &stats = op_node->stats;
+    /* Operation was not evaluated this time. */
+    if (stats.current_time == 0.0) {
+      continue;
+    }
+    if (stats.average_time == 0.0) {
+      stats.average_time = stats.current_time;
+    }
+    else {
+      stats.average_time = stats.average_time * (1.0 - current_weight) +
+                           stats.current_time * current_weight;
+    }
+  }
+}
+
 }  // namespace blender::deg
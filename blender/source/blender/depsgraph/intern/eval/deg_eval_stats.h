@@ -15,4 +15,8 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Fold timings of the operations evaluated in the current evaluation into their averaged
+ * timings, which are used to estimate the cost of the next evaluation. */
+void deg_eval_stats_update_average(Depsgraph *graph);
+
 }  // namespace blender::deg
@@ -121,6 +121,14 @@ struct IDNode : public Node {
   /* Copy-on-Write component has been explicitly tagged for update. */
   bool is_cow_explicitly_tagged;
 
+  /* Copy-on-Write component has been tagged for update by a tag which requires the whole
+   * data-block to be copied again. */
+  bool is_cow_full_copy_tagged;
+
+  /* Tags for which only part of the original data-block is to be synchronized to the evaluated
+   * copy. Only used when the evaluated copy is not to be fully copied anyway. */
+  uint32_t eval_copy_sync_tags;
+
   /* Accumulate recalc flags from multiple update passes. */
   int id_cow_recalc_backup;
 
@@ -214,8 +214,22 @@ struct NodeBakeRequest {
   int frame_start;
   int frame_end;
   std::unique_ptr<bake::BlobWriteSharing> blob_sharing;
+  bake::BlobWriteOptions blob_write_options;
 };
 
+static bake::BlobWriteOptions get_blob_write_options(const NodesModifierData &nmd,
+                                                     const int bake_id)
+{
+  bake::BlobWriteOptions options;
+  if (const NodesModifierBake *bake = nmd.find_bake(bake_id)) {
+    if (bake->flag & NODES_MODIFIER_BAKE_COMPRESS) {
+      options.compress = true;
+      options.quantize_precision = bake->quantize_precision;
+    }
+  }
+  return options;
+}
+
 struct BakeGeometryNodesJob {
   wmWindowManager *wm;
   Main *bmain;
@@ -323,6 +337,7 @@ static void bake_geometry_nodes_startjob(void *customdata, wmJobWorkerStatus *wo
                       (frame_file_name + ".json").c_str());
         BLI_file_ensure_parent_dir_exists(meta_path);
         bake::DiskBlobWriter blob_writer{request.path->blobs_dir, frame_file_name};
+        blob_writer.set_options(request.blob_write_options);
         fstream meta_file{meta_path, std::ios::out};
         bake::serialize_bake(frame_cache.state, blob_writer, *request.blob_sharing, meta_file);
         written_size += blob_writer.written_size();
@@ -332,6 +347,7 @@ static void bake_geometry_nodes_startjob(void *customdata, wmJobWorkerStatus *wo
         PackedBake &packed_data = packed_data_by_bake.lookup_or_add_default(&request);
 
         bake::MemoryBlobWriter blob_writer{frame_file_name};
+        blob_writer.set_options(request.blob_write_options);
         std::ostringstream meta_file{std::ios::binary};
         bake::serialize_bake(frame_cache.state, blob_writer, *request.blob_sharing, meta_file);
 
@@ -621,6 +637,7 @@ static Vector<NodeBakeRequest> collect_simulations_to_bake(Main &bmain,
         request.bake_id = id;
         request.node_type = node->type_legacy;
         request.blob_sharing = std::make_unique<bake::BlobWriteSharing>();
+        request.blob_write_options = get_blob_write_options(*nmd, id);
         if (bake::get_node_bake_target(*object, *nmd, id) == NODES_MODIFIER_BAKE_TARGET_DISK) {
           request.path = bake::get_node_bake_path(bmain, *object, *nmd, id);
         }
@@ -945,6 +962,7 @@ static Vector<NodeBakeRequest> bake_single_node_gather_bake_request(bContext *C,
   request.bake_id = bake_id;
   request.node_type = node->type_legacy;
   request.blob_sharing = std::make_unique<bake::BlobWriteSharing>();
+  request.blob_write_options = get_blob_write_options(nmd, bake_id);
 
   const NodesModifierBake *bake = nmd.find_bake(bake_id);
   if (!bake) {
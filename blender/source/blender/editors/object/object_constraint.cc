@@ -1355,8 +1355,13 @@ void constraint_dependency_update(Main *bmain, Object *ob)
 
   if (ob->pose) {
     object_pose_tag_update(bmain, ob);
+    /* Pose constraints can change which operations exist (e.g. IK solvers), which requires a
+     * full rebuild. */
+    DEG_relations_tag_update(bmain);
+  }
+  else {
+    DEG_relations_tag_update_id(bmain, &ob->id);
   }
-  DEG_relations_tag_update(bmain);
 }
 
 void constraint_tag_update(Main *bmain, Object *ob, bConstraint *con)
@@ -1388,8 +1393,13 @@ void constraint_dependency_tag_update(Main *bmain, Object *ob, bConstraint *con)
 
   if (ob->pose) {
     object_pose_tag_update(bmain, ob);
+    /* Pose constraints can change which operations exist (e.g. IK solvers), which requires a
+     * full rebuild. */
+    DEG_relations_tag_update(bmain);
+  }
+  else {
+    DEG_relations_tag_update_id(bmain, &ob->id);
   }
-  DEG_relations_tag_update(bmain);
 }
 
 bool constraint_move_to_index(Object *ob, bConstraint *con, const int index)
@@ -29,7 +29,10 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_bitmap.h"
+#include "BLI_fileops.hh"
 #include "BLI_listbase.h"
+#include "BLI_path_utils.hh"
+#include "BLI_serialize.hh"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
@@ -94,6 +97,10 @@
 
 #include "GEO_merge_layers.hh"
 
+#include "MOD_nodes.hh"
+
+#include "NOD_geometry_nodes_log.hh"
+
 #include "UI_interface.hh"
 
 #include "WM_api.hh"
@@ -3765,6 +3772,104 @@ void OBJECT_OT_geometry_nodes_input_attribute_toggle(wmOperatorType *ot)
 
 /** \} */
 
+/* ------------------------------------------------------------------- */
+/** \name Export Geometry Nodes Timeline Operator
+ * \{ */
+
+static NodesModifierData *timeline_export_modifier_get(bContext *C, wmOperator *op)
+{
+  Object *ob = context_active_object(C);
+  if (ob == nullptr) {
+    return nullptr;
+  }
+  char modifier_name[MAX_NAME];
+  RNA_string_get(op->ptr, "modifier_name", modifier_name);
+  ModifierData *md = BKE_modifiers_findby_name(ob, modifier_name);
+  if (md == nullptr || md->type != eModifierType_Nodes) {
+    return nullptr;
+  }
+  return reinterpret_cast<NodesModifierData *>(md);
+}
+
+static int geometry_nodes_timeline_export_exec(bContext *C, wmOperator *op)
+{
+  NodesModifierData *nmd = timeline_export_modifier_get(C, op);
+  if (nmd == nullptr) {
+    return OPERATOR_CANCELLED;
+  }
+  /* Keep the log alive even if the modifier is reevaluated in the meantime. */
+  const std::shared_ptr<nodes::geo_eval_log::GeoModifierLog> eval_log = nmd->runtime->eval_log;
+  if (!eval_log || !eval_log->record_timeline) {
+    BKE_report(op->reports, RPT_ERROR, "No timeline has been recorded for this modifier");
+    return OPERATOR_CANCELLED;
+  }
+
+  char filepath[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filepath);
+  BLI_path_abs(filepath, BKE_main_blendfile_path(CTX_data_main(C)));
+
+  const std::shared_ptr<io::serialize::DictionaryValue> trace =
+      eval_log->timeline_to_chrome_trace();
+  fstream file{filepath, std::ios::out};
+  if (!file) {
+    BKE_reportf(op->reports, RPT_ERROR, "Cannot open file \"%s\" for writing", filepath);
+    return OPERATOR_CANCELLED;
+  }
+  io::serialize::JsonFormatter formatter;
+  formatter.serialize(file, *trace);
+  return OPERATOR_FINISHED;
+}
+
+static int geometry_nodes_timeline_export_invoke(bContext *C,
+                                                 wmOperator *op,
+                                                 const wmEvent * /*event*/)
+{
+  NodesModifierData *nmd = timeline_export_modifier_get(C, op);
+  if (nmd == nullptr) {
+    return OPERATOR_CANCELLED;
+  }
+  if (RNA_struct_property_is_set(op->ptr, "filepath")) {
+    return geometry_nodes_timeline_export_exec(C, op);
+  }
+  char filepath[FILE_MAX];
+  SNPRINTF(filepath, "//%s_timeline.json", nmd->modifier.name);
+  BLI_path_make_safe_filename(filepath + 2);
+  RNA_string_set(op->ptr, "filepath", filepath);
+  WM_event_add_fileselect(C, op);
+  return OPERATOR_RUNNING_MODAL;
+}
+
+void OBJECT_OT_geometry_nodes_timeline_export(wmOperatorType *ot)
+{
+  ot->name = "Export Geometry Nodes Timeline";
+  ot->description =
+      "Write the recorded node evaluation timeline of the modifier to a file in the Chrome trace "
+      "format";
+  ot->idname = "OBJECT_OT_geometry_nodes_timeline_export";
+
+  ot->exec = geometry_nodes_timeline_export_exec;
+  ot->invoke = geometry_nodes_timeline_export_invoke;
+  ot->poll = ED_operator_object_active;
+
+  ot->flag = OPTYPE_REGISTER | OPTYPE_INTERNAL;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER,
+                                 FILE_SPECIAL,
+                                 FILE_SAVE,
+                                 WM_FILESEL_FILEPATH,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+
+  /* Only show `.json` files by default. */
+  PropertyRNA *prop = RNA_def_string(ot->srna, "filter_glob", "*.json", 0, "", "");
+  RNA_def_property_flag(prop, PROP_HIDDEN);
+
+  RNA_def_string(ot->srna, "modifier_name", nullptr, MAX_NAME, "Modifier Name", "");
+}
+
+/** \} */
+
 /* ------------------------------------------------------------------- */
 /** \name Copy and Assign Geometry Node Group operator
  * \{ */
@@ -866,8 +866,10 @@ static void recalcData_objects(TransInfo *t)
       motionpath_update |= motionpath_need_update_object(t->scene, ob);
 
       /* Sets recalc flags fully, instead of flushing existing ones
-       * otherwise proxies don't function correctly. */
-      DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM);
+       * otherwise proxies don't function correctly.
+       * Only the transform channels are modified here, which avoids copying the whole object to
+       * the evaluated one while transforming. */
+      DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM_CHANNELS);
     }
   }
 
@@ -17,6 +17,11 @@ class ProcedureExecutor : public MultiFunction {
  private:
   Signature signature_;
   const Procedure &procedure_;
+  /**
+   * Number of indices the procedure is executed on at once when the mask is large, or zero if it
+   * is always executed on the entire mask. See #procedure_optimization::find_fused_chunk_size.
+   */
+  int64_t fused_chunk_size_;
 
  public:
   ProcedureExecutor(const Procedure &procedure);
@@ -46,4 +46,18 @@ namespace blender::fn::multi_function::procedure_optimization {
  */
 void move_destructs_up(Procedure &procedure, Instruction &block_end_instr);
 
+/**
+ * By default, every instruction of a procedure is executed on all indices before the next
+ * instruction starts. For large masks, this means that every intermediate variable is written to
+ * main memory and read back by the next instruction. Executing the entire procedure on smaller
+ * chunks of indices instead fuses the loops of all instructions, so that intermediate buffers
+ * stay in the CPU cache.
+ *
+ * This finds the number of indices that should be processed at once, so that the buffers of all
+ * variables fit into the cache together. Zero is returned when the procedure should not be
+ * split up, i.e. when it has no intermediate variables or when it uses vector variables, which
+ * can't be sliced.
+ */
+int64_t find_fused_chunk_size(const Procedure &procedure);
+
 }  // namespace blender::fn::multi_function::procedure_optimization
@@ -4,6 +4,10 @@
 
 #include "FN_multi_function_procedure_optimization.hh"
 
+#include "BLI_set.hh"
+
+#include <algorithm>
+
 namespace blender::fn::multi_function::procedure_optimization {
 
 void move_destructs_up(Procedure &procedure, Instruction &block_end_instr)
@@ -74,4 +78,40 @@ void move_destructs_up(Procedure &procedure, Instruction &block_end_instr)
   }
 }
 
+int64_t find_fused_chunk_size(const Procedure &procedure)
+{
+  /* Roughly the size of the L2 cache of a single core. */
+  const int64_t cache_budget = 256 * 1024;
+  const int64_t min_chunk_size = 1024;
+  const int64_t max_chunk_size = 16 * 1024;
+  /* The executor allocates at least this many bytes per element for span buffers. */
+  const int64_t min_element_size = 16;
+
+  Set<const Variable *> param_variables;
+  for (const ConstParameter &param : procedure.params()) {
+    param_variables.add(param.variable);
+  }
+
+  int64_t bytes_per_index = 0;
+  bool has_intermediate_variables = false;
+  for (const Variable *variable : procedure.variables()) {
+    const DataType data_type = variable->data_type();
+    if (data_type.category() != DataType::Single) {
+      return 0;
+    }
+    bytes_per_index += std::max<int64_t>(data_type.single_type().size(), min_element_size);
+    if (!param_variables.contains(variable)) {
+      has_intermediate_variables = true;
+    }
+  }
+  if (!has_intermediate_variables) {
+    return 0;
+  }
+
+  const int64_t chunk_size = std::clamp(
+      cache_budget / bytes_per_index, min_chunk_size, max_chunk_size);
+  /* Use a multiple of 64, so that chunk boundaries are on cache lines for common types. */
+  return chunk_size & ~int64_t(63);
+}
+
 }  // namespace blender::fn::multi_function::procedure_optimization
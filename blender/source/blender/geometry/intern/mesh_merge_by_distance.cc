@@ -6,11 +6,17 @@
 // #define USE_WELD_DEBUG_TIME
 
 #include "BLI_array.hh"
+#include "BLI_array_utils.hh"
 #include "BLI_bit_vector.hh"
+#include "BLI_bounds.hh"
 #include "BLI_index_mask.hh"
 #include "BLI_kdtree.h"
+#include "BLI_map.hh"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
 #include "BLI_offset_indices.hh"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_customdata.hh"
@@ -333,35 +339,42 @@ static Vector<WeldEdge> weld_edge_ctx_alloc_and_find_collapsed(Span<int2> edges,
                                                                int *r_edge_collapsed_len)
 {
   /* Edge Context. */
-  int edge_collapsed_len = 0;
-
-  Vector<WeldEdge> wedge;
-  wedge.reserve(edges.size());
-
-  for (const int i : edges.index_range()) {
-    int v1 = edges[i][0];
-    int v2 = edges[i][1];
-    int v_dest_1 = vert_dest_map[v1];
-    int v_dest_2 = vert_dest_map[v2];
-    if (v_dest_1 == OUT_OF_CONTEXT && v_dest_2 == OUT_OF_CONTEXT) {
-      r_edge_dest_map[i] = OUT_OF_CONTEXT;
-      continue;
-    }
-
-    const int vert_a = (v_dest_1 == OUT_OF_CONTEXT) ? v1 : v_dest_1;
-    const int vert_b = (v_dest_2 == OUT_OF_CONTEXT) ? v2 : v_dest_2;
-
-    if (vert_a == vert_b) {
-      r_edge_dest_map[i] = ELEM_COLLAPSED;
-      edge_collapsed_len++;
-    }
-    else {
-      wedge.append({i, vert_a, vert_b});
-      r_edge_dest_map[i] = i;
-    }
-  }
+  auto edge_dest_verts = [&](const int2 edge) {
+    const int v_dest_1 = vert_dest_map[edge[0]];
+    const int v_dest_2 = vert_dest_map[edge[1]];
+    return int2((v_dest_1 == OUT_OF_CONTEXT) ? edge[0] : v_dest_1,
+                (v_dest_2 == OUT_OF_CONTEXT) ? edge[1] : v_dest_2);
+  };
 
-  *r_edge_collapsed_len = edge_collapsed_len;
+  threading::parallel_for(edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int2 edge = edges[i];
+      if (vert_dest_map[edge[0]] == OUT_OF_CONTEXT && vert_dest_map[edge[1]] == OUT_OF_CONTEXT) {
+        r_edge_dest_map[i] = OUT_OF_CONTEXT;
+        continue;
+      }
+      const int2 dest_verts = edge_dest_verts(edge);
+      r_edge_dest_map[i] = (dest_verts[0] == dest_verts[1]) ? ELEM_COLLAPSED : i;
+    }
+  });
+
+  IndexMaskMemory memory;
+  const IndexMask collapsed_edges = IndexMask::from_predicate(
+      edges.index_range(), GrainSize(4096), memory, [&](const int i) {
+        return r_edge_dest_map[i] == ELEM_COLLAPSED;
+      });
+  const IndexMask ctx_edges = IndexMask::from_predicate(
+      edges.index_range(), GrainSize(4096), memory, [&](const int i) {
+        return r_edge_dest_map[i] == i;
+      });
+
+  Vector<WeldEdge> wedge(ctx_edges.size());
+  ctx_edges.foreach_index(GrainSize(4096), [&](const int i, const int pos) {
+    const int2 dest_verts = edge_dest_verts(edges[i]);
+    wedge[pos] = {i, dest_verts[0], dest_verts[1]};
+  });
+
+  *r_edge_collapsed_len = collapsed_edges.size();
   return wedge;
 }
 
@@ -580,105 +593,113 @@ static void weld_poly_loop_ctx_alloc(const OffsetIndices<int> faces,
   Span<int> vert_dest_map = r_weld_mesh->vert_dest_map;
   Span<int> edge_dest_map = r_weld_mesh->edge_dest_map;
 
+  auto is_vert_ctx = [&](const int loop) {
+    return vert_dest_map[corner_verts[loop]] != OUT_OF_CONTEXT;
+  };
+  auto loop_next_in_face = [&](const IndexRange face, const int loop) {
+    return (loop == face.last()) ? int(face.first()) : loop + 1;
+  };
+
+  /* Count the context loops of every face first, so that the loop and face contexts can be
+   * filled in parallel afterwards. */
+  Array<int> loop_ctx_offsets_data(faces.size() + 1);
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange face = faces[i];
+      int loop_ctx_len = 0;
+      for (const int loop_orig : face) {
+        if (is_vert_ctx(loop_orig) || is_vert_ctx(loop_next_in_face(face, loop_orig))) {
+          loop_ctx_len++;
+        }
+      }
+      loop_ctx_offsets_data[i] = loop_ctx_len;
+    }
+  });
+  const OffsetIndices<int> loop_ctx_offsets = offset_indices::accumulate_counts_to_offsets(
+      loop_ctx_offsets_data);
+
+  IndexMaskMemory memory;
+  const IndexMask ctx_faces = IndexMask::from_predicate(
+      faces.index_range(), GrainSize(4096), memory, [&](const int i) {
+        return !loop_ctx_offsets[i].is_empty();
+      });
+
   /* Loop/Poly Context. */
   Array<int> loop_map(corner_verts.size());
   Array<int> face_map(faces.size());
-  int wloop_len = 0;
-  int wpoly_len = 0;
   int max_ctx_poly_len = 4;
-
-  Vector<WeldLoop> wloop;
-  wloop.reserve(corner_verts.size());
-
-  Vector<WeldPoly> wpoly;
-  wpoly.reserve(faces.size());
-
   int maybe_new_poly = 0;
 
-  for (const int i : faces.index_range()) {
-    const int loopstart = faces[i].start();
+  ctx_faces.foreach_index([&](const int i) {
     const int totloop = faces[i].size();
-    const int loop_end = loopstart + totloop - 1;
-    int v_first = corner_verts[loopstart];
-    int v_dest_first = vert_dest_map[v_first];
-    bool is_vert_first_ctx = v_dest_first != OUT_OF_CONTEXT;
-
-    int v_next = v_first;
-    int v_dest_next = v_dest_first;
-    bool is_vert_next_ctx = is_vert_first_ctx;
+    const int loop_ctx_len = loop_ctx_offsets[i].size();
+    if (totloop > 5 && loop_ctx_len > 1) {
+      /* We could be smarter here and actually count how many new polygons will be created.
+       * But counting this can be inefficient as it depends on the number of non-consecutive
+       * self face merges. For now just estimate a maximum value. */
+      int max_new = std::min((totloop / 3), loop_ctx_len) - 1;
+      maybe_new_poly += max_new;
+      CLAMP_MIN(max_ctx_poly_len, totloop);
+    }
+  });
 
-    int prev_wloop_len = wloop_len;
-    for (const int loop_orig : faces[i]) {
-      int v = v_next;
-      int v_dest = v_dest_next;
-      bool is_vert_ctx = is_vert_next_ctx;
+  Vector<WeldLoop> wloop(loop_ctx_offsets.total_size());
 
-      int loop_next;
-      if (loop_orig != loop_end) {
-        loop_next = loop_orig + 1;
-        v_next = corner_verts[loop_next];
-        v_dest_next = vert_dest_map[v_next];
-        is_vert_next_ctx = v_dest_next != OUT_OF_CONTEXT;
-      }
-      else {
-        loop_next = loopstart;
-        v_next = v_first;
-        v_dest_next = v_dest_first;
-        is_vert_next_ctx = is_vert_first_ctx;
+  Vector<WeldPoly> wpoly;
+  wpoly.reserve(ctx_faces.size() + maybe_new_poly);
+  wpoly.resize(ctx_faces.size());
+
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (loop_ctx_offsets[i].is_empty()) {
+        loop_map.as_mutable_span().slice(faces[i]).fill(OUT_OF_CONTEXT);
+        face_map[i] = OUT_OF_CONTEXT;
       }
+    }
+  });
 
-      if (is_vert_ctx || is_vert_next_ctx) {
-        int e = corner_edges[loop_orig];
-        int e_dest = edge_dest_map[e];
-        bool is_edge_ctx = e_dest != OUT_OF_CONTEXT;
-
-        wloop.increase_size_by_unchecked(1);
-        WeldLoop &wl = wloop.last();
-        wl.vert = is_vert_ctx ? v_dest : v;
-        wl.edge = is_edge_ctx ? e_dest : e;
-        wl.loop_orig = loop_orig;
-        wl.loop_next = loop_next;
+  ctx_faces.foreach_index(GrainSize(1024), [&](const int i, const int wpoly_index) {
+    const IndexRange face = faces[i];
+    const IndexRange loop_ctx = loop_ctx_offsets[i];
 
-        loop_map[loop_orig] = wloop_len++;
-      }
-      else {
+    int wloop_index = loop_ctx.start();
+    for (const int loop_orig : face) {
+      const int loop_next = loop_next_in_face(face, loop_orig);
+      const bool is_vert_cur_ctx = is_vert_ctx(loop_orig);
+      if (!is_vert_cur_ctx && !is_vert_ctx(loop_next)) {
         loop_map[loop_orig] = OUT_OF_CONTEXT;
+        continue;
       }
-    }
+      const int v = corner_verts[loop_orig];
+      const int e = corner_edges[loop_orig];
+      const int e_dest = edge_dest_map[e];
+      bool is_edge_ctx = e_dest != OUT_OF_CONTEXT;
+
+      WeldLoop &wl = wloop[wloop_index];
+      wl.vert = is_vert_cur_ctx ? vert_dest_map[v] : v;
+      wl.edge = is_edge_ctx ? e_dest : e;
+      wl.loop_orig = loop_orig;
+      wl.loop_next = loop_next;
 
-    if (wloop_len != prev_wloop_len) {
-      int loop_ctx_len = wloop_len - prev_wloop_len;
-      wpoly.increase_size_by_unchecked(1);
+      loop_map[loop_orig] = wloop_index++;
+    }
+    BLI_assert(wloop_index == loop_ctx.one_after_last());
 
-      WeldPoly &wp = wpoly.last();
-      wp.poly_dst = OUT_OF_CONTEXT;
-      wp.poly_orig = i;
-      wp.loop_start = loopstart;
-      wp.loop_end = loop_end;
+    WeldPoly &wp = wpoly[wpoly_index];
+    wp.poly_dst = OUT_OF_CONTEXT;
+    wp.poly_orig = i;
+    wp.loop_start = face.first();
+    wp.loop_end = face.last();
 
-      wp.loop_ctx_start = prev_wloop_len;
-      wp.loop_ctx_len = loop_ctx_len;
+    wp.loop_ctx_start = loop_ctx.start();
+    wp.loop_ctx_len = loop_ctx.size();
 
 #ifdef USE_WELD_DEBUG
-      wp.loop_len = totloop;
+    wp.loop_len = face.size();
 #endif
 
-      face_map[i] = wpoly_len++;
-      if (totloop > 5 && loop_ctx_len > 1) {
-        /* We could be smarter here and actually count how many new polygons will be created.
-         * But counting this can be inefficient as it depends on the number of non-consecutive
-         * self face merges. For now just estimate a maximum value. */
-        int max_new = std::min((totloop / 3), loop_ctx_len) - 1;
-        maybe_new_poly += max_new;
-        CLAMP_MIN(max_ctx_poly_len, totloop);
-      }
-    }
-    else {
-      face_map[i] = OUT_OF_CONTEXT;
-    }
-  }
-
-  wpoly.reserve(wpoly.size() + maybe_new_poly);
+    face_map[i] = wpoly_index;
+  });
 
   r_weld_mesh->wloop = std::move(wloop);
   r_weld_mesh->wpoly = std::move(wpoly);
@@ -1451,83 +1472,78 @@ static void merge_customdata_all(const CustomData *source,
 
   const int source_size = dest_map.size();
 
-  MutableSpan<int> groups_offs_;
+  Array<int> groups_offs_;
   Array<int> groups_buffer;
   if (do_mix_data) {
-    r_final_map.reinitialize(source_size + 1);
-
-    /* Be careful when setting values to this array as it uses the same buffer as `r_final_map`. */
-    groups_offs_ = r_final_map;
+    groups_offs_.reinitialize(source_size + 1);
     merge_groups_create(dest_map, double_elems, groups_offs_, groups_buffer);
   }
-  else {
-    r_final_map.reinitialize(source_size);
-  }
   OffsetIndices<int> groups_offs(groups_offs_);
 
-  bool finalize_map = false;
-  int dest_index = 0;
-  for (int i = 0; i < source_size; i++) {
-    const int source_index = i;
-    int count = 0;
-    while (i < source_size && dest_map[i] == OUT_OF_CONTEXT) {
-      r_final_map[i] = dest_index + count;
-      count++;
-      i++;
-    }
-    if (count) {
-      CustomData_copy_data(source, dest, source_index, dest_index, count);
-      dest_index += count;
-    }
-    if (i == source_size) {
-      break;
-    }
-    if (dest_map[i] == i) {
-      if (do_mix_data) {
-        const IndexRange grp_buffer_range = groups_offs[i];
-        customdata_weld(source,
-                        dest,
-                        &groups_buffer[grp_buffer_range.start()],
-                        grp_buffer_range.size(),
-                        dest_index);
-      }
-      else {
-        CustomData_copy_data(source, dest, i, dest_index, 1);
-      }
-      r_final_map[i] = dest_index;
-      dest_index++;
-    }
-    else if (dest_map[i] == ELEM_COLLAPSED) {
-      /* Any value will do. This field must not be accessed anymore. */
-      r_final_map[i] = 0;
-    }
-    else {
+  r_final_map.reinitialize(source_size);
+
+  /* Elements that are not merged into another element keep existing in the result, in the same
+   * order. Their new index is their position in this mask. */
+  IndexMaskMemory memory;
+  const IndexMask kept_elems = IndexMask::from_predicate(
+      dest_map.index_range(), GrainSize(4096), memory, [&](const int i) {
+        return ELEM(dest_map[i], OUT_OF_CONTEXT, i);
+      });
+  BLI_assert(kept_elems.size() == dest_size);
+
+  kept_elems.foreach_segment(
+      GrainSize(512), [&](const IndexMaskSegment segment, const int64_t segment_pos) {
+        int dest_index = segment_pos;
+        int64_t segment_i = 0;
+        while (segment_i < segment.size()) {
+          const int i = segment[segment_i];
+          if (dest_map[i] == OUT_OF_CONTEXT) {
+            /* Copy consecutive unchanged elements at once. */
+            int count = 1;
+            while (segment_i + count < segment.size() && segment[segment_i + count] == i + count &&
+                   dest_map[i + count] == OUT_OF_CONTEXT)
+            {
+              count++;
+            }
+            CustomData_copy_data(source, dest, i, dest_index, count);
+            for (const int j : IndexRange(count)) {
+              r_final_map[i + j] = dest_index + j;
+            }
+            dest_index += count;
+            segment_i += count;
+            continue;
+          }
+          if (do_mix_data) {
+            const IndexRange grp_buffer_range = groups_offs[i];
+            customdata_weld(source,
+                            dest,
+                            &groups_buffer[grp_buffer_range.start()],
+                            grp_buffer_range.size(),
+                            dest_index);
+          }
+          else {
+            CustomData_copy_data(source, dest, i, dest_index, 1);
+          }
+          r_final_map[i] = dest_index;
+          dest_index++;
+          segment_i++;
+        }
+      });
+
+  threading::parallel_for(dest_map.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
       const int elem_dest = dest_map[i];
-      BLI_assert(elem_dest != OUT_OF_CONTEXT);
-      BLI_assert(dest_map[elem_dest] == elem_dest);
-      if (elem_dest < i) {
-        r_final_map[i] = r_final_map[elem_dest];
-        BLI_assert(r_final_map[i] < dest_size);
+      if (elem_dest == ELEM_COLLAPSED) {
+        /* Any value will do. This field must not be accessed anymore. */
+        r_final_map[i] = 0;
       }
-      else {
-        /* Mark as negative to set at the end. */
-        r_final_map[i] = -elem_dest;
-        finalize_map = true;
-      }
-    }
-  }
-
-  if (finalize_map) {
-    for (const int i : r_final_map.index_range()) {
-      if (r_final_map[i] < 0) {
-        r_final_map[i] = r_final_map[-r_final_map[i]];
+      else if (!ELEM(elem_dest, OUT_OF_CONTEXT, i)) {
+        BLI_assert(dest_map[elem_dest] == elem_dest);
+        r_final_map[i] = r_final_map[elem_dest];
         BLI_assert(r_final_map[i] < dest_size);
       }
-      BLI_assert(r_final_map[i] >= 0);
     }
-  }
-
-  BLI_assert(dest_index == dest_size);
+  });
 }
 
 /** \} */
@@ -1590,98 +1606,116 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
                        do_mix_data,
                        edge_final_map);
 
-  for (int2 &edge : dst_edges) {
-    edge[0] = vert_final_map[edge[0]];
-    edge[1] = vert_final_map[edge[1]];
-    BLI_assert(edge[0] != edge[1]);
-    BLI_assert(IN_RANGE_INCL(edge[0], 0, result_nverts - 1));
-    BLI_assert(IN_RANGE_INCL(edge[1], 0, result_nverts - 1));
-  }
+  threading::parallel_for(dst_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (int2 &edge : dst_edges.slice(range)) {
+      edge[0] = vert_final_map[edge[0]];
+      edge[1] = vert_final_map[edge[1]];
+      BLI_assert(edge[0] != edge[1]);
+      BLI_assert(IN_RANGE_INCL(edge[0], 0, result_nverts - 1));
+      BLI_assert(IN_RANGE_INCL(edge[1], 0, result_nverts - 1));
+    }
+  });
 
   /* Faces/Loops. */
 
-  int r_i = 0;
-  int loop_cur = 0;
-  Array<int, 64> group_buffer(weld_mesh.max_face_len);
-  for (const int i : src_faces.index_range()) {
-    const int loop_start = loop_cur;
-    const int poly_ctx = weld_mesh.face_map[i];
-    if (poly_ctx == OUT_OF_CONTEXT) {
-      int mp_loop_len = src_faces[i].size();
-      CustomData_copy_data(
-          &mesh.corner_data, &result->corner_data, src_faces[i].start(), loop_cur, mp_loop_len);
-      for (; mp_loop_len--; loop_cur++) {
-        dst_corner_verts[loop_cur] = vert_final_map[dst_corner_verts[loop_cur]];
-        dst_corner_edges[loop_cur] = edge_final_map[dst_corner_edges[loop_cur]];
-      }
+  /* The faces of the source mesh are followed by the new faces created by splitting. */
+  const IndexRange new_wpoly_range = weld_mesh.wpoly.index_range().take_back(
+      weld_mesh.wpoly_new_len);
+  const IndexRange all_faces_range(src_faces.size() + new_wpoly_range.size());
+  auto weld_poly_for_face = [&](const int i) -> const WeldPoly * {
+    if (i >= src_faces.size()) {
+      return &weld_mesh.wpoly[new_wpoly_range[i - src_faces.size()]];
     }
-    else {
-      const WeldPoly &wp = weld_mesh.wpoly[poly_ctx];
-      WeldLoopOfPolyIter iter;
-      if (!weld_iter_loop_of_poly_begin(iter,
+    const int poly_ctx = weld_mesh.face_map[i];
+    return (poly_ctx == OUT_OF_CONTEXT) ? nullptr : &weld_mesh.wpoly[poly_ctx];
+  };
+  auto weld_iter_begin = [&](WeldLoopOfPolyIter &iter, const WeldPoly &wp, int *group_buffer) {
+    return weld_iter_loop_of_poly_begin(iter,
                                         wp,
                                         weld_mesh.wloop,
                                         src_corner_verts,
                                         src_corner_edges,
                                         weld_mesh.loop_map,
-                                        group_buffer.data()))
-      {
-        continue;
-      }
+                                        group_buffer) &&
+           wp.poly_dst == OUT_OF_CONTEXT;
+  };
 
-      if (wp.poly_dst != OUT_OF_CONTEXT) {
+  /* Count the corners of every result face first, so that the faces can be created in parallel.
+   * Faces that are removed get a size of zero. */
+  Array<int> dst_corner_offsets_data(all_faces_range.size() + 1);
+  threading::parallel_for(all_faces_range, 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const WeldPoly *wp = weld_poly_for_face(i);
+      if (wp == nullptr) {
+        dst_corner_offsets_data[i] = src_faces[i].size();
         continue;
       }
-      do {
-        customdata_weld(&mesh.corner_data,
-                        &result->corner_data,
-                        group_buffer.data(),
-                        iter.group_len,
-                        loop_cur);
-        dst_corner_verts[loop_cur] = vert_final_map[iter.v];
-        dst_corner_edges[loop_cur] = edge_final_map[iter.e];
-        loop_cur++;
-      } while (weld_iter_loop_of_poly_next(iter));
-    }
-
-    CustomData_copy_data(&mesh.face_data, &result->face_data, i, r_i, 1);
-    dst_face_offsets[r_i] = loop_start;
-    r_i++;
-  }
-
-  /* New Polygons. */
-  for (const int i : weld_mesh.wpoly.index_range().take_back(weld_mesh.wpoly_new_len)) {
-    const WeldPoly &wp = weld_mesh.wpoly[i];
-    const int loop_start = loop_cur;
-    WeldLoopOfPolyIter iter;
-    if (!weld_iter_loop_of_poly_begin(iter,
-                                      wp,
-                                      weld_mesh.wloop,
-                                      src_corner_verts,
-                                      src_corner_edges,
-                                      weld_mesh.loop_map,
-                                      group_buffer.data()))
-    {
-      continue;
-    }
-
-    if (wp.poly_dst != OUT_OF_CONTEXT) {
-      continue;
-    }
-    do {
-      customdata_weld(
-          &mesh.corner_data, &result->corner_data, group_buffer.data(), iter.group_len, loop_cur);
-      dst_corner_verts[loop_cur] = vert_final_map[iter.v];
-      dst_corner_edges[loop_cur] = edge_final_map[iter.e];
-      loop_cur++;
-    } while (weld_iter_loop_of_poly_next(iter));
-
-    dst_face_offsets[r_i] = loop_start;
-    r_i++;
-  }
+      int loop_len = 0;
+      WeldLoopOfPolyIter iter;
+      /* No group buffer is needed to only count the corners. */
+      if (weld_iter_begin(iter, *wp, nullptr)) {
+        do {
+          loop_len++;
+        } while (weld_iter_loop_of_poly_next(iter));
+      }
+      dst_corner_offsets_data[i] = loop_len;
+    }
+  });
+  const OffsetIndices<int> dst_corner_offsets = offset_indices::accumulate_counts_to_offsets(
+      dst_corner_offsets_data);
+  BLI_assert(dst_corner_offsets.total_size() == result_nloops);
+
+  IndexMaskMemory memory;
+  const IndexMask kept_faces = IndexMask::from_predicate(
+      all_faces_range, GrainSize(4096), memory, [&](const int i) {
+        return !dst_corner_offsets[i].is_empty();
+      });
+  BLI_assert(kept_faces.size() == result_nfaces);
+
+  kept_faces.foreach_segment(
+      GrainSize(512), [&](const IndexMaskSegment segment, const int64_t segment_pos) {
+        Array<int, 64> group_buffer(weld_mesh.max_face_len);
+        for (const int64_t segment_i : segment.index_range()) {
+          const int i = segment[segment_i];
+          const int r_i = segment_pos + segment_i;
+          const IndexRange dst_face = dst_corner_offsets[i];
+          const WeldPoly *wp = weld_poly_for_face(i);
+          if (wp == nullptr) {
+            CustomData_copy_data(&mesh.corner_data,
+                                 &result->corner_data,
+                                 src_faces[i].start(),
+                                 dst_face.start(),
+                                 dst_face.size());
+            for (const int loop_cur : dst_face) {
+              dst_corner_verts[loop_cur] = vert_final_map[dst_corner_verts[loop_cur]];
+              dst_corner_edges[loop_cur] = edge_final_map[dst_corner_edges[loop_cur]];
+            }
+          }
+          else {
+            WeldLoopOfPolyIter iter;
+            const bool is_valid = weld_iter_begin(iter, *wp, group_buffer.data());
+            BLI_assert(is_valid);
+            UNUSED_VARS_NDEBUG(is_valid);
+            int loop_cur = dst_face.start();
+            do {
+              customdata_weld(&mesh.corner_data,
+                              &result->corner_data,
+                              group_buffer.data(),
+                              iter.group_len,
+                              loop_cur);
+              dst_corner_verts[loop_cur] = vert_final_map[iter.v];
+              dst_corner_edges[loop_cur] = edge_final_map[iter.e];
+              loop_cur++;
+            } while (weld_iter_loop_of_poly_next(iter));
+            BLI_assert(loop_cur == dst_face.one_after_last());
+          }
 
-  BLI_assert(int(r_i) == result_nfaces);
-  BLI_assert(loop_cur == result_nloops);
+          if (i < src_faces.size()) {
+            CustomData_copy_data(&mesh.face_data, &result->face_data, i, r_i, 1);
+          }
+          dst_face_offsets[r_i] = dst_face.start();
+        }
+      });
 
   debug_randomize_mesh_order(result);
 
@@ -1694,27 +1728,179 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
 /** \name Merge Map Creation
  * \{ */
 
+/** Number of bits used for the cell coordinate in every axis in #grid_cell_key. */
+static constexpr int grid_cell_bits = 21;
+
+/**
+ * Maximum number of vertices in a grid cell. All pairs of vertices in neighboring cells are
+ * stored as candidates, so dense clusters, like many vertices at the same position, make the
+ * grid quadratic in time and memory. The kd-tree handles those better.
+ */
+static constexpr int grid_cell_max_verts = 64;
+
+static uint64_t grid_cell_key(const int3 cell)
+{
+  return uint64_t(cell.x) | (uint64_t(cell.y) << grid_cell_bits) |
+         (uint64_t(cell.z) << (2 * grid_cell_bits));
+}
+
+/**
+ * Same as #BLI_kdtree_3d_calc_duplicates_fast with index order, but the vertices are sorted into a
+ * uniform grid with cells the size of the merge distance. This makes it possible to find the merge
+ * candidates of all vertices in parallel. Only the final assignment of the targets, which depends
+ * on the order, is done serially, and it is cheap.
+ *
+ * \return The number of merged vertices, or none if the positions don't fit into a grid with the
+ * merge distance or a cell contains too many vertices, in which case the kd-tree has to be used.
+ */
+static std::optional<int> calc_duplicates_grid(const Span<float3> positions,
+                                               const IndexMask &selection,
+                                               const float merge_distance,
+                                               MutableSpan<int> r_vert_dest_map)
+{
+  if (!(merge_distance > 0.0f)) {
+    return std::nullopt;
+  }
+  const std::optional<Bounds<float3>> bounds = bounds::min_max(selection, positions);
+  if (!bounds) {
+    return 0;
+  }
+  const float3 grid_size = (bounds->max - bounds->min) / merge_distance;
+  const float max_cell = float((1 << grid_cell_bits) - 2);
+  if (!(grid_size.x < max_cell && grid_size.y < max_cell && grid_size.z < max_cell)) {
+    return std::nullopt;
+  }
+
+  Array<int> verts(selection.size());
+  selection.to_indices(verts.as_mutable_span());
+
+  Array<int3> vert_cells(verts.size());
+  Array<uint64_t> vert_cell_keys(verts.size());
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int pos : range) {
+      const float3 grid_co = (positions[verts[pos]] - bounds->min) / merge_distance;
+      vert_cells[pos] = math::clamp(int3(grid_co), int3(0), int3(int(max_cell)));
+      vert_cell_keys[pos] = grid_cell_key(vert_cells[pos]);
+    }
+  });
+
+  /* Sort the vertices by cell, and by index within each cell. */
+  Array<int> sorted_verts(verts.size());
+  array_utils::fill_index_range<int>(sorted_verts);
+  parallel_sort(sorted_verts.begin(), sorted_verts.end(), [&](const int a, const int b) {
+    return vert_cell_keys[a] < vert_cell_keys[b] ||
+           (vert_cell_keys[a] == vert_cell_keys[b] && a < b);
+  });
+
+  Map<uint64_t, IndexRange> sorted_range_by_cell;
+  for (int64_t start = 0; start < sorted_verts.size();) {
+    const uint64_t key = vert_cell_keys[sorted_verts[start]];
+    int64_t end = start + 1;
+    while (end < sorted_verts.size() && vert_cell_keys[sorted_verts[end]] == key) {
+      end++;
+    }
+    if (end - start > grid_cell_max_verts) {
+      return std::nullopt;
+    }
+    sorted_range_by_cell.add_new(key, IndexRange::from_begin_end(start, end));
+    start = end;
+  }
+
+  /* Candidates of a vertex are the vertices with a larger index within the merge distance. Those
+   * with a smaller index have been handled already when the vertex is processed below. */
+  const float merge_distance_sq = square_f(merge_distance);
+  auto foreach_candidate = [&](const int pos, auto &&fn) {
+    const int3 cell = vert_cells[pos];
+    const float3 &co = positions[verts[pos]];
+    for (int z = std::max(cell.z - 1, 0); z <= cell.z + 1; z++) {
+      for (int y = std::max(cell.y - 1, 0); y <= cell.y + 1; y++) {
+        for (int x = std::max(cell.x - 1, 0); x <= cell.x + 1; x++) {
+          const IndexRange *range = sorted_range_by_cell.lookup_ptr(grid_cell_key({x, y, z}));
+          if (!range) {
+            continue;
+          }
+          for (const int other_pos : sorted_verts.as_span().slice(*range)) {
+            if (other_pos <= pos) {
+              continue;
+            }
+            if (math::distance_squared(co, positions[verts[other_pos]]) <= merge_distance_sq) {
+              fn(other_pos);
+            }
+          }
+        }
+      }
+    }
+  };
+
+  Array<int> candidate_offsets_data(verts.size() + 1);
+  threading::parallel_for(verts.index_range(), 1024, [&](const IndexRange range) {
+    for (const int pos : range) {
+      int count = 0;
+      foreach_candidate(pos, [&](const int /*other_pos*/) { count++; });
+      candidate_offsets_data[pos] = count;
+    }
+  });
+  const std::optional<OffsetIndices<int>> candidate_offsets =
+      offset_indices::accumulate_counts_to_offsets_with_overflow_check(candidate_offsets_data);
+  if (!candidate_offsets) {
+    return std::nullopt;
+  }
+  Array<int> candidates(candidate_offsets->total_size());
+  threading::parallel_for(verts.index_range(), 1024, [&](const IndexRange range) {
+    for (const int pos : range) {
+      int candidate_i = (*candidate_offsets)[pos].start();
+      foreach_candidate(pos, [&](const int other_pos) { candidates[candidate_i++] = other_pos; });
+    }
+  });
+
+  int vert_kill_len = 0;
+  for (const int pos : verts.index_range()) {
+    const int vert = verts[pos];
+    if (r_vert_dest_map[vert] != OUT_OF_CONTEXT) {
+      continue;
+    }
+    bool found = false;
+    for (const int other_pos : candidates.as_span().slice((*candidate_offsets)[pos])) {
+      const int other_vert = verts[other_pos];
+      if (r_vert_dest_map[other_vert] == OUT_OF_CONTEXT) {
+        r_vert_dest_map[other_vert] = vert;
+        vert_kill_len++;
+        found = true;
+      }
+    }
+    if (found) {
+      /* Prevent chains of doubles. */
+      r_vert_dest_map[vert] = vert;
+    }
+  }
+  return vert_kill_len;
+}
+
 std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  const IndexMask &selection,
                                                  const float merge_distance)
 {
   Array<int> vert_dest_map(mesh.verts_num, OUT_OF_CONTEXT);
 
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-
   const Span<float3> positions = mesh.vert_positions();
-  selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
-
-  BLI_kdtree_3d_balance(tree);
-  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, true, vert_dest_map.data());
-  BLI_kdtree_3d_free(tree);
+  std::optional<int> vert_kill_len = calc_duplicates_grid(
+      positions, selection, merge_distance, vert_dest_map);
+  if (!vert_kill_len) {
+    KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+    selection.foreach_index(
+        [&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
+
+    BLI_kdtree_3d_balance(tree);
+    vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
+        tree, merge_distance, true, vert_dest_map.data());
+    BLI_kdtree_3d_free(tree);
+  }
 
-  if (vert_kill_len == 0) {
+  if (*vert_kill_len == 0) {
     return std::nullopt;
   }
 
-  return create_merged_mesh(mesh, vert_dest_map, vert_kill_len, true);
+  return create_merged_mesh(mesh, vert_dest_map, *vert_kill_len, true);
 }
 
 struct WeldVertexCluster {
@@ -8,9 +8,11 @@
 #include "DNA_object_types.h"
 
 #include "BLI_array_utils.hh"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.hh"
 #include "BLI_noise.hh"
+#include "BLI_task.hh"
 
 #include "BKE_curves.hh"
 #include "BKE_customdata.hh"
@@ -552,6 +554,128 @@ static void foreach_geometry_in_reference(
   fn(geometry_set, base_transform, id);
 }
 
+/**
+ * Instances are gathered in chunks of this size in parallel when there are more of them. Within
+ * a chunk, the instances are processed serially.
+ */
+static constexpr int64_t GATHER_INSTANCES_CHUNK_SIZE = 256;
+
+/**
+ * Number of chunks that are gathered in parallel before they are joined. The tasks of a batch
+ * exist twice while it is joined, so batching limits that overhead to one batch instead of all
+ * instances.
+ */
+static constexpr int64_t GATHER_CHUNKS_PER_BATCH = 64;
+
+/**
+ * Reserves the task vectors for all instances, extrapolated from the tasks gathered for the
+ * first batch of instances. This is exact when there is only one batch. Otherwise, for instances
+ * that reference similar geometry, the vectors don't have to grow while the remaining batches
+ * are joined.
+ */
+static void reserve_estimated_tasks(GatherTasksInfo &gather_info,
+                                    const Span<std::optional<GatherTasksInfo>> chunk_infos,
+                                    const int64_t gathered_instances_num,
+                                    const int64_t instances_num)
+{
+  GatherTasks &tasks = gather_info.r_tasks;
+  AllInstancesInfo &instances = gather_info.instances;
+  int64_t pointcloud_tasks_num = 0;
+  int64_t mesh_tasks_num = 0;
+  int64_t curve_tasks_num = 0;
+  int64_t grease_pencil_tasks_num = 0;
+  int64_t instance_components_num = 0;
+  for (const std::optional<GatherTasksInfo> &chunk_info : chunk_infos) {
+    pointcloud_tasks_num += chunk_info->r_tasks.pointcloud_tasks.size();
+    mesh_tasks_num += chunk_info->r_tasks.mesh_tasks.size();
+    curve_tasks_num += chunk_info->r_tasks.curve_tasks.size();
+    grease_pencil_tasks_num += chunk_info->r_tasks.grease_pencil_tasks.size();
+    instance_components_num += chunk_info->instances.instances_components_to_merge.size();
+  }
+  const auto estimate = [&](const int64_t existing_num, const int64_t gathered_num) {
+    return existing_num + int64_t(double(gathered_num) * double(instances_num) /
+                                  double(gathered_instances_num));
+  };
+  tasks.pointcloud_tasks.reserve(estimate(tasks.pointcloud_tasks.size(), pointcloud_tasks_num));
+  tasks.mesh_tasks.reserve(estimate(tasks.mesh_tasks.size(), mesh_tasks_num));
+  tasks.curve_tasks.reserve(estimate(tasks.curve_tasks.size(), curve_tasks_num));
+  tasks.grease_pencil_tasks.reserve(
+      estimate(tasks.grease_pencil_tasks.size(), grease_pencil_tasks_num));
+  const int64_t instance_components_estimate = estimate(
+      instances.instances_components_to_merge.size(), instance_components_num);
+  instances.attribute_fallback.reserve(instance_components_estimate);
+  instances.instances_components_to_merge.reserve(instance_components_estimate);
+  instances.instances_components_transforms.reserve(instance_components_estimate);
+}
+
+/**
+ * Appends the tasks gathered for separate chunks of instances to #gather_info in order. The
+ * offsets of every chunk started at zero, so they are shifted by the offsets of everything that
+ * has been gathered before.
+ */
+static void join_gathered_chunks(
+    GatherTasksInfo &gather_info,
+    MutableSpan<std::optional<GatherTasksInfo>> chunk_infos,
+    MutableSpan<Vector<std::unique_ptr<GArray<>>>> chunk_temporary_arrays)
+{
+  GatherTasks &tasks = gather_info.r_tasks;
+  AllInstancesInfo &instances = gather_info.instances;
+  GatherOffsets &offsets = gather_info.r_offsets;
+  for (const int64_t chunk : chunk_infos.index_range()) {
+    GatherTasksInfo &chunk_info = *chunk_infos[chunk];
+    GatherTasks &chunk_tasks = chunk_info.r_tasks;
+
+    for (RealizePointCloudTask &task : chunk_tasks.pointcloud_tasks) {
+      task.start_index += offsets.pointcloud_offset;
+      tasks.pointcloud_tasks.append(std::move(task));
+    }
+    for (RealizeMeshTask &task : chunk_tasks.mesh_tasks) {
+      task.start_indices.vertex += offsets.mesh_offsets.vertex;
+      task.start_indices.edge += offsets.mesh_offsets.edge;
+      task.start_indices.face += offsets.mesh_offsets.face;
+      task.start_indices.loop += offsets.mesh_offsets.loop;
+      tasks.mesh_tasks.append(std::move(task));
+    }
+    for (RealizeCurveTask &task : chunk_tasks.curve_tasks) {
+      task.start_indices.point += offsets.curves_offsets.point;
+      task.start_indices.curve += offsets.curves_offsets.curve;
+      tasks.curve_tasks.append(std::move(task));
+    }
+    for (RealizeGreasePencilTask &task : chunk_tasks.grease_pencil_tasks) {
+      task.start_index += offsets.grease_pencil_layer_offset;
+      tasks.grease_pencil_tasks.append(std::move(task));
+    }
+    tasks.edit_data_tasks.extend(chunk_tasks.edit_data_tasks);
+    if (!tasks.first_volume) {
+      tasks.first_volume = std::move(chunk_tasks.first_volume);
+    }
+
+    for (const int64_t i : chunk_info.instances.instances_components_to_merge.index_range()) {
+      instances.attribute_fallback.append(std::move(chunk_info.instances.attribute_fallback[i]));
+      instances.instances_components_to_merge.append(
+          std::move(chunk_info.instances.instances_components_to_merge[i]));
+      instances.instances_components_transforms.append(
+          chunk_info.instances.instances_components_transforms[i]);
+    }
+
+    for (std::unique_ptr<GArray<>> &temporary_array : chunk_temporary_arrays[chunk]) {
+      gather_info.r_temporary_arrays.append(std::move(temporary_array));
+    }
+
+    offsets.pointcloud_offset += chunk_info.r_offsets.pointcloud_offset;
+    offsets.mesh_offsets.vertex += chunk_info.r_offsets.mesh_offsets.vertex;
+    offsets.mesh_offsets.edge += chunk_info.r_offsets.mesh_offsets.edge;
+    offsets.mesh_offsets.face += chunk_info.r_offsets.mesh_offsets.face;
+    offsets.mesh_offsets.loop += chunk_info.r_offsets.mesh_offsets.loop;
+    offsets.curves_offsets.point += chunk_info.r_offsets.curves_offsets.point;
+    offsets.curves_offsets.curve += chunk_info.r_offsets.curves_offsets.curve;
+    offsets.grease_pencil_layer_offset += chunk_info.r_offsets.grease_pencil_layer_offset;
+
+    /* Free the memory of the chunk right away, to keep the peak memory usage low. */
+    chunk_infos[chunk].reset();
+  }
+}
+
 static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
                                                const int current_depth,
                                                const int target_depth,
@@ -572,7 +696,6 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   }
 
   /* Prepare attribute fallbacks. */
-  InstanceContext instance_context = base_instance_context;
   Vector<std::pair<int, GSpan>> pointcloud_attributes_to_override = prepare_attribute_fallbacks(
       gather_info, instances, gather_info.pointclouds.attributes);
   Vector<std::pair<int, GSpan>> mesh_attributes_to_override = prepare_attribute_fallbacks(
@@ -588,7 +711,10 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   /* If at top level, get instance indices from selection field, else use all instances. */
   const IndexMask indices = is_top_level ? gather_info.selection :
                                            IndexMask(IndexRange(instances.instances_num()));
-  indices.foreach_index([&](const int i) {
+
+  auto gather_instance = [&](GatherTasksInfo &chunk_info,
+                             InstanceContext &instance_context,
+                             const int i) {
     /* If at top level, retrieve depth from gather_info, else continue with target_depth. */
     const int child_target_depth = is_top_level ? gather_info.depths[i] : target_depth;
     const int handle = handles[i];
@@ -632,14 +758,61 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
                                       const float4x4 &transform,
                                       const uint32_t id) {
                                     instance_context.id = id;
-                                    gather_realize_tasks_recursive(gather_info,
+                                    gather_realize_tasks_recursive(chunk_info,
                                                                    current_depth + 1,
                                                                    child_target_depth,
                                                                    instance_geometry_set,
                                                                    transform,
                                                                    instance_context);
                                   });
-  });
+  };
+
+  if (indices.size() <= GATHER_INSTANCES_CHUNK_SIZE) {
+    InstanceContext instance_context = base_instance_context;
+    indices.foreach_index(
+        [&](const int i) { gather_instance(gather_info, instance_context, i); });
+    return;
+  }
+
+  /* Gather the tasks for chunks of instances in parallel. Every chunk starts counting its offsets
+   * at zero and has its own temporary arrays. The chunks are joined in order afterwards, so the
+   * result is the same as when all instances are gathered serially. */
+  const int64_t chunks_num = (indices.size() + GATHER_INSTANCES_CHUNK_SIZE - 1) /
+                             GATHER_INSTANCES_CHUNK_SIZE;
+  for (int64_t batch_start = 0; batch_start < chunks_num; batch_start += GATHER_CHUNKS_PER_BATCH)
+  {
+    const IndexRange batch(batch_start,
+                           std::min(GATHER_CHUNKS_PER_BATCH, chunks_num - batch_start));
+    Array<Vector<std::unique_ptr<GArray<>>>> chunk_temporary_arrays(batch.size());
+    Array<std::optional<GatherTasksInfo>> chunk_infos(batch.size());
+    threading::parallel_for(batch.index_range(), 1, [&](const IndexRange batch_chunks) {
+      for (const int64_t i : batch_chunks) {
+        GatherTasksInfo &chunk_info = chunk_infos[i].emplace(
+            GatherTasksInfo{gather_info.pointclouds,
+                            gather_info.meshes,
+                            gather_info.curves,
+                            gather_info.grease_pencils,
+                            gather_info.instances_attriubutes,
+                            gather_info.create_id_attribute_on_any_component,
+                            gather_info.selection,
+                            gather_info.depths,
+                            chunk_temporary_arrays[i]});
+        const int64_t chunk_start = batch[i] * GATHER_INSTANCES_CHUNK_SIZE;
+        const IndexMask chunk_indices = indices.slice(
+            chunk_start, std::min(GATHER_INSTANCES_CHUNK_SIZE, indices.size() - chunk_start));
+        InstanceContext instance_context = base_instance_context;
+        chunk_indices.foreach_index(
+            [&](const int i) { gather_instance(chunk_info, instance_context, i); });
+      }
+    });
+    if (batch_start == 0) {
+      reserve_estimated_tasks(gather_info,
+                              chunk_infos,
+                              std::min(batch.size() * GATHER_INSTANCES_CHUNK_SIZE, indices.size()),
+                              indices.size());
+    }
+    join_gathered_chunks(gather_info, chunk_infos, chunk_temporary_arrays);
+  }
 }
 
 /**
@@ -825,12 +998,15 @@ static void gather_attribute_propagation_components_with_custom_depths(
   const Span<bke::InstanceReference> references = instances->references();
   const Span<int> handles = instances->reference_handles();
   const int references_num = references.size();
-  Array<std::optional<int>> max_reference_depth(references_num, 0);
-
-  varied_depth_option.selection.foreach_index([&](const int instance_i) {
+  /* The maximum depth per reference is computed per thread first, because there may be millions
+   * of selected instances. No value means that the reference is realized completely. */
+  threading::EnumerableThreadSpecific<Array<std::optional<int>>> max_reference_depth_by_thread(
+      [&]() { return Array<std::optional<int>>(references_num, 0); });
+  varied_depth_option.selection.foreach_index(GrainSize(4096), [&](const int instance_i) {
+    Array<std::optional<int>> &local_max_reference_depth = max_reference_depth_by_thread.local();
     const int reference_i = handles[instance_i];
     const int instance_depth = varied_depth_option.depths[instance_i];
-    std::optional<int> &max_depth = max_reference_depth[reference_i];
+    std::optional<int> &max_depth = local_max_reference_depth[reference_i];
     if (!max_depth.has_value()) {
       /* Is already at max depth. */
       return;
@@ -842,6 +1018,20 @@ static void gather_attribute_propagation_components_with_custom_depths(
     max_depth = std::max<int>(*max_depth, instance_depth);
   });
 
+  Array<std::optional<int>> max_reference_depth(references_num, 0);
+  for (const Array<std::optional<int>> &local_max_reference_depth : max_reference_depth_by_thread)
+  {
+    for (const int reference_i : IndexRange(references_num)) {
+      std::optional<int> &max_depth = max_reference_depth[reference_i];
+      const std::optional<int> &local_max_depth = local_max_reference_depth[reference_i];
+      if (!max_depth.has_value() || !local_max_depth.has_value()) {
+        max_depth.reset();
+        continue;
+      }
+      max_depth = std::max<int>(*max_depth, *local_max_depth);
+    }
+  }
+
   bool is_anything_realized = false;
   for (const int reference_i : IndexRange(references_num)) {
     const std::optional<int> max_depth = max_reference_depth[reference_i];
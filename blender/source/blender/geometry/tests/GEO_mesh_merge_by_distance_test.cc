@@ -0,0 +1,91 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+#include "BLI_kdtree.h"
+#include "BLI_rand.hh"
+
+#include "DNA_mesh_types.h"
+
+#include "GEO_mesh_merge_by_distance.hh"
+
+#include "testing/testing.h"
+
+namespace blender::geometry::tests {
+
+class mesh_merge_by_distance : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+/** Merge with a merge map from the kd-tree, which is the reference for the grid. */
+static Mesh *merge_by_distance_kdtree(const Mesh &mesh,
+                                      const IndexMask &selection,
+                                      const float merge_distance)
+{
+  const Span<float3> positions = mesh.vert_positions();
+  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+  selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
+  BLI_kdtree_3d_balance(tree);
+  Array<int> vert_dest_map(mesh.verts_num, -1);
+  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
+      tree, merge_distance, true, vert_dest_map.data());
+  BLI_kdtree_3d_free(tree);
+  if (vert_kill_len == 0) {
+    return nullptr;
+  }
+  return mesh_merge_verts(mesh, vert_dest_map, vert_kill_len, true);
+}
+
+/**
+ * Vertices on a lattice with the spacing of the merge distance lie exactly on the boundaries of
+ * the grid cells, and their neighbors are exactly at the merge distance. Random vertices in between
+ * make some of them merge into other targets.
+ */
+TEST_F(mesh_merge_by_distance, grid_matches_kdtree)
+{
+  const float merge_distance = 0.5f;
+  const int lattice_size = 6;
+  const int random_verts_num = 100;
+  const int lattice_verts_num = lattice_size * lattice_size * lattice_size;
+  Mesh *mesh = BKE_mesh_new_nomain(lattice_verts_num + random_verts_num, 0, 0, 0);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int z : IndexRange(lattice_size)) {
+    for (const int y : IndexRange(lattice_size)) {
+      for (const int x : IndexRange(lattice_size)) {
+        const int i = (z * lattice_size + y) * lattice_size + x;
+        positions[i] = float3(x, y, z) * merge_distance;
+      }
+    }
+  }
+  RandomNumberGenerator rng(0);
+  const float lattice_extent = float(lattice_size - 1) * merge_distance;
+  for (float3 &position : positions.drop_front(lattice_verts_num)) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float()) * lattice_extent;
+  }
+
+  IndexMaskMemory memory;
+  const IndexMask all_verts(mesh->verts_num);
+  const IndexMask odd_verts = IndexMask::from_predicate(
+      all_verts, GrainSize(1024), memory, [](const int64_t i) { return i % 2 == 1; });
+  for (const IndexMask &selection : {all_verts, odd_verts}) {
+    std::optional<Mesh *> result = mesh_merge_by_distance_all(*mesh, selection, merge_distance);
+    Mesh *result_reference = merge_by_distance_kdtree(*mesh, selection, merge_distance);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_NE(result_reference, nullptr);
+    EXPECT_EQ((*result)->verts_num, result_reference->verts_num);
+    EXPECT_EQ((*result)->vert_positions(), result_reference->vert_positions());
+    BKE_id_free(nullptr, *result);
+    BKE_id_free(nullptr, result_reference);
+  }
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace blender::geometry::tests
@@ -0,0 +1,105 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "BKE_attribute.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_idtype.hh"
+#include "BKE_instances.hh"
+#include "BKE_pointcloud.hh"
+
+#include "BLI_math_matrix.hh"
+
+#include "DNA_pointcloud_types.h"
+
+#include "GEO_realize_instances.hh"
+
+#include "testing/testing.h"
+
+namespace blender::geometry::tests {
+
+class realize_instances_gather : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+/** Point cloud with a few points, instanced many times. */
+static bke::GeometrySet create_instanced_points()
+{
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(3);
+  MutableSpan<float3> positions = pointcloud->positions_for_write();
+  positions[0] = float3(0.0f, 0.0f, 0.0f);
+  positions[1] = float3(1.0f, 0.0f, 0.0f);
+  positions[2] = float3(0.0f, 0.0f, 1.0f);
+  return bke::GeometrySet::from_pointcloud(pointcloud);
+}
+
+/** Instances with an id and a float attribute which both depend on the instance index. */
+static bke::GeometrySet create_instances(const bke::GeometrySet &reference,
+                                         const IndexRange instances_range)
+{
+  std::unique_ptr<bke::Instances> instances = std::make_unique<bke::Instances>();
+  const int handle = instances->add_new_reference(bke::InstanceReference(reference));
+  instances->resize(instances_range.size());
+  instances->reference_handles_for_write().fill(handle);
+  MutableSpan<float4x4> transforms = instances->transforms_for_write();
+  bke::MutableAttributeAccessor attributes = instances->attributes_for_write();
+  bke::SpanAttributeWriter<int> ids = attributes.lookup_or_add_for_write_only_span<int>(
+      "id", bke::AttrDomain::Instance);
+  bke::SpanAttributeWriter<float> values = attributes.lookup_or_add_for_write_only_span<float>(
+      "value", bke::AttrDomain::Instance);
+  for (const int i : instances_range.index_range()) {
+    const int instance = instances_range[i];
+    transforms[i] = math::from_location<float4x4>(float3(0.0f, float(instance), 0.0f));
+    ids.span[i] = instance * 3 + 1;
+    values.span[i] = float(instance) * 0.5f;
+  }
+  ids.finish();
+  values.finish();
+  return bke::GeometrySet::from_instances(instances.release());
+}
+
+/**
+ * Many instances are gathered in parallel chunks. The result has to be the same as when the
+ * instances are gathered serially, which is the case for small numbers of instances.
+ */
+TEST_F(realize_instances_gather, parallel_gather_matches_serial)
+{
+  /* More instances than fit into a single batch of parallel chunks. */
+  const int instances_num = 20000;
+  const int serial_instances_num = 200;
+  const bke::GeometrySet reference = create_instanced_points();
+  const int reference_points_num = reference.get_pointcloud()->totpoint;
+
+  const RealizeInstancesOptions options;
+  const bke::GeometrySet realized = realize_instances(
+      create_instances(reference, IndexRange(instances_num)), options);
+  const PointCloud *pointcloud = realized.get_pointcloud();
+  ASSERT_NE(pointcloud, nullptr);
+  ASSERT_EQ(pointcloud->totpoint, instances_num * reference_points_num);
+  const bke::AttributeAccessor attributes = pointcloud->attributes();
+  const Span<float3> positions = pointcloud->positions();
+  const VArraySpan<int> ids = *attributes.lookup<int>("id");
+  const VArraySpan<float> values = *attributes.lookup<float>("value");
+  ASSERT_FALSE(ids.is_empty());
+  ASSERT_FALSE(values.is_empty());
+
+  for (int start = 0; start < instances_num; start += serial_instances_num) {
+    const IndexRange instances_range(start, serial_instances_num);
+    const bke::GeometrySet serial_realized = realize_instances(
+        create_instances(reference, instances_range), options);
+    const PointCloud *serial_pointcloud = serial_realized.get_pointcloud();
+    ASSERT_NE(serial_pointcloud, nullptr);
+    const bke::AttributeAccessor serial_attributes = serial_pointcloud->attributes();
+    const IndexRange points_range(start * reference_points_num,
+                                  serial_instances_num * reference_points_num);
+    EXPECT_EQ(positions.slice(points_range), serial_pointcloud->positions());
+    EXPECT_EQ(ids.slice(points_range), VArraySpan(*serial_attributes.lookup<int>("id")));
+    EXPECT_EQ(values.slice(points_range), VArraySpan(*serial_attributes.lookup<float>("value")));
+  }
+}
+
+}  // namespace blender::geometry::tests
@@ -1053,9 +1053,12 @@ typedef enum IDRecalcFlag {
    * changed, and the shader is to be recompiled.
    * For objects it means that the draw batch cache is to be redone. */
   ID_RECALC_SHADING = (1 << 7),
-  /* TODO(sergey): Consider adding an explicit ID_RECALC_SHADING_PARAMETERS
-   * which can be used for cases when only socket value changed, to speed up
-   * redraw update in that case. */
+  /* Only plain settings of a material itself changed (for example its viewport display color),
+   * not its node tree. Updates the same as #ID_RECALC_SHADING, but only these settings are
+   * synchronized to the evaluated material instead of copying the whole material again.
+   *
+   * TODO(sergey): Consider using this for cases when only socket value changed as well. */
+  ID_RECALC_SHADING_PARAMETERS = (1 << 8),
 
   /* Selection of the ID itself or its components (for example, vertices) did
    * change, and all the drawing data is to be updated. */
@@ -1098,6 +1101,11 @@ typedef enum IDRecalcFlag {
    * have to be copied on every update. */
   ID_RECALC_PARAMETERS = (1 << 21),
 
+  /* Only transform channels of an object changed: location, rotation, scale, their deltas,
+   * rotation mode and locks. Updates the same as #ID_RECALC_TRANSFORM, but only these channels
+   * are synchronized to the evaluated object instead of copying the whole object again. */
+  ID_RECALC_TRANSFORM_CHANNELS = (1 << 22),
+
   /* Input has changed and data-block is to be reload from disk.
    * Applies to movie clips to inform that copy-on-written version is to be refreshed for the new
    * input file or for color space changes. */
@@ -2477,7 +2477,18 @@ typedef struct NodesModifierBake {
   NodesModifierDataBlock *data_blocks;
   NodesModifierPackedBake *packed;
 
-  void *_pad2;
+  /**
+   * Positions and velocities are rounded to a step of the largest power of two not larger than
+   * this distance when baking, if `NODES_MODIFIER_BAKE_COMPRESS` or
+   * `NODES_MODIFIER_BAKE_COMPRESS_MEMORY_CACHE` is set and the value is positive.
+   */
+  float quantize_precision;
+  /**
+   * Maximum size of the compressed simulation cache in memory in megabytes. When it is exceeded,
+   * cached frames are thinned out. Zero means that there is no limit. Only used when
+   * `NODES_MODIFIER_BAKE_COMPRESS_MEMORY_CACHE` is set.
+   */
+  int memory_cache_limit;
   int64_t bake_size;
 } NodesModifierBake;
 
@@ -2495,6 +2506,10 @@ typedef enum NodesModifierPanelFlag {
 typedef enum NodesModifierBakeFlag {
   NODES_MODIFIER_BAKE_CUSTOM_SIMULATION_FRAME_RANGE = 1 << 0,
   NODES_MODIFIER_BAKE_CUSTOM_PATH = 1 << 1,
+  /** Compress baked data with zstd. */
+  NODES_MODIFIER_BAKE_COMPRESS = 1 << 2,
+  /** Keep simulation frames that are cached in memory compressed. */
+  NODES_MODIFIER_BAKE_COMPRESS_MEMORY_CACHE = 1 << 3,
 } NodesModifierBakeFlag;
 
 typedef enum NodesModifierBakeTarget {
@@ -2515,6 +2530,7 @@ typedef enum GeometryNodesModifierPanel {
   NODES_MODIFIER_PANEL_NAMED_ATTRIBUTES = 3,
   NODES_MODIFIER_PANEL_BAKE_DATA_BLOCKS = 4,
   NODES_MODIFIER_PANEL_WARNINGS = 5,
+  NODES_MODIFIER_PANEL_TIMELINE = 6,
 } GeometryNodesModifierPanel;
 
 typedef struct NodesModifierData {
@@ -2548,6 +2564,8 @@ typedef struct NodesModifierData {
 
 typedef enum NodesModifierFlag {
   NODES_MODIFIER_HIDE_DATABLOCK_SELECTOR = (1 << 0),
+  /** Record when and on which thread each node is evaluated, for profiling. */
+  NODES_MODIFIER_RECORD_TIMELINE = (1 << 1),
 } NodesModifierFlag;
 
 typedef struct MeshToVolumeModifierData {
@@ -762,7 +762,10 @@ typedef struct UserDef_Experimental {
   char use_new_volume_nodes;
   char use_new_file_import_nodes;
   char use_shader_node_previews;
-  char _pad[5];
+  char use_geometry_nodes_memoization;
+  char use_depsgraph_critical_path_scheduling;
+  char use_depsgraph_incremental_relations;
+  char _pad[2];
 } UserDef_Experimental;
 
 #define USER_EXPERIMENTAL_TEST(userdef, member) \
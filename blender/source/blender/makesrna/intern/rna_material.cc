@@ -136,7 +136,8 @@ static void rna_Material_draw_update(Main * /*bmain*/, Scene * /*scene*/, Pointe
 {
   Material *ma = (Material *)ptr->owner_id;
 
-  DEG_id_tag_update(&ma->id, ID_RECALC_SHADING);
+  /* Only settings of the material itself are changed, not its node tree. */
+  DEG_id_tag_update(&ma->id, ID_RECALC_SHADING_PARAMETERS);
   WM_main_add_notifier(NC_MATERIAL | ND_SHADING_DRAW, ma);
 }
 
@@ -945,7 +945,7 @@ static void rna_Modifier_update(Main * /*bmain*/, Scene * /*scene*/, PointerRNA
 static void rna_Modifier_dependency_update(Main *bmain, Scene *scene, PointerRNA *ptr)
 {
   rna_Modifier_update(bmain, scene, ptr);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_id(bmain, ptr->owner_id);
 }
 
 static void rna_NodesModifier_bake_update(Main *bmain, Scene *scene, PointerRNA *ptr)
@@ -7960,6 +7960,39 @@ static void rna_def_modifier_nodes_bake(BlenderRNA *brna)
       prop, "Custom Path", "Specify a path where the baked data should be stored manually");
   RNA_def_property_update(prop, 0, "rna_NodesModifier_bake_update");
 
+  prop = RNA_def_property(srna, "use_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", NODES_MODIFIER_BAKE_COMPRESS);
+  RNA_def_property_ui_text(
+      prop, "Compress", "Compress the baked data to reduce its size on disk and in memory");
+  RNA_def_property_update(prop, 0, "rna_NodesModifier_bake_update");
+
+  prop = RNA_def_property(srna, "quantize_precision", PROP_FLOAT, PROP_DISTANCE);
+  RNA_def_property_range(prop, 0.0f, FLT_MAX);
+  RNA_def_property_ui_range(prop, 0.0f, 1.0f, 0.01, 5);
+  RNA_def_property_ui_text(prop,
+                           "Quantize Precision",
+                           "Round baked positions and velocities so that they compress better. "
+                           "The rounding step is the largest power of two not larger than this "
+                           "distance. Zero keeps the full precision");
+  RNA_def_property_update(prop, 0, "rna_NodesModifier_bake_update");
+
+  prop = RNA_def_property(srna, "use_memory_cache_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", NODES_MODIFIER_BAKE_COMPRESS_MEMORY_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "Compress Cache",
+                           "Keep simulation frames cached in memory compressed. Frames are stored "
+                           "as difference to a previous keyframe to use less memory");
+  RNA_def_property_update(prop, 0, "rna_NodesModifier_bake_update");
+
+  prop = RNA_def_property(srna, "memory_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_text(prop,
+                           "Memory Limit",
+                           "Maximum memory used by the compressed simulation cache in megabytes. "
+                           "Cached frames are thinned out when it is exceeded. Zero means that "
+                           "there is no limit");
+  RNA_def_property_update(prop, 0, "rna_NodesModifier_bake_update");
+
   prop = RNA_def_property(srna, "bake_target", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_items(prop, bake_target_in_node_items);
   RNA_def_property_ui_text(prop, "Bake Target", "Where to store the baked data");
@@ -8112,6 +8145,14 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE);
   RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, nullptr);
 
+  prop = RNA_def_property(srna, "use_timeline_recording", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", NODES_MODIFIER_RECORD_TIMELINE);
+  RNA_def_property_ui_text(prop,
+                           "Record Timeline",
+                           "Record when and on which thread each node is evaluated, and how much "
+                           "memory its output geometries use. This adds some overhead");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   prop = RNA_def_property(srna, "node_warnings", PROP_COLLECTION, PROP_NONE);
   RNA_def_property_collection_funcs(prop,
                                     "rna_NodesModifier_node_warnings_iterator_begin",
@@ -8133,6 +8174,7 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   rna_def_modifier_panel_open_prop(
       srna, "open_bake_data_blocks_panel", NODES_MODIFIER_PANEL_BAKE_DATA_BLOCKS);
   rna_def_modifier_panel_open_prop(srna, "open_warnings_panel", NODES_MODIFIER_PANEL_WARNINGS);
+  rna_def_modifier_panel_open_prop(srna, "open_timeline_panel", NODES_MODIFIER_PANEL_TIMELINE);
 
   RNA_define_lib_overridable(false);
 }
@@ -7605,6 +7605,25 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       prop, "Shader Node Previews", "Enables previews in the shader node editor");
   RNA_def_property_update(prop, 0, "rna_userdef_ui_update");
 
+  prop = RNA_def_property(srna, "use_geometry_nodes_memoization", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Geometry Nodes Memoization",
+                           "Reuse the outputs of expensive geometry nodes across evaluations when "
+                           "their inputs did not change");
+
+  prop = RNA_def_property(
+      srna, "use_depsgraph_critical_path_scheduling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Critical Path Scheduling",
+                           "Evaluate dependency graph operations on the longest chain of "
+                           "dependent operations first, based on timings of previous evaluations");
+
+  prop = RNA_def_property(srna, "use_depsgraph_incremental_relations", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Incremental Relations Update",
+                           "Only rebuild dependency graph relations around data-blocks whose "
+                           "dependencies changed, instead of rebuilding the whole graph");
+
   prop = RNA_def_property(srna, "use_extensions_debug", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_ui_text(
       prop,
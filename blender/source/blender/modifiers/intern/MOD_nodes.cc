@@ -1108,6 +1108,11 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
   bake::ModifierCache *modifier_cache_;
   float fps_;
   bool has_invalid_simulation_ = false;
+  /**
+   * Decompressed states of compressed cached frames that are read by this evaluation. They are
+   * kept alive until the evaluation is done, because the zone behaviors reference their items.
+   */
+  mutable Vector<std::shared_ptr<const bake::BakeState>> decompressed_states_;
 
  public:
   struct DataPerZone {
@@ -1265,7 +1270,7 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
             node_cache.cache_status = bake::CacheStatus::Invalid;
           }
           this->input_pass_through(zone_behavior);
-          this->output_store_frame_cache(node_cache, zone_behavior);
+          this->output_store_frame_cache(bake, node_cache, zone_behavior);
           return;
         }
         if (frame_indices.prev && !frame_indices.current && !frame_indices.next &&
@@ -1273,15 +1278,15 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
         {
           /* Read the previous frame's data and store the newly computed simulation state. */
           auto &output_copy_info = zone_behavior.input.emplace<sim_input::OutputCopy>();
-          const bake::FrameCache &prev_frame_cache = *node_cache.bake.frames[*frame_indices.prev];
+          bake::FrameCache &prev_frame_cache = *node_cache.bake.frames[*frame_indices.prev];
           const float real_delta_frames = float(current_frame_) - float(prev_frame_cache.frame);
           if (real_delta_frames != 1) {
             node_cache.cache_status = bake::CacheStatus::Invalid;
           }
           const float delta_frames = std::min(max_delta_frames, real_delta_frames);
           output_copy_info.delta_time = delta_frames / fps_;
-          output_copy_info.state = prev_frame_cache.state;
-          this->output_store_frame_cache(node_cache, zone_behavior);
+          output_copy_info.state = this->load_frame_state(node_cache.bake, prev_frame_cache);
+          this->output_store_frame_cache(bake, node_cache, zone_behavior);
           return;
         }
       }
@@ -1340,18 +1345,29 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
     zone_behavior.output.emplace<sim_output::PassThrough>();
   }
 
-  void output_store_frame_cache(bake::SimulationNodeCache &node_cache,
+  void output_store_frame_cache(const NodesModifierBake &bake,
+                                bake::SimulationNodeCache &node_cache,
                                 nodes::SimulationZoneBehavior &zone_behavior) const
   {
+    std::optional<bake::FrameCacheCompression> compression;
+    if (bake.flag & NODES_MODIFIER_BAKE_COMPRESS_MEMORY_CACHE) {
+      compression.emplace();
+      compression->quantize_precision = bake.quantize_precision;
+      compression->memory_limit = int64_t(bake.memory_cache_limit) * 1024 * 1024;
+    }
     auto &store_new_state_info = zone_behavior.output.emplace<sim_output::StoreNewState>();
     store_new_state_info.store_fn = [simulation_cache = modifier_cache_,
                                      node_cache = &node_cache,
-                                     current_frame = current_frame_](bke::bake::BakeState state) {
+                                     current_frame = current_frame_,
+                                     compression](bke::bake::BakeState state) {
       std::lock_guard lock{simulation_cache->mutex};
       auto frame_cache = std::make_unique<bake::FrameCache>();
       frame_cache->frame = current_frame;
       frame_cache->state = std::move(state);
       node_cache->bake.frames.append(std::move(frame_cache));
+      if (compression) {
+        bake::compress_frame_caches(node_cache->bake, *compression);
+      }
     };
   }
 
@@ -1371,6 +1387,27 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
     };
   }
 
+  /**
+   * Get the state of a cached frame, loading or decompressing it if necessary. A decompressed
+   * state is kept alive until the end of this evaluation.
+   */
+  const bake::BakeState &load_frame_state(bake::NodeBakeCache &bake_cache,
+                                          bake::FrameCache &frame_cache) const
+  {
+    if (frame_cache.compressed_state) {
+      std::shared_ptr<const bake::BakeState> state = bake::ensure_frame_cache_decompressed(
+          frame_cache);
+      if (!state) {
+        static const bake::BakeState empty_state;
+        return empty_state;
+      }
+      decompressed_states_.append(state);
+      return *state;
+    }
+    ensure_bake_loaded(bake_cache, frame_cache);
+    return frame_cache.state;
+  }
+
   void read_from_cache(const BakeFrameIndices &frame_indices,
                        bake::SimulationNodeCache &node_cache,
                        nodes::SimulationZoneBehavior &zone_behavior) const
@@ -1381,7 +1418,7 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
       const float delta_frames = std::min(max_delta_frames,
                                           float(current_frame_) - float(frame_cache.frame));
       output_copy_info.delta_time = delta_frames / fps_;
-      output_copy_info.state = frame_cache.state;
+      output_copy_info.state = this->load_frame_state(node_cache.bake, frame_cache);
     }
     else {
       zone_behavior.input.emplace<sim_input::PassThrough>();
@@ -1411,9 +1448,8 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
                    nodes::SimulationZoneBehavior &zone_behavior) const
   {
     bake::FrameCache &frame_cache = *node_cache.bake.frames[frame_index];
-    ensure_bake_loaded(node_cache.bake, frame_cache);
     auto &read_single_info = zone_behavior.output.emplace<sim_output::ReadSingle>();
-    read_single_info.state = frame_cache.state;
+    read_single_info.state = this->load_frame_state(node_cache.bake, frame_cache);
   }
 
   void read_interpolated(const int prev_frame_index,
@@ -1423,14 +1459,12 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
   {
     bake::FrameCache &prev_frame_cache = *node_cache.bake.frames[prev_frame_index];
     bake::FrameCache &next_frame_cache = *node_cache.bake.frames[next_frame_index];
-    ensure_bake_loaded(node_cache.bake, prev_frame_cache);
-    ensure_bake_loaded(node_cache.bake, next_frame_cache);
     auto &read_interpolated_info = zone_behavior.output.emplace<sim_output::ReadInterpolated>();
     read_interpolated_info.mix_factor = (float(current_frame_) - float(prev_frame_cache.frame)) /
                                         (float(next_frame_cache.frame) -
                                          float(prev_frame_cache.frame));
-    read_interpolated_info.prev_state = prev_frame_cache.state;
-    read_interpolated_info.next_state = next_frame_cache.state;
+    read_interpolated_info.prev_state = this->load_frame_state(node_cache.bake, prev_frame_cache);
+    read_interpolated_info.next_state = this->load_frame_state(node_cache.bake, next_frame_cache);
   }
 };
 
@@ -1828,6 +1862,7 @@ static void modifyGeometry(ModifierData *md,
   Set<ComputeContextHash> socket_log_contexts;
   if (logging_enabled(ctx)) {
     call_data.eval_log = eval_log.get();
+    eval_log->record_timeline = nmd->flag & NODES_MODIFIER_RECORD_TIMELINE;
 
     find_socket_log_contexts(*nmd, *ctx, socket_log_contexts);
     call_data.socket_log_contexts = &socket_log_contexts;
@@ -2437,6 +2472,71 @@ static void draw_named_attributes_panel(uiLayout *layout, NodesModifierData &nmd
   }
 }
 
+static void draw_timeline_panel(uiLayout *layout,
+                                PointerRNA *modifier_ptr,
+                                NodesModifierData &nmd)
+{
+  uiItemR(layout, modifier_ptr, "use_timeline_recording", UI_ITEM_NONE, std::nullopt, ICON_NONE);
+  if (!(nmd.flag & NODES_MODIFIER_RECORD_TIMELINE)) {
+    return;
+  }
+  if (G.is_rendering) {
+    /* Avoid accessing this data while baking in a separate thread. */
+    return;
+  }
+  if (!nmd.runtime->eval_log) {
+    return;
+  }
+  const geo_log::GeoModifierLog::TimelineSummary &summary =
+      nmd.runtime->eval_log->get_timeline_summary();
+  if (summary.critical_path.is_empty()) {
+    uiItemL(layout, RPT_("No timeline recorded"), ICON_INFO);
+    return;
+  }
+
+  auto to_ms = [](const std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+  const double wall_time_ms = to_ms(summary.wall_time);
+  const double node_time_ms = to_ms(summary.node_time);
+
+  uiLayout *col = uiLayoutColumn(layout, true);
+  uiItemL(col, fmt::format(fmt::runtime(RPT_("Wall Time: {:.2f} ms")), wall_time_ms), ICON_NONE);
+  uiItemL(col, fmt::format(fmt::runtime(RPT_("Node Time: {:.2f} ms")), node_time_ms), ICON_NONE);
+  uiItemL(col,
+          fmt::format(fmt::runtime(RPT_("Parallelism: {:.1f} on {} threads")),
+                      wall_time_ms > 0.0 ? node_time_ms / wall_time_ms : 0.0,
+                      summary.threads_num),
+          ICON_NONE);
+
+  /* Show the nodes on the critical path that take the most time. */
+  Vector<geo_log::GeoModifierLog::TimelineSummary::PathNode> path_nodes = summary.critical_path;
+  std::sort(path_nodes.begin(), path_nodes.end(), [](const auto &a, const auto &b) {
+    return a.duration > b.duration;
+  });
+  col = uiLayoutColumn(layout, true);
+  uiItemL(col, RPT_("Critical Path:"), ICON_NONE);
+  for (const auto &path_node : path_nodes.as_span().take_front(5)) {
+    uiLayout *split = uiLayoutSplit(col, 0.4f, false);
+    uiLayout *row = uiLayoutRow(split, false);
+    uiLayoutSetAlignment(row, UI_LAYOUT_ALIGN_RIGHT);
+    uiLayoutSetActive(row, false);
+    uiItemL(row, fmt::format("{:.2f} ms", to_ms(path_node.duration)), ICON_NONE);
+    uiItemL(split, path_node.node_name, ICON_NONE);
+  }
+
+  PointerRNA props;
+  uiItemFullO(layout,
+              "object.geometry_nodes_timeline_export",
+              IFACE_("Export Chrome Trace"),
+              ICON_EXPORT,
+              nullptr,
+              WM_OP_INVOKE_DEFAULT,
+              UI_ITEM_NONE,
+              &props);
+  RNA_string_set(&props, "modifier_name", nmd.modifier.name);
+}
+
 static void draw_manage_panel(const bContext *C,
                               uiLayout *layout,
                               PointerRNA *modifier_ptr,
@@ -2452,6 +2552,11 @@ static void draw_manage_panel(const bContext *C,
   {
     draw_named_attributes_panel(panel_layout, nmd);
   }
+  if (uiLayout *panel_layout = uiLayoutPanelProp(
+          C, layout, modifier_ptr, "open_timeline_panel", IFACE_("Timeline")))
+  {
+    draw_timeline_panel(panel_layout, modifier_ptr, nmd);
+  }
 }
 
 static void draw_warnings(const bContext *C,
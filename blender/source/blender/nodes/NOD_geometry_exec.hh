@@ -80,6 +80,12 @@ class GeoNodeExecParams {
   const FunctionRef<std::string(int)> get_output_attribute_id_;
 
  public:
+  /**
+   * When set, warnings added with #error_message_add are stored here as well, e.g. so that they
+   * can be logged again when the outputs of the node are reused without executing it.
+   */
+  Vector<geo_eval_log::NodeWarning> *r_warnings = nullptr;
+
   GeoNodeExecParams(const bNode &node,
                     lf::Params &params,
                     const lf::Context &lf_context,
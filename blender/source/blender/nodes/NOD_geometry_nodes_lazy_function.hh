@@ -524,8 +524,12 @@ class ScopedNodeTimer {
     auto &local_user_data = static_cast<GeoNodesLFLocalUserData &>(*context_.local_user_data);
     if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(user_data))
     {
+      StringRefNull node_name;
+      if (user_data.call_data->eval_log->record_timeline) {
+        node_name = tree_logger->allocator->copy_string(node_.name);
+      }
       tree_logger->node_execution_times.append(*tree_logger->allocator,
-                                               {node_.identifier, start_, end});
+                                               {node_.identifier, start_, end, node_name});
     }
   }
 };
@@ -28,13 +28,16 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <optional>
 
 #include "BLI_compute_context.hh"
 #include "BLI_enumerable_thread_specific.hh"
 #include "BLI_generic_pointer.hh"
 #include "BLI_linear_allocator_chunked_list.hh"
 #include "BLI_multi_value_map.hh"
+#include "BLI_serialize.hh"
 
 #include "BKE_geometry_set.hh"
 #include "BKE_node.hh"
@@ -198,11 +201,17 @@ using TimePoint = Clock::time_point;
  */
 class GeoTreeLogger {
  public:
+  ComputeContextHash context_hash;
   std::optional<ComputeContextHash> parent_hash;
   std::optional<int32_t> parent_node_id;
   Vector<ComputeContextHash> children_hashes;
   /** The time spend in the compute context that this logger corresponds to. */
   std::chrono::nanoseconds execution_time{};
+  /**
+   * Loggers are thread-local. This identifies the thread that owns the logger in the recorded
+   * timeline.
+   */
+  int thread_index = 0;
 
   LinearAllocator<> *allocator = nullptr;
 
@@ -219,6 +228,15 @@ class GeoTreeLogger {
     int32_t node_id;
     TimePoint start;
     TimePoint end;
+    /** Only set when the timeline is recorded, because the node may be gone when it's exported. */
+    StringRefNull node_name;
+  };
+  struct OutputMemoryUsage {
+    int32_t node_id;
+    StringRefNull socket_name;
+    /** Size of the output value, excluding data that is shared with the node inputs. */
+    int64_t bytes;
+    TimePoint time;
   };
   struct ViewerNodeLogWithNode {
     int32_t node_id;
@@ -241,6 +259,8 @@ class GeoTreeLogger {
   linear_allocator::ChunkedList<SocketValueLog, 16> input_socket_values;
   linear_allocator::ChunkedList<SocketValueLog, 16> output_socket_values;
   linear_allocator::ChunkedList<NodeExecutionTime, 16> node_execution_times;
+  /** Only logged when the timeline is recorded. */
+  linear_allocator::ChunkedList<OutputMemoryUsage> output_memory_usages;
   linear_allocator::ChunkedList<ViewerNodeLogWithNode> viewer_node_logs;
   linear_allocator::ChunkedList<AttributeUsageWithNode> used_named_attributes;
   linear_allocator::ChunkedList<DebugMessage> debug_messages;
@@ -355,6 +375,8 @@ class GeoModifierLog {
   struct LocalData {
     /** Each thread has its own allocator. */
     LinearAllocator<> allocator;
+    /** Assigned when the first logger of the thread is created. */
+    int thread_index = -1;
     /**
      * Store a separate #GeoTreeLogger for each instance of the corresponding node group (e.g.
      * when the same node group is used multiple times).
@@ -368,6 +390,41 @@ class GeoModifierLog {
    * A #GeoTreeLog for every compute context. Those are created lazily when requested by UI code.
    */
   Map<ComputeContextHash, std::unique_ptr<GeoTreeLog>> tree_logs_;
+  /** Used to give every thread that logs something a small index for the timeline. */
+  std::atomic<int> threads_num_ = 0;
+
+ public:
+  /**
+   * When true, the start and end of every node execution is kept together with the thread it ran
+   * on, as well as the memory used by the node outputs. This is used to show where evaluation
+   * serializes, but adds some overhead.
+   */
+  bool record_timeline = false;
+
+  struct TimelineSummary {
+    /** Time from the start of the first to the end of the last node execution. */
+    std::chrono::nanoseconds wall_time{0};
+    /**
+     * Sum of the execution times of nodes, without the time spent in nested nodes. Nodes that
+     * contain other node executions (e.g. groups) are not counted, also when the nested nodes
+     * ran on other threads.
+     */
+    std::chrono::nanoseconds node_time{0};
+    int threads_num = 0;
+    struct PathNode {
+      StringRefNull node_name;
+      std::chrono::nanoseconds duration;
+    };
+    /**
+     * Chain of node executions that followed each other without a gap, ending at the last node
+     * that finished. Dependencies are not logged, so the chain is derived from the timestamps.
+     */
+    Vector<PathNode> critical_path;
+  };
+
+ private:
+  /** Computed by #get_timeline_summary when it is first requested. */
+  std::optional<TimelineSummary> timeline_summary_;
 
  public:
   GeoModifierLog();
@@ -383,6 +440,17 @@ class GeoModifierLog {
    */
   GeoTreeLog &get_tree_log(const ComputeContextHash &compute_context_hash);
 
+  /**
+   * Create a trace in the Chrome trace event format from the recorded timeline. It can be
+   * viewed with tools like `chrome://tracing` or Perfetto.
+   */
+  std::shared_ptr<io::serialize::DictionaryValue> timeline_to_chrome_trace();
+  /**
+   * The summary is computed on first access and then kept, because the log does not change
+   * anymore once the evaluation is done.
+   */
+  const TimelineSummary &get_timeline_summary();
+
   /**
    * Utility accessor to logged data.
    */
@@ -0,0 +1,62 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Expensive geometry nodes can opt into memoization of their outputs with
+ * #NodeDeclarationBuilder::memoize_outputs. Their outputs are then stored in the global
+ * #memory_cache, keyed on the node settings and the identity of the input values. Geometry inputs
+ * are identified by the implicit-sharing info and version of their data arrays, so unchanged
+ * geometry is recognized across evaluations, even though the #GeometrySet is rebuilt every time.
+ *
+ * This is an experimental feature that has to be enabled in the preferences.
+ */
+
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+#include "FN_lazy_function.hh"
+
+struct bNode;
+
+namespace blender::nodes::geo_eval_log {
+class GeoTreeLogger;
+struct NodeWarning;
+}  // namespace blender::nodes::geo_eval_log
+
+namespace blender::nodes {
+
+namespace lf = fn::lazy_function;
+
+/** Whether memoization of node outputs is enabled at all. */
+bool geometry_nodes_memoization_enabled();
+
+/**
+ * Evaluates a geometry node that supports memoization, or reuses previously computed outputs when
+ * the node was evaluated with the same settings and inputs before.
+ *
+ * \param fn: The lazy-function of the node. All its inputs are expected to be available.
+ * \param output_attribute_names: Names of anonymous attributes the node creates in its output
+ *   geometries. They depend on the evaluation context and are therefore part of the key.
+ * \param tree_logger: Receives the warnings the node added when its outputs were computed, if
+ *   the outputs are reused. May be null.
+ * \param execute_fn: Evaluates the node with the given parameters. Warnings the node adds have to
+ *   be appended to \a r_warnings as well, so that they are stored with the outputs.
+ * \return False if the node settings or inputs can't be used as key (e.g. because the inputs
+ *   contain fields). Nothing is evaluated in that case.
+ */
+bool execute_geometry_node_memoized(
+    const bNode &node,
+    const lf::LazyFunction &fn,
+    lf::Params &params,
+    Span<std::string> output_attribute_names,
+    geo_eval_log::GeoTreeLogger *tree_logger,
+    FunctionRef<void(lf::Params &params, Vector<geo_eval_log::NodeWarning> &r_warnings)>
+        execute_fn);
+
+}  // namespace blender::nodes
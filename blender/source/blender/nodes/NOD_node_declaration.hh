@@ -555,6 +555,12 @@ class NodeDeclaration {
    */
   bool is_context_dependent = false;
 
+  /**
+   * Outputs of the node only depend on its settings and inputs and are expensive to compute, so
+   * they may be reused across evaluations. See `NOD_geometry_nodes_memoization.hh`.
+   */
+  bool memoize_outputs = false;
+
   friend NodeDeclarationBuilder;
 
   /** Asserts that the declaration is considered valid. */
@@ -617,6 +623,11 @@ class NodeDeclarationBuilder : public DeclarationListBuilder {
 
   void use_custom_socket_order(bool enable = true);
   void allow_any_socket_order(bool enable = true);
+  /**
+   * Allow caching the node outputs across evaluations. The node storage is compared byte-wise,
+   * so it must not contain pointers.
+   */
+  void memoize_outputs(bool enable = true);
 
   aal::RelationsInNode &get_anonymous_attribute_relations()
   {
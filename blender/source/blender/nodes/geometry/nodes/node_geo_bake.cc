@@ -838,6 +838,20 @@ void draw_common_bake_settings(bContext *C, BakeDrawContext &ctx, uiLayout *layo
     uiItemR(subcol, &ctx.bake_rna, "frame_start", UI_ITEM_NONE, IFACE_("Start"), ICON_NONE);
     uiItemR(subcol, &ctx.bake_rna, "frame_end", UI_ITEM_NONE, IFACE_("End"), ICON_NONE);
   }
+  {
+    uiLayout *col = uiLayoutColumn(settings_col, true);
+    uiItemR(col, &ctx.bake_rna, "use_compression", UI_ITEM_NONE, IFACE_("Compress"), ICON_NONE);
+    uiLayout *subcol = uiLayoutColumn(col, true);
+    uiLayoutSetActive(subcol,
+                      ctx.bake->flag & (NODES_MODIFIER_BAKE_COMPRESS |
+                                        NODES_MODIFIER_BAKE_COMPRESS_MEMORY_CACHE));
+    uiItemR(subcol,
+            &ctx.bake_rna,
+            "quantize_precision",
+            UI_ITEM_NONE,
+            IFACE_("Quantize"),
+            ICON_NONE);
+  }
 }
 
 static void draw_bake_data_block_list_item(uiList * /*ui_list*/,
@@ -22,13 +22,14 @@ namespace blender::nodes::node_geo_convex_hull_cc {
 
 static void node_declare(NodeDeclarationBuilder &b)
 {
+  b.memoize_outputs();
   b.add_input<decl::Geometry>("Geometry");
   b.add_output<decl::Geometry>("Convex Hull");
 }
 
 #ifdef WITH_BULLET
 
-static Mesh *hull_from_bullet(const Mesh *mesh, Span<float3> coords)
+static Mesh *mesh_from_bullet_hull(const Mesh *mesh, Span<float3> coords)
 {
   plConvexHull hull = plConvexHullCompute((float(*)[3])coords.data(), coords.size());
 
@@ -132,6 +133,68 @@ static Mesh *hull_from_bullet(const Mesh *mesh, Span<float3> coords)
   return result;
 }
 
+/**
+ * Larger inputs are split into chunks of this size. Only points on the hull of a chunk can be on
+ * the hull of all points, so the hulls of the chunks are computed in parallel first.
+ */
+static constexpr int hull_chunk_size = 1 << 16;
+
+static Array<float3> hull_candidates_from_chunks(const Span<float3> coords)
+{
+  const int chunks_num = (coords.size() + hull_chunk_size - 1) / hull_chunk_size;
+  Array<Vector<float3>> chunk_hull_positions(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int chunk : range) {
+      const Span<float3> chunk_coords = coords.slice(
+          IndexRange(chunk * hull_chunk_size, hull_chunk_size).intersect(coords.index_range()));
+      plConvexHull hull = plConvexHullCompute((float(*)[3])chunk_coords.data(),
+                                              chunk_coords.size());
+      Vector<float3> &positions = chunk_hull_positions[chunk];
+      positions.resize(plConvexHullNumVertices(hull));
+      for (const int i : positions.index_range()) {
+        /* Copy the input positions, because the positions computed by Bullet are quantized. */
+        float3 hull_position;
+        int original_index;
+        plConvexHullGetVertex(hull, i, hull_position, &original_index);
+        positions[i] = chunk_coords.index_range().contains(original_index) ?
+                           chunk_coords[original_index] :
+                           hull_position;
+      }
+      plConvexHullDelete(hull);
+    }
+  });
+
+  Array<int> offset_data(chunks_num + 1);
+  for (const int chunk : IndexRange(chunks_num)) {
+    offset_data[chunk] = chunk_hull_positions[chunk].size();
+  }
+  const OffsetIndices offsets = offset_indices::accumulate_counts_to_offsets(offset_data);
+  Array<float3> candidates(offsets.total_size());
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int chunk : range) {
+      candidates.as_mutable_span().slice(offsets[chunk]).copy_from(chunk_hull_positions[chunk]);
+    }
+  });
+  return candidates;
+}
+
+static Mesh *hull_from_bullet(const Mesh *mesh, Span<float3> coords)
+{
+  /* Reduce the number of points in parallel while that removes a significant part of them. When
+   * most points are on the hull already, the final hull is computed from all remaining points. */
+  Array<float3> candidates;
+  while (coords.size() > hull_chunk_size * 2) {
+    Array<float3> new_candidates = hull_candidates_from_chunks(coords);
+    const bool is_reduced_significantly = new_candidates.size() < coords.size() / 2;
+    candidates = std::move(new_candidates);
+    coords = candidates;
+    if (!is_reduced_significantly) {
+      break;
+    }
+  }
+  return mesh_from_bullet_hull(mesh, coords);
+}
+
 static Mesh *compute_hull(const GeometrySet &geometry_set)
 {
   int span_count = 0;
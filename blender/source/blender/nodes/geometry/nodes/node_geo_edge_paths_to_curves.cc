@@ -20,49 +20,92 @@ static void node_declare(NodeDeclarationBuilder &b)
   b.add_output<decl::Geometry>("Curves").propagate_all();
 }
 
+/**
+ * Get the number of vertices in the path that starts at #first_vert. The path ends before a vertex
+ * would be visited a second time or when the next index is invalid. Brent's cycle detection is
+ * used, so that no visited state has to be stored per vertex and paths can be traced in parallel.
+ */
+static int path_verts_num(const int first_vert, const Span<int> next_indices)
+{
+  const int verts_num = next_indices.size();
+  auto next = [&](const int vert) {
+    const int next_vert = next_indices[vert];
+    return (next_vert < 0 || next_vert >= verts_num) ? -1 : next_vert;
+  };
+
+  /* Find the length of the cycle, or the end of the path if there is no cycle. */
+  int power = 1;
+  int cycle_length = 1;
+  int tortoise = first_vert;
+  int hare = next(first_vert);
+  int hare_index = 1;
+  while (hare != -1 && hare != tortoise) {
+    if (power == cycle_length) {
+      tortoise = hare;
+      power *= 2;
+      cycle_length = 0;
+    }
+    hare = next(hare);
+    cycle_length++;
+    hare_index++;
+  }
+  if (hare == -1) {
+    return hare_index;
+  }
+
+  /* Find the first vertex of the cycle. */
+  tortoise = first_vert;
+  hare = first_vert;
+  for ([[maybe_unused]] const int i : IndexRange(cycle_length)) {
+    hare = next(hare);
+  }
+  int cycle_start = 0;
+  while (tortoise != hare) {
+    tortoise = next(tortoise);
+    hare = next(hare);
+    cycle_start++;
+  }
+  return cycle_start + cycle_length;
+}
+
 static Curves *edge_paths_to_curves_convert(const Mesh &mesh,
                                             const IndexMask &start_verts_mask,
                                             const Span<int> next_indices,
                                             const AttributeFilter &attribute_filter)
 {
-  Vector<int> vert_indices;
-  Vector<int> curve_offsets;
-  Array<bool> visited(mesh.verts_num, false);
-  start_verts_mask.foreach_index([&](const int first_vert) {
-    const int second_vert = next_indices[first_vert];
-    if (first_vert == second_vert) {
-      return;
-    }
-    if (second_vert < 0 || second_vert >= mesh.verts_num) {
-      return;
-    }
+  IndexMaskMemory memory;
+  const IndexMask curve_start_verts = IndexMask::from_predicate(
+      start_verts_mask, GrainSize(4096), memory, [&](const int first_vert) {
+        const int second_vert = next_indices[first_vert];
+        return first_vert != second_vert && second_vert >= 0 && second_vert < mesh.verts_num;
+      });
+  if (curve_start_verts.is_empty()) {
+    return nullptr;
+  }
 
-    curve_offsets.append(vert_indices.size());
+  /* Trace every path twice, first to count its vertices, then to fill them in. */
+  Array<int> curve_offsets(curve_start_verts.size() + 1);
+  curve_start_verts.foreach_index(GrainSize(512), [&](const int first_vert, const int curve) {
+    curve_offsets[curve] = path_verts_num(first_vert, next_indices);
+  });
+  const OffsetIndices points_by_curve = offset_indices::accumulate_counts_to_offsets(
+      curve_offsets);
 
-    /* Iterate through path defined by #next_indices. */
+  Array<int> vert_indices(points_by_curve.total_size());
+  curve_start_verts.foreach_index(GrainSize(512), [&](const int first_vert, const int curve) {
     int current_vert = first_vert;
-    while (!visited[current_vert]) {
-      visited[current_vert] = true;
-      vert_indices.append(current_vert);
-      const int next_vert = next_indices[current_vert];
-      if (next_vert < 0 || next_vert >= mesh.verts_num) {
-        break;
-      }
-      current_vert = next_vert;
-    }
-
-    /* Reset visited status. */
-    const int points_in_curve_num = vert_indices.size() - curve_offsets.last();
-    for (const int vert_in_curve : vert_indices.as_span().take_back(points_in_curve_num)) {
-      visited[vert_in_curve] = false;
+    for (int &vert : vert_indices.as_mutable_span().slice(points_by_curve[curve])) {
+      vert = current_vert;
+      current_vert = next_indices[current_vert];
     }
   });
 
-  if (vert_indices.is_empty()) {
-    return nullptr;
-  }
-  Curves *curves_id = bke::curves_new_nomain(geometry::create_curve_from_vert_indices(
-      mesh.attributes(), vert_indices, curve_offsets, IndexRange(0), attribute_filter));
+  Curves *curves_id = bke::curves_new_nomain(
+      geometry::create_curve_from_vert_indices(mesh.attributes(),
+                                               vert_indices,
+                                               curve_offsets.as_span().drop_back(1),
+                                               IndexRange(0),
+                                               attribute_filter));
   return curves_id;
 }
 
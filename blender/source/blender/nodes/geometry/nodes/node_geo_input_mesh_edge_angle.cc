@@ -2,6 +2,7 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array_utils.hh"
 #include "BLI_math_vector.h"
 
 #include "BKE_mesh.hh"
@@ -53,6 +54,78 @@ static Array<EdgeMapEntry> create_edge_map(const OffsetIndices<int> faces,
   return edge_map;
 }
 
+static Array<float> calc_unsigned_angles(const Mesh &mesh)
+{
+  const Span<float3> positions = mesh.vert_positions();
+  const OffsetIndices faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  const Span<int> corner_edges = mesh.corner_edges();
+  Array<EdgeMapEntry> edge_map = create_edge_map(faces, corner_edges, mesh.edges_num);
+
+  auto angle_fn =
+      [edge_map = std::move(edge_map), positions, faces, corner_verts](const int i) -> float {
+    if (edge_map[i].face_count != 2) {
+      return 0.0f;
+    }
+    const IndexRange face_1 = faces[edge_map[i].face_index_1];
+    const IndexRange face_2 = faces[edge_map[i].face_index_2];
+    const float3 normal_1 = bke::mesh::face_normal_calc(positions, corner_verts.slice(face_1));
+    const float3 normal_2 = bke::mesh::face_normal_calc(positions, corner_verts.slice(face_2));
+    return angle_normalized_v3v3(normal_1, normal_2);
+  };
+
+  Array<float> angles(mesh.edges_num);
+  array_utils::copy(VArray<float>::ForFunc(mesh.edges_num, angle_fn), angles.as_mutable_span());
+  return angles;
+}
+
+static Array<float> calc_signed_angles(const Mesh &mesh)
+{
+  const Span<float3> positions = mesh.vert_positions();
+  const Span<int2> edges = mesh.edges();
+  const OffsetIndices faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  const Span<int> corner_edges = mesh.corner_edges();
+  Array<EdgeMapEntry> edge_map = create_edge_map(faces, corner_edges, mesh.edges_num);
+
+  auto angle_fn = [edge_map = std::move(edge_map), positions, edges, faces, corner_verts](
+                      const int i) -> float {
+    if (edge_map[i].face_count != 2) {
+      return 0.0f;
+    }
+    const IndexRange face_1 = faces[edge_map[i].face_index_1];
+    const IndexRange face_2 = faces[edge_map[i].face_index_2];
+
+    /* Find the normals of the 2 faces. */
+    const float3 face_1_normal = bke::mesh::face_normal_calc(positions,
+                                                             corner_verts.slice(face_1));
+    const float3 face_2_normal = bke::mesh::face_normal_calc(positions,
+                                                             corner_verts.slice(face_2));
+
+    /* Find the centerpoint of the axis edge */
+    const float3 edge_centerpoint = (positions[edges[i][0]] + positions[edges[i][1]]) * 0.5f;
+
+    /* Get the centerpoint of face 2 and subtract the edge centerpoint to get a tangent
+     * normal for face 2. */
+    const float3 face_center_2 = bke::mesh::face_center_calc(positions,
+                                                             corner_verts.slice(face_2));
+    const float3 face_2_tangent = math::normalize(face_center_2 - edge_centerpoint);
+    const float concavity = math::dot(face_1_normal, face_2_tangent);
+
+    /* Get the unsigned angle between the two faces */
+    const float angle = angle_normalized_v3v3(face_1_normal, face_2_normal);
+
+    if (angle == 0.0f || angle == 2.0f * M_PI || concavity < 0) {
+      return angle;
+    }
+    return -angle;
+  };
+
+  Array<float> angles(mesh.edges_num);
+  array_utils::copy(VArray<float>::ForFunc(mesh.edges_num, angle_fn), angles.as_mutable_span());
+  return angles;
+}
+
 class AngleFieldInput final : public bke::MeshFieldInput {
  public:
   AngleFieldInput() : bke::MeshFieldInput(CPPType::get<float>(), "Unsigned Angle Field")
@@ -64,25 +137,10 @@ class AngleFieldInput final : public bke::MeshFieldInput {
                                  const AttrDomain domain,
                                  const IndexMask & /*mask*/) const final
   {
-    const Span<float3> positions = mesh.vert_positions();
-    const OffsetIndices faces = mesh.faces();
-    const Span<int> corner_verts = mesh.corner_verts();
-    const Span<int> corner_edges = mesh.corner_edges();
-    Array<EdgeMapEntry> edge_map = create_edge_map(faces, corner_edges, mesh.edges_num);
-
-    auto angle_fn =
-        [edge_map = std::move(edge_map), positions, faces, corner_verts](const int i) -> float {
-      if (edge_map[i].face_count != 2) {
-        return 0.0f;
-      }
-      const IndexRange face_1 = faces[edge_map[i].face_index_1];
-      const IndexRange face_2 = faces[edge_map[i].face_index_2];
-      const float3 normal_1 = bke::mesh::face_normal_calc(positions, corner_verts.slice(face_1));
-      const float3 normal_2 = bke::mesh::face_normal_calc(positions, corner_verts.slice(face_2));
-      return angle_normalized_v3v3(normal_1, normal_2);
-    };
-
-    VArray<float> angles = VArray<float>::ForFunc(mesh.edges_num, angle_fn);
+    VArray<float> angles = bke::mesh::derived_data_lookup_or_compute<float>(
+        mesh, bke::MeshDerivedDataDependency::Positions, "edge_unsigned_angle", [&]() {
+          return calc_unsigned_angles(mesh);
+        });
     return mesh.attributes().adapt_domain<float>(std::move(angles), AttrDomain::Edge, domain);
   }
 
@@ -114,47 +172,10 @@ class SignedAngleFieldInput final : public bke::MeshFieldInput {
                                  const AttrDomain domain,
                                  const IndexMask & /*mask*/) const final
   {
-    const Span<float3> positions = mesh.vert_positions();
-    const Span<int2> edges = mesh.edges();
-    const OffsetIndices faces = mesh.faces();
-    const Span<int> corner_verts = mesh.corner_verts();
-    const Span<int> corner_edges = mesh.corner_edges();
-    Array<EdgeMapEntry> edge_map = create_edge_map(faces, corner_edges, mesh.edges_num);
-
-    auto angle_fn = [edge_map = std::move(edge_map), positions, edges, faces, corner_verts](
-                        const int i) -> float {
-      if (edge_map[i].face_count != 2) {
-        return 0.0f;
-      }
-      const IndexRange face_1 = faces[edge_map[i].face_index_1];
-      const IndexRange face_2 = faces[edge_map[i].face_index_2];
-
-      /* Find the normals of the 2 faces. */
-      const float3 face_1_normal = bke::mesh::face_normal_calc(positions,
-                                                               corner_verts.slice(face_1));
-      const float3 face_2_normal = bke::mesh::face_normal_calc(positions,
-                                                               corner_verts.slice(face_2));
-
-      /* Find the centerpoint of the axis edge */
-      const float3 edge_centerpoint = (positions[edges[i][0]] + positions[edges[i][1]]) * 0.5f;
-
-      /* Get the centerpoint of face 2 and subtract the edge centerpoint to get a tangent
-       * normal for face 2. */
-      const float3 face_center_2 = bke::mesh::face_center_calc(positions,
-                                                               corner_verts.slice(face_2));
-      const float3 face_2_tangent = math::normalize(face_center_2 - edge_centerpoint);
-      const float concavity = math::dot(face_1_normal, face_2_tangent);
-
-      /* Get the unsigned angle between the two faces */
-      const float angle = angle_normalized_v3v3(face_1_normal, face_2_normal);
-
-      if (angle == 0.0f || angle == 2.0f * M_PI || concavity < 0) {
-        return angle;
-      }
-      return -angle;
-    };
-
-    VArray<float> angles = VArray<float>::ForFunc(mesh.edges_num, angle_fn);
+    VArray<float> angles = bke::mesh::derived_data_lookup_or_compute<float>(
+        mesh, bke::MeshDerivedDataDependency::Positions, "edge_signed_angle", [&]() {
+          return calc_signed_angles(mesh);
+        });
     return mesh.attributes().adapt_domain<float>(std::move(angles), AttrDomain::Edge, domain);
   }
 
@@ -4,7 +4,7 @@
 
 #include "BLI_array_utils.hh"
 
-#include "DNA_mesh_types.h"
+#include "BKE_mesh.hh"
 
 #include "node_geometry_util.hh"
 
@@ -29,10 +29,13 @@ class EdgeNeighborCountFieldInput final : public bke::MeshFieldInput {
                                  const AttrDomain domain,
                                  const IndexMask & /*mask*/) const final
   {
-    Array<int> counts(mesh.edges_num, 0);
-    array_utils::count_indices(mesh.corner_edges(), counts);
-    return mesh.attributes().adapt_domain<int>(
-        VArray<int>::ForContainer(std::move(counts)), AttrDomain::Edge, domain);
+    VArray<int> counts = bke::mesh::derived_data_lookup_or_compute<int>(
+        mesh, bke::MeshDerivedDataDependency::Topology, "edge_face_count", [&]() {
+          Array<int> counts(mesh.edges_num, 0);
+          array_utils::count_indices(mesh.corner_edges(), counts);
+          return counts;
+        });
+    return mesh.attributes().adapt_domain<int>(std::move(counts), AttrDomain::Edge, domain);
   }
 
   uint64_t hash() const override
@@ -16,18 +16,28 @@ static void node_declare(NodeDeclarationBuilder &b)
       .description("The surface area of each of the mesh's faces");
 }
 
-static VArray<float> construct_face_area_varray(const Mesh &mesh, const AttrDomain domain)
+static Array<float> calc_face_areas(const Mesh &mesh)
 {
   const Span<float3> positions = mesh.vert_positions();
   const OffsetIndices faces = mesh.faces();
   const Span<int> corner_verts = mesh.corner_verts();
 
-  auto area_fn = [positions, faces, corner_verts](const int i) -> float {
-    return bke::mesh::face_area_calc(positions, corner_verts.slice(faces[i]));
-  };
+  Array<float> areas(faces.size());
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      areas[i] = bke::mesh::face_area_calc(positions, corner_verts.slice(faces[i]));
+    }
+  });
+  return areas;
+}
 
-  return mesh.attributes().adapt_domain<float>(
-      VArray<float>::ForFunc(faces.size(), area_fn), AttrDomain::Face, domain);
+static VArray<float> construct_face_area_varray(const Mesh &mesh, const AttrDomain domain)
+{
+  VArray<float> areas = bke::mesh::derived_data_lookup_or_compute<float>(
+      mesh, bke::MeshDerivedDataDependency::Positions, "face_area", [&]() {
+        return calc_face_areas(mesh);
+      });
+  return mesh.attributes().adapt_domain<float>(std::move(areas), AttrDomain::Face, domain);
 }
 
 class FaceAreaFieldInput final : public bke::MeshFieldInput {
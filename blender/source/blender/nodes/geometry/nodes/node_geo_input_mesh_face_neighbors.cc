@@ -51,7 +51,7 @@ static int unique_num(const GroupedSpan<int> values, const Span<int> indices)
   return unique_values.size();
 }
 
-static VArray<int> construct_neighbor_count_varray(const Mesh &mesh, const AttrDomain domain)
+static Array<int> calc_face_neighbor_counts(const Mesh &mesh)
 {
   const GroupedSpan<int> face_edges(mesh.faces(), mesh.corner_edges());
 
@@ -66,8 +66,16 @@ static VArray<int> construct_neighbor_count_varray(const Mesh &mesh, const AttrD
       face_count[face_i] = unique_num(edge_to_faces_map, face_edges[face_i]) - 1;
     }
   });
-  return mesh.attributes().adapt_domain<int>(
-      VArray<int>::ForContainer(std::move(face_count)), AttrDomain::Face, domain);
+  return face_count;
+}
+
+static VArray<int> construct_neighbor_count_varray(const Mesh &mesh, const AttrDomain domain)
+{
+  VArray<int> face_count = bke::mesh::derived_data_lookup_or_compute<int>(
+      mesh, bke::MeshDerivedDataDependency::Topology, "face_neighbor_count", [&]() {
+        return calc_face_neighbor_counts(mesh);
+      });
+  return mesh.attributes().adapt_domain<int>(std::move(face_count), AttrDomain::Face, domain);
 }
 
 class FaceNeighborCountFieldInput final : public bke::MeshFieldInput {
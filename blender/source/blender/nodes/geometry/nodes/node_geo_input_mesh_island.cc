@@ -5,6 +5,7 @@
 #include "BKE_mesh.hh"
 
 #include "BLI_atomic_disjoint_set.hh"
+#include "BLI_bounds.hh"
 #include "BLI_task.hh"
 
 #include "node_geometry_util.hh"
@@ -23,6 +24,26 @@ static void node_declare(NodeDeclarationBuilder &b)
       .description("The total number of mesh islands");
 }
 
+/** The island index of every vertex, shared by all nodes that use it on the same mesh. */
+static VArray<int> vert_island_ids(const Mesh &mesh)
+{
+  return bke::mesh::derived_data_lookup_or_compute<int>(
+      mesh, bke::MeshDerivedDataDependency::Topology, "vert_island", [&]() {
+        const Span<int2> edges = mesh.edges();
+
+        AtomicDisjointSet islands(mesh.verts_num);
+        threading::parallel_for(edges.index_range(), 1024, [&](const IndexRange range) {
+          for (const int2 &edge : edges.slice(range)) {
+            islands.join(edge[0], edge[1]);
+          }
+        });
+
+        Array<int> output(mesh.verts_num);
+        islands.calc_reduced_ids(output);
+        return output;
+      });
+}
+
 class IslandFieldInput final : public bke::MeshFieldInput {
  public:
   IslandFieldInput() : bke::MeshFieldInput(CPPType::get<int>(), "Island Index")
@@ -34,20 +55,7 @@ class IslandFieldInput final : public bke::MeshFieldInput {
                                  const AttrDomain domain,
                                  const IndexMask & /*mask*/) const final
   {
-    const Span<int2> edges = mesh.edges();
-
-    AtomicDisjointSet islands(mesh.verts_num);
-    threading::parallel_for(edges.index_range(), 1024, [&](const IndexRange range) {
-      for (const int2 &edge : edges.slice(range)) {
-        islands.join(edge[0], edge[1]);
-      }
-    });
-
-    Array<int> output(mesh.verts_num);
-    islands.calc_reduced_ids(output);
-
-    return mesh.attributes().adapt_domain<int>(
-        VArray<int>::ForContainer(std::move(output)), AttrDomain::Point, domain);
+    return mesh.attributes().adapt_domain<int>(vert_island_ids(mesh), AttrDomain::Point, domain);
   }
 
   uint64_t hash() const override
@@ -78,16 +86,10 @@ class IslandCountFieldInput final : public bke::MeshFieldInput {
                                  const AttrDomain domain,
                                  const IndexMask & /*mask*/) const final
   {
-    const Span<int2> edges = mesh.edges();
-
-    AtomicDisjointSet islands(mesh.verts_num);
-    threading::parallel_for(edges.index_range(), 1024, [&](const IndexRange range) {
-      for (const int2 &edge : edges.slice(range)) {
-        islands.join(edge[0], edge[1]);
-      }
-    });
-
-    const int islands_num = islands.count_sets();
+    /* The reduced island indices are consecutive, so the largest one determines the count. */
+    const VArraySpan<int> island_ids = vert_island_ids(mesh);
+    const std::optional<Bounds<int>> bounds = bounds::min_max(Span<int>(island_ids));
+    const int islands_num = bounds ? bounds->max + 1 : 0;
     return VArray<int>::ForSingle(islands_num, mesh.attributes().domain_size(domain));
   }
 
@@ -36,9 +36,12 @@ class VertexCountFieldInput final : public bke::MeshFieldInput {
     if (domain != AttrDomain::Point) {
       return {};
     }
-    Array<int> counts(mesh.verts_num, 0);
-    array_utils::count_indices(mesh.edges().cast<int>(), counts);
-    return VArray<int>::ForContainer(std::move(counts));
+    return bke::mesh::derived_data_lookup_or_compute<int>(
+        mesh, bke::MeshDerivedDataDependency::Topology, "vert_edge_count", [&]() {
+          Array<int> counts(mesh.verts_num, 0);
+          array_utils::count_indices(mesh.edges().cast<int>(), counts);
+          return counts;
+        });
   }
 
   uint64_t hash() const override
@@ -72,9 +75,12 @@ class VertexFaceCountFieldInput final : public bke::MeshFieldInput {
     if (domain != AttrDomain::Point) {
       return {};
     }
-    Array<int> counts(mesh.verts_num, 0);
-    array_utils::count_indices(mesh.corner_verts(), counts);
-    return VArray<int>::ForContainer(std::move(counts));
+    return bke::mesh::derived_data_lookup_or_compute<int>(
+        mesh, bke::MeshDerivedDataDependency::Topology, "vert_face_count", [&]() {
+          Array<int> counts(mesh.verts_num, 0);
+          array_utils::count_indices(mesh.corner_verts(), counts);
+          return counts;
+        });
   }
 
   uint64_t hash() const override
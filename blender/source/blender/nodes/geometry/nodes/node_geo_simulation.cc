@@ -257,6 +257,24 @@ static void node_layout_ex(uiLayout *layout, bContext *C, PointerRNA *current_no
     }
   }
   draw_common_bake_settings(C, ctx, layout);
+  {
+    uiLayout *col = uiLayoutColumn(layout, true);
+    uiLayoutSetActive(col, !ctx.is_baked);
+    uiItemR(col,
+            &ctx.bake_rna,
+            "use_memory_cache_compression",
+            UI_ITEM_NONE,
+            IFACE_("Compress Cache"),
+            ICON_NONE);
+    uiLayout *subcol = uiLayoutColumn(col, true);
+    uiLayoutSetActive(subcol, ctx.bake->flag & NODES_MODIFIER_BAKE_COMPRESS_MEMORY_CACHE);
+    uiItemR(subcol,
+            &ctx.bake_rna,
+            "memory_cache_limit",
+            UI_ITEM_NONE,
+            IFACE_("Memory Limit"),
+            ICON_NONE);
+  }
   draw_data_blocks(C, layout, ctx.bake_rna);
 }
 
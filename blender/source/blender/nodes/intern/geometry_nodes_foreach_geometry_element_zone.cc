@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_node_declaration.hh"
 
 #include "BKE_anonymous_attribute_make.hh"
 #include "BKE_compute_contexts.hh"
@@ -231,6 +232,48 @@ struct ForeachGeometryElementEvalStorage {
   int total_iterations_num = 0;
 };
 
+/**
+ * Checks if the zone body only does field math, i.e. it only contains multi-function nodes. Such a
+ * body gives the same result when it is evaluated once with fields as inputs, as when it is
+ * evaluated for every element separately. The former avoids the per-iteration overhead which
+ * dominates when there are many elements.
+ */
+static bool foreach_zone_body_is_field_only(
+    const bke::bNodeTreeZone &zone, const NodeGeometryForeachGeometryElementOutput &node_storage)
+{
+  if (node_storage.generation_items.items_num > 0) {
+    /* Generated geometries are built per element. */
+    return false;
+  }
+  const bNodeSocket &element_geometry_bsocket = zone.input_node->output_socket(1);
+  if (element_geometry_bsocket.is_available() && element_geometry_bsocket.is_directly_linked()) {
+    return false;
+  }
+  if (!zone.child_zones.is_empty()) {
+    return false;
+  }
+  for (const bNode *node : zone.child_nodes) {
+    if (node->is_reroute() || node->is_frame()) {
+      continue;
+    }
+    if (node->is_muted() || node->typeinfo->build_multi_function == nullptr) {
+      return false;
+    }
+    for (const bNodeSocket *socket : node->input_sockets()) {
+      if (!socket->is_available() || socket->is_directly_linked()) {
+        continue;
+      }
+      const SocketDeclaration *socket_decl = socket->runtime->declaration;
+      if (socket_decl && socket_decl->input_field_type == InputSocketFieldType::Implicit) {
+        /* Implicit fields like the position are not evaluated on the iterated geometry when the
+         * body is evaluated per element. */
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
  private:
   const bNodeTree &btree_;
@@ -238,6 +281,8 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
   const bNode &output_bnode_;
   const ZoneBuildInfo &zone_info_;
   const ZoneBodyFunction &body_fn_;
+  /** The body can be evaluated once for all elements, see #foreach_zone_body_is_field_only. */
+  bool body_is_field_only_ = false;
 
   struct ItemIndices {
     /* `outer` refers to sockets on the outside of the zone, and `inner` to the sockets on the
@@ -306,6 +351,8 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
                                                                     generation_items_num);
     indices_.generation.bsocket_inner = IndexRange::from_begin_size(1 + main_items_num,
                                                                     generation_items_num);
+
+    body_is_field_only_ = foreach_zone_body_is_field_only(zone, node_storage);
   }
 
   void *init_storage(LinearAllocator<> &allocator) const override
@@ -335,20 +382,15 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
     geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(user_data);
 
     if (!eval_storage.graph_executor) {
+      if (body_is_field_only_ &&
+          this->try_execute_field_only_body(params, context, eval_storage, node_storage))
+      {
+        return;
+      }
+
       /* Create the execution graph in the first evaluation. */
       this->initialize_execution_graph(params, eval_storage, node_storage);
-
-      if (tree_logger) {
-        if (eval_storage.total_iterations_num == 0) {
-          if (!eval_storage.main_geometry.is_empty()) {
-            tree_logger->node_warnings.append(
-                *tree_logger->allocator,
-                {zone_.input_node->identifier,
-                 {geo_eval_log::NodeWarningType::Info,
-                  N_("Input geometry has no elements in the iteration domain.")}});
-          }
-        }
-      }
+      this->log_empty_iteration_warning(tree_logger, eval_storage);
     }
 
     lf::Context eval_graph_context{
@@ -357,6 +399,242 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
     eval_storage.graph_executor->execute(params, eval_graph_context);
   }
 
+  void log_empty_iteration_warning(geo_eval_log::GeoTreeLogger *tree_logger,
+                                   const ForeachGeometryElementEvalStorage &eval_storage) const
+  {
+    if (!tree_logger) {
+      return;
+    }
+    if (eval_storage.total_iterations_num == 0) {
+      if (!eval_storage.main_geometry.is_empty()) {
+        tree_logger->node_warnings.append(
+            *tree_logger->allocator,
+            {zone_.input_node->identifier,
+             {geo_eval_log::NodeWarningType::Info,
+              N_("Input geometry has no elements in the iteration domain.")}});
+      }
+    }
+  }
+
+  /**
+   * Evaluates a field-only body a single time with fields as inputs, and then evaluates the
+   * resulting fields on all selected elements at once. Returns false when the body has to be
+   * evaluated per element after all.
+   */
+  bool try_execute_field_only_body(
+      lf::Params &params,
+      const lf::Context &context,
+      ForeachGeometryElementEvalStorage &eval_storage,
+      const NodeGeometryForeachGeometryElementOutput &node_storage) const
+  {
+    auto &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
+    auto &local_user_data = *static_cast<GeoNodesLFLocalUserData *>(context.local_user_data);
+
+    /* All values passed into the body from the outside have to be known up front. */
+    bool any_input_missing = false;
+    for (const int i : zone_info_.indices.inputs.border_links) {
+      if (params.try_get_input_data_ptr_or_request(i) == nullptr) {
+        any_input_missing = true;
+      }
+    }
+    for (const int i : zone_info_.indices.inputs.reference_sets.values()) {
+      if (params.try_get_input_data_ptr_or_request(i) == nullptr) {
+        any_input_missing = true;
+      }
+    }
+    if (any_input_missing) {
+      /* Wait until the inputs are available. */
+      return true;
+    }
+    for (const int i : zone_info_.indices.inputs.border_links) {
+      if (inputs_[i].type != &CPPType::get<SocketValueVariant>()) {
+        continue;
+      }
+      if (params.get_input<SocketValueVariant>(i).is_context_dependent_field()) {
+        /* Fields from outside of the zone are evaluated without the iterated geometry in every
+         * iteration, which is not the same as evaluating them on the geometry. */
+        return false;
+      }
+    }
+
+    eval_storage.main_geometry = params.extract_input<GeometrySet>(
+        zone_info_.indices.inputs.main[0]);
+    this->prepare_components(params, eval_storage, node_storage, false);
+    this->log_empty_iteration_warning(
+        local_user_data.try_get_tree_logger(user_data), eval_storage);
+
+    Array<SocketValueVariant> body_outputs;
+    if (!eval_storage.components.is_empty()) {
+      body_outputs = this->execute_body_on_fields(params, context, node_storage);
+    }
+
+    const int main_items_num = node_storage.main_items.items_num;
+    Array<const CPPType *> base_cpp_types(main_items_num);
+    Array<std::string> attribute_names(main_items_num);
+    for (const int item_i : IndexRange(main_items_num)) {
+      const NodeForeachGeometryElementMainItem &item = node_storage.main_items.items[item_i];
+      const eNodeSocketDatatype socket_type = eNodeSocketDatatype(item.socket_type);
+      base_cpp_types[item_i] = bke::socket_type_to_geo_nodes_base_cpp_type(socket_type);
+      attribute_names[item_i] = bke::hash_to_anonymous_attribute_name(
+          user_data.call_data->self_object()->id.name,
+          user_data.compute_context->hash(),
+          output_bnode_.identifier,
+          item.identifier);
+    }
+
+    /* Evaluate the fields of all items together for each component, so that they can share
+     * common inputs. */
+    GeometrySet output_geometry = eval_storage.main_geometry;
+    for (const ForeachElementComponent &component_info : eval_storage.components) {
+      MutableAttributeAccessor attributes = component_info.attributes_for_write(output_geometry);
+      const int domain_size = attributes.domain_size(component_info.id.domain);
+      const IndexMask mask = component_info.field_evaluator->get_evaluated_selection_as_mask();
+      IndexMaskMemory memory;
+      const IndexMask inverted_mask = mask.complement(IndexRange(domain_size), memory);
+
+      fn::FieldEvaluator evaluator{*component_info.field_context, &mask};
+      Vector<bke::GSpanAttributeWriter> attribute_writers;
+      for (const int item_i : IndexRange(main_items_num)) {
+        const CPPType *base_cpp_type = base_cpp_types[item_i];
+        if (!base_cpp_type) {
+          continue;
+        }
+        bke::GSpanAttributeWriter attribute = attributes.lookup_or_add_for_write_only_span(
+            attribute_names[item_i],
+            component_info.id.domain,
+            bke::cpp_type_to_custom_data_type(*base_cpp_type));
+        base_cpp_type->value_initialize_indices(attribute.span.data(), inverted_mask);
+        evaluator.add_with_destination(body_outputs[item_i].get<GField>(), attribute.span);
+        attribute_writers.append(std::move(attribute));
+      }
+      evaluator.evaluate();
+      for (bke::GSpanAttributeWriter &attribute : attribute_writers) {
+        attribute.finish();
+      }
+    }
+
+    /* Output the fields for the anonymous attributes. */
+    for (const int item_i : IndexRange(main_items_num)) {
+      const int lf_output_i = zone_info_.indices.outputs.main[indices_.main.lf_outer[item_i]];
+      const bNodeSocket &output_bsocket = output_bnode_.output_socket(
+          indices_.main.bsocket_outer[item_i]);
+      const CPPType *base_cpp_type = base_cpp_types[item_i];
+      if (!base_cpp_type) {
+        set_default_value_for_output_socket(params, lf_output_i, output_bsocket);
+        continue;
+      }
+      auto attribute_field = std::make_shared<bke::AttributeFieldInput>(
+          attribute_names[item_i],
+          *base_cpp_type,
+          make_anonymous_attribute_socket_inspection_string(output_bsocket));
+      params.set_output(lf_output_i, SocketValueVariant{GField(std::move(attribute_field))});
+    }
+    params.set_output(zone_info_.indices.outputs.main[0], std::move(output_geometry));
+
+    /* All inputs are used. */
+    for (const int i : zone_info_.indices.outputs.input_usages) {
+      params.set_output(i, true);
+    }
+    for (const int i : zone_info_.indices.outputs.border_link_usages) {
+      params.set_output(i, true);
+    }
+    return true;
+  }
+
+  /**
+   * Evaluates the body a single time, with the index field and the zone input fields as inputs.
+   * Returns the values of the main items, which are fields or single values.
+   */
+  Array<SocketValueVariant> execute_body_on_fields(
+      lf::Params &params,
+      const lf::Context &context,
+      const NodeGeometryForeachGeometryElementOutput &node_storage) const
+  {
+    const LazyFunction &body_fn = *body_fn_.function;
+    LinearAllocator<> allocator;
+
+    Array<GMutablePointer> lf_inputs(body_fn.inputs().size());
+    Array<GMutablePointer> lf_outputs(body_fn.outputs().size());
+    Array<std::optional<lf::ValueUsage>> lf_input_usages(body_fn.inputs().size());
+    Array<lf::ValueUsage> lf_output_usages(body_fn.outputs().size(), lf::ValueUsage::Used);
+    Array<bool> lf_set_outputs(body_fn.outputs().size(), false);
+
+    const CPPType &value_type = CPPType::get<SocketValueVariant>();
+    SocketValueVariant index_value{Field<int>(std::make_shared<fn::IndexFieldInput>())};
+    lf_inputs[body_fn_.indices.inputs.main[0]] = {value_type, &index_value};
+    GeometrySet element_geometry;
+    if (zone_.input_node->output_socket(1).is_available()) {
+      lf_inputs[body_fn_.indices.inputs.main[1]] = {CPPType::get<GeometrySet>(),
+                                                    &element_geometry};
+    }
+    Array<SocketValueVariant> item_values(node_storage.input_items.items_num);
+    for (const int item_i : item_values.index_range()) {
+      item_values[item_i] = params.get_input<SocketValueVariant>(
+          zone_info_.indices.inputs.main[indices_.inputs.lf_outer[item_i]]);
+      lf_inputs[body_fn_.indices.inputs.main[indices_.inputs.lf_inner[item_i]]] = {
+          value_type, &item_values[item_i]};
+    }
+
+    /* Values from outside of the zone are copied, because the body may move from its inputs. */
+    Vector<GMutablePointer> values_to_destruct;
+    auto copy_input = [&](const int zone_input_i, const int body_input_i) {
+      const CPPType &type = *body_fn.inputs()[body_input_i].type;
+      void *buffer = allocator.allocate(type.size(), type.alignment());
+      type.copy_construct(params.try_get_input_data_ptr(zone_input_i), buffer);
+      lf_inputs[body_input_i] = {type, buffer};
+      values_to_destruct.append({type, buffer});
+    };
+    for (const int border_link_i : zone_info_.indices.inputs.border_links.index_range()) {
+      copy_input(zone_info_.indices.inputs.border_links[border_link_i],
+                 body_fn_.indices.inputs.border_links[border_link_i]);
+    }
+    for (const auto &item : body_fn_.indices.inputs.reference_sets.items()) {
+      copy_input(zone_info_.indices.inputs.reference_sets.lookup(item.key), item.value);
+    }
+    bool output_used = true;
+    for (const int i : body_fn_.indices.inputs.output_usages) {
+      lf_inputs[i] = {CPPType::get<bool>(), &output_used};
+    }
+
+    for (const int i : lf_outputs.index_range()) {
+      const CPPType &type = *body_fn.outputs()[i].type;
+      lf_outputs[i] = {type, allocator.allocate(type.size(), type.alignment())};
+    }
+
+    /* The body is evaluated like the first iteration, for logging. */
+    auto &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
+    bke::ForeachGeometryElementZoneComputeContext body_compute_context{
+        user_data.compute_context, output_bnode_, 0};
+    GeoNodesLFUserData body_user_data = user_data;
+    body_user_data.compute_context = &body_compute_context;
+    body_user_data.log_socket_values = should_log_socket_values_for_context(
+        user_data, body_compute_context.hash());
+    GeoNodesLFLocalUserData body_local_user_data{body_user_data};
+
+    lf::Context body_context{
+        body_fn.init_storage(allocator), &body_user_data, &body_local_user_data};
+    lf::BasicParams body_params{
+        body_fn, lf_inputs, lf_outputs, lf_input_usages, lf_output_usages, lf_set_outputs};
+    body_fn.execute(body_params, body_context);
+    body_fn.destruct_storage(body_context.storage);
+
+    Array<SocketValueVariant> main_values(node_storage.main_items.items_num);
+    for (const int item_i : main_values.index_range()) {
+      const int lf_output_i = body_fn_.indices.outputs.main[item_i];
+      main_values[item_i] = std::move(*lf_outputs[lf_output_i].get<SocketValueVariant>());
+    }
+
+    for (const int i : lf_outputs.index_range()) {
+      if (lf_set_outputs[i]) {
+        lf_outputs[i].destruct();
+      }
+    }
+    for (GMutablePointer &value : values_to_destruct) {
+      value.destruct();
+    }
+    return main_values;
+  }
+
   void initialize_execution_graph(
       lf::Params &params,
       ForeachGeometryElementEvalStorage &eval_storage,
@@ -366,7 +644,7 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
         zone_info_.indices.inputs.main[0]);
 
     /* Find all the things we need to iterate over in the input geometry. */
-    this->prepare_components(params, eval_storage, node_storage);
+    this->prepare_components(params, eval_storage, node_storage, true);
 
     /* Add interface sockets for the zone graph. Those are the same as for the entire zone, even
      * though some of the inputs are not strictly needed anymore. It's easier to avoid another
@@ -414,9 +692,14 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
     }
   }
 
+  /**
+   * When \a prepare_iterations is false, only the selection is evaluated and no per-element input
+   * values are created.
+   */
   void prepare_components(lf::Params &params,
                           ForeachGeometryElementEvalStorage &eval_storage,
-                          const NodeGeometryForeachGeometryElementOutput &node_storage) const
+                          const NodeGeometryForeachGeometryElementOutput &node_storage,
+                          const bool prepare_iterations) const
   {
     const AttrDomain iteration_domain = AttrDomain(node_storage.domain);
 
@@ -476,6 +759,14 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
       /* Prepare field evaluation for the zone inputs. */
       component_info.field_evaluator.emplace(*component_info.field_context, domain_size);
       component_info.field_evaluator->set_selection(selection_field);
+      if (!prepare_iterations) {
+        component_info.field_evaluator->evaluate();
+        const IndexMask mask = component_info.field_evaluator->get_evaluated_selection_as_mask();
+        component_info.body_nodes_range = IndexRange::from_begin_size(body_nodes_offset,
+                                                                      mask.size());
+        body_nodes_offset += mask.size();
+        continue;
+      }
       for (const int item_i : IndexRange(node_storage.input_items.items_num)) {
         const GField item_field =
             params
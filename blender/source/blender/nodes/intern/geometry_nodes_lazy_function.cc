@@ -22,6 +22,7 @@
 
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_memoization.hh"
 #include "NOD_multi_function.hh"
 #include "NOD_node_declaration.hh"
 
@@ -34,6 +35,7 @@
 #include "BLI_hash_md5.hh"
 #include "BLI_lazy_threading.hh"
 #include "BLI_map.hh"
+#include "BLI_memory_counter.hh"
 
 #include "DNA_ID.h"
 
@@ -128,6 +130,113 @@ static void lazy_function_interface_from_node(const bNode &node,
   }
 }
 
+/**
+ * Forwards everything to the params of a geometry node, but logs the memory used by output
+ * geometries before they are passed on. Data that is shared with the input geometries or with
+ * previously set outputs is not counted, so the logged size approximates what the node allocated.
+ */
+class OutputMemoryLoggingParams : public lf::Params {
+ private:
+  lf::Params &base_params_;
+  const bNode &node_;
+  Span<int> lf_index_by_bsocket_;
+  geo_eval_log::GeoTreeLogger &tree_logger_;
+  MemoryCount memory_;
+
+ public:
+  OutputMemoryLoggingParams(const lf::LazyFunction &fn,
+                            lf::Params &base_params,
+                            const bNode &node,
+                            const Span<int> lf_index_by_bsocket,
+                            geo_eval_log::GeoTreeLogger &tree_logger)
+      : lf::Params(fn, false),
+        base_params_(base_params),
+        node_(node),
+        lf_index_by_bsocket_(lf_index_by_bsocket),
+        tree_logger_(tree_logger)
+  {
+    MemoryCounter memory{memory_};
+    for (const bNodeSocket *bsocket : node.input_sockets()) {
+      const int lf_index = lf_index_by_bsocket[bsocket->index_in_tree()];
+      if (lf_index == -1 || fn.inputs()[lf_index].type != &CPPType::get<GeometrySet>()) {
+        continue;
+      }
+      if (const void *value = base_params.try_get_input_data_ptr(lf_index)) {
+        static_cast<const GeometrySet *>(value)->count_memory(memory);
+      }
+    }
+  }
+
+ private:
+  void *try_get_input_data_ptr_impl(const int index) const override
+  {
+    return base_params_.try_get_input_data_ptr(index);
+  }
+
+  void *try_get_input_data_ptr_or_request_impl(const int index) override
+  {
+    return base_params_.try_get_input_data_ptr_or_request(index);
+  }
+
+  void *get_output_data_ptr_impl(const int index) override
+  {
+    return base_params_.get_output_data_ptr(index);
+  }
+
+  void output_set_impl(const int index) override
+  {
+    if (fn_.outputs()[index].type == &CPPType::get<GeometrySet>()) {
+      this->log_output_memory(index);
+    }
+    base_params_.output_set(index);
+  }
+
+  bool output_was_set_impl(const int index) const override
+  {
+    return base_params_.output_was_set(index);
+  }
+
+  lf::ValueUsage get_output_usage_impl(const int index) const override
+  {
+    return base_params_.get_output_usage(index);
+  }
+
+  void set_input_unused_impl(const int index) override
+  {
+    base_params_.set_input_unused(index);
+  }
+
+  bool try_enable_multi_threading_impl() override
+  {
+    return base_params_.try_enable_multi_threading();
+  }
+
+  void log_output_memory(const int index)
+  {
+    const bNodeSocket *output_bsocket = nullptr;
+    for (const bNodeSocket *bsocket : node_.output_sockets()) {
+      if (lf_index_by_bsocket_[bsocket->index_in_tree()] == index) {
+        output_bsocket = bsocket;
+        break;
+      }
+    }
+    if (output_bsocket == nullptr) {
+      return;
+    }
+    const GeometrySet &geometry = *static_cast<const GeometrySet *>(
+        base_params_.get_output_data_ptr(index));
+    const int64_t bytes_before = memory_.total_bytes;
+    MemoryCounter memory{memory_};
+    geometry.count_memory(memory);
+    tree_logger_.output_memory_usages.append(
+        *tree_logger_.allocator,
+        {node_.identifier,
+         tree_logger_.allocator->copy_string(output_bsocket->name),
+         memory_.total_bytes - bytes_before,
+         geo_eval_log::Clock::now()});
+  }
+};
+
 /**
  * Used for most normal geometry nodes like Subdivision Surface and Set Position.
  */
@@ -248,15 +357,54 @@ class LazyFunctionForGeometryNode : public LazyFunction {
       return this->anonymous_attribute_name_for_output(*user_data, i);
     };
 
-    GeoNodeExecParams geo_params{
-        node_,
-        params,
-        context,
-        own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
-        own_lf_graph_info_.mapping.lf_input_index_for_reference_set_for_output,
-        get_anonymous_attribute_name};
+    const auto &local_user_data = *static_cast<GeoNodesLFLocalUserData *>(
+        context.local_user_data);
+    geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(*user_data);
+
+    auto execute_node = [&](lf::Params &node_params,
+                            Vector<geo_eval_log::NodeWarning> *r_warnings) {
+      std::optional<OutputMemoryLoggingParams> memory_logging_params;
+      if (tree_logger && user_data->call_data->eval_log->record_timeline) {
+        memory_logging_params.emplace(*this,
+                                      node_params,
+                                      node_,
+                                      own_lf_graph_info_.mapping.lf_index_by_bsocket,
+                                      *tree_logger);
+      }
+      GeoNodeExecParams geo_params{
+          node_,
+          memory_logging_params ? *memory_logging_params : node_params,
+          context,
+          own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
+          own_lf_graph_info_.mapping.lf_input_index_for_reference_set_for_output,
+          get_anonymous_attribute_name};
+      geo_params.r_warnings = r_warnings;
+
+      node_.typeinfo->geometry_node_execute(geo_params);
+    };
+
+    if (node_.declaration()->memoize_outputs && geometry_nodes_memoization_enabled()) {
+      Vector<std::string> output_attribute_names;
+      for (const int output_bsocket_index : node_.output_sockets().index_range()) {
+        if (is_attribute_output_bsocket_[output_bsocket_index]) {
+          output_attribute_names.append(get_anonymous_attribute_name(output_bsocket_index));
+        }
+      }
+      if (execute_geometry_node_memoized(
+              node_,
+              *this,
+              params,
+              output_attribute_names,
+              tree_logger,
+              [&](lf::Params &node_params, Vector<geo_eval_log::NodeWarning> &r_warnings) {
+                execute_node(node_params, &r_warnings);
+              }))
+      {
+        return;
+      }
+    }
 
-    node_.typeinfo->geometry_node_execute(geo_params);
+    execute_node(params, nullptr);
   }
 
   std::string input_name(const int index) const override
@@ -582,6 +582,11 @@ GeoTreeLogger &GeoModifierLog::get_local_tree_logger(const ComputeContext &compu
   tree_logger_ptr = local_data.allocator.construct<GeoTreeLogger>();
   GeoTreeLogger &tree_logger = *tree_logger_ptr;
   tree_logger.allocator = &local_data.allocator;
+  tree_logger.context_hash = compute_context.hash();
+  if (local_data.thread_index == -1) {
+    local_data.thread_index = threads_num_.fetch_add(1);
+  }
+  tree_logger.thread_index = local_data.thread_index;
   const ComputeContext *parent_compute_context = compute_context.parent();
   if (parent_compute_context != nullptr) {
     tree_logger.parent_hash = parent_compute_context->hash();
@@ -628,6 +633,197 @@ GeoTreeLog &GeoModifierLog::get_tree_log(const ComputeContextHash &compute_conte
   return reduced_tree_log;
 }
 
+namespace {
+
+struct TimelineEvent {
+  const GeoTreeLogger *tree_logger;
+  const GeoTreeLogger::NodeExecutionTime *timing;
+  /** True when other node executions are nested in this one (e.g. groups). */
+  bool is_container = false;
+};
+
+}  // namespace
+
+static Vector<TimelineEvent> gather_timeline_events(const Span<const GeoTreeLogger *> tree_loggers)
+{
+  Vector<TimelineEvent> events;
+  for (const GeoTreeLogger *tree_logger : tree_loggers) {
+    for (const GeoTreeLogger::NodeExecutionTime &timing : tree_logger->node_execution_times) {
+      events.append({tree_logger, &timing});
+    }
+  }
+  std::sort(events.begin(), events.end(), [](const TimelineEvent &a, const TimelineEvent &b) {
+    if (a.tree_logger->thread_index != b.tree_logger->thread_index) {
+      return a.tree_logger->thread_index < b.tree_logger->thread_index;
+    }
+    if (a.timing->start != b.timing->start) {
+      return a.timing->start < b.timing->start;
+    }
+    return a.timing->end > b.timing->end;
+  });
+  /* Nodes which have a nested compute context (groups and zones) contain the executions in that
+   * context, which may have run on any thread. */
+  Set<std::pair<ComputeContextHash, int32_t>> nodes_with_nested_context;
+  for (const GeoTreeLogger *tree_logger : tree_loggers) {
+    if (tree_logger->parent_hash && tree_logger->parent_node_id) {
+      nodes_with_nested_context.add({*tree_logger->parent_hash, *tree_logger->parent_node_id});
+    }
+  }
+  for (TimelineEvent &event : events) {
+    event.is_container = nodes_with_nested_context.contains(
+        {event.tree_logger->context_hash, event.timing->node_id});
+  }
+  /* Events on the same thread are either disjoint or nested, also find the ones that contain
+   * others in the same compute context. */
+  Vector<TimelineEvent *> stack;
+  for (TimelineEvent &event : events) {
+    while (!stack.is_empty() &&
+           (stack.last()->tree_logger->thread_index != event.tree_logger->thread_index ||
+            stack.last()->timing->end <= event.timing->start))
+    {
+      stack.pop_last();
+    }
+    if (!stack.is_empty()) {
+      stack.last()->is_container = true;
+    }
+    stack.append(&event);
+  }
+  return events;
+}
+
+static double to_microseconds(const std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+std::shared_ptr<io::serialize::DictionaryValue> GeoModifierLog::timeline_to_chrome_trace()
+{
+  using namespace io::serialize;
+  Vector<const GeoTreeLogger *> tree_loggers;
+  for (LocalData &local_data : data_per_thread_) {
+    for (const destruct_ptr<GeoTreeLogger> &tree_logger :
+         local_data.tree_logger_by_context.values())
+    {
+      tree_loggers.append(tree_logger.get());
+    }
+  }
+  const Vector<TimelineEvent> events = gather_timeline_events(tree_loggers);
+
+  auto trace = std::make_shared<DictionaryValue>();
+  trace->append_str("displayTimeUnit", "ms");
+  ArrayValue &trace_events = *trace->append_array("traceEvents");
+  for (const int thread_index : IndexRange(threads_num_)) {
+    DictionaryValue &metadata = *trace_events.append_dict();
+    metadata.append_str("name", "thread_name");
+    metadata.append_str("ph", "M");
+    metadata.append_int("pid", 0);
+    metadata.append_int("tid", thread_index);
+    metadata.append_dict("args")->append_str("name", "Thread " + std::to_string(thread_index));
+  }
+  if (events.is_empty()) {
+    return trace;
+  }
+
+  TimePoint begin = events.first().timing->start;
+  for (const TimelineEvent &event : events) {
+    begin = std::min(begin, event.timing->start);
+  }
+
+  /* Memory usages are attached to the execution of the node that they were logged in. */
+  Map<std::pair<const GeoTreeLogger *, int32_t>, Vector<const GeoTreeLogger::OutputMemoryUsage *>>
+      memory_usages_by_node;
+  for (const GeoTreeLogger *tree_logger : tree_loggers) {
+    for (const GeoTreeLogger::OutputMemoryUsage &usage : tree_logger->output_memory_usages) {
+      memory_usages_by_node.lookup_or_add_default({tree_logger, usage.node_id}).append(&usage);
+    }
+  }
+
+  for (const TimelineEvent &event : events) {
+    const GeoTreeLogger::NodeExecutionTime &timing = *event.timing;
+    DictionaryValue &trace_event = *trace_events.append_dict();
+    trace_event.append_str("name",
+                           timing.node_name.is_empty() ? std::to_string(timing.node_id) :
+                                                         std::string(timing.node_name));
+    trace_event.append_str("cat", event.is_container ? "group" : "node");
+    trace_event.append_str("ph", "X");
+    trace_event.append_int("pid", 0);
+    trace_event.append_int("tid", event.tree_logger->thread_index);
+    trace_event.append_double("ts", to_microseconds(timing.start - begin));
+    trace_event.append_double("dur", to_microseconds(timing.end - timing.start));
+    DictionaryValue &args = *trace_event.append_dict("args");
+    args.append_int("node_id", timing.node_id);
+    const Vector<const GeoTreeLogger::OutputMemoryUsage *> *memory_usages =
+        memory_usages_by_node.lookup_ptr({event.tree_logger, timing.node_id});
+    if (memory_usages == nullptr) {
+      continue;
+    }
+    for (const GeoTreeLogger::OutputMemoryUsage *usage : *memory_usages) {
+      if (usage->time >= timing.start && usage->time <= timing.end) {
+        args.append_int("memory: " + std::string(usage->socket_name), usage->bytes);
+      }
+    }
+  }
+  return trace;
+}
+
+const GeoModifierLog::TimelineSummary &GeoModifierLog::get_timeline_summary()
+{
+  if (timeline_summary_) {
+    return *timeline_summary_;
+  }
+  TimelineSummary &summary = timeline_summary_.emplace();
+
+  Vector<const GeoTreeLogger *> tree_loggers;
+  for (LocalData &local_data : data_per_thread_) {
+    for (const destruct_ptr<GeoTreeLogger> &tree_logger :
+         local_data.tree_logger_by_context.values())
+    {
+      tree_loggers.append(tree_logger.get());
+    }
+  }
+  const Vector<TimelineEvent> events = gather_timeline_events(tree_loggers);
+
+  summary.threads_num = threads_num_;
+  if (events.is_empty()) {
+    return summary;
+  }
+
+  TimePoint begin = events.first().timing->start;
+  TimePoint end = events.first().timing->end;
+  Vector<const GeoTreeLogger::NodeExecutionTime *> leaf_timings;
+  for (const TimelineEvent &event : events) {
+    begin = std::min(begin, event.timing->start);
+    end = std::max(end, event.timing->end);
+    if (!event.is_container) {
+      summary.node_time += event.timing->end - event.timing->start;
+      leaf_timings.append(event.timing);
+    }
+  }
+  summary.wall_time = end - begin;
+
+  /* Walk backwards from the node that finished last, always continuing with the node that
+   * finished last before the current one started. That is the node the current one most likely
+   * had to wait for. */
+  std::sort(leaf_timings.begin(), leaf_timings.end(), [](const auto *a, const auto *b) {
+    return a->end < b->end;
+  });
+  int64_t current = leaf_timings.size() - 1;
+  while (current >= 0) {
+    const GeoTreeLogger::NodeExecutionTime &timing = *leaf_timings[current];
+    summary.critical_path.append({timing.node_name, timing.end - timing.start});
+    const auto *previous = std::upper_bound(
+        leaf_timings.begin(),
+        leaf_timings.begin() + current,
+        timing.start,
+        [](const TimePoint &time, const GeoTreeLogger::NodeExecutionTime *timing) {
+          return time < timing->end;
+        });
+    current = int64_t(previous - leaf_timings.begin()) - 1;
+  }
+  std::reverse(summary.critical_path.begin(), summary.critical_path.end());
+  return summary;
+}
+
 static void find_tree_zone_hash_recursive(
     const bNodeTreeZone &zone,
     ComputeContextBuilder &compute_context_builder,
@@ -0,0 +1,523 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "MEM_guardedalloc.h"
+
+#include "NOD_geometry_nodes_log.hh"
+#include "NOD_geometry_nodes_memoization.hh"
+
+#include "BLI_array.hh"
+#include "BLI_generic_key.hh"
+#include "BLI_hash.hh"
+#include "BLI_implicit_sharing_ptr.hh"
+#include "BLI_listbase.h"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
+
+#include "DNA_curves_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
+#include "DNA_userdef_types.h"
+#include "DNA_volume_types.h"
+
+#include "BKE_curves.hh"
+#include "BKE_customdata.hh"
+#include "BKE_geometry_nodes_reference_set.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_mesh.hh"
+#include "BKE_node_legacy_types.hh"
+#include "BKE_node_socket_value.hh"
+#include "BKE_volume.hh"
+#include "BKE_volume_grid.hh"
+
+#include "FN_lazy_function_execute.hh"
+
+#include <algorithm>
+
+namespace blender::nodes {
+
+using bke::GeometryComponent;
+using bke::GeometryNodesReferenceSet;
+using bke::GeometrySet;
+using bke::SocketValueVariant;
+
+bool geometry_nodes_memoization_enabled()
+{
+  return USER_EXPERIMENTAL_TEST(&U, use_geometry_nodes_memoization);
+}
+
+/**
+ * Identifies a node evaluation. Plain values are serialized into #data and compared byte-wise.
+ * Implicitly shared data is identified by its sharing info and version instead of its content,
+ * which makes building and comparing keys cheap even for large geometries. The weak users keep
+ * the sharing infos alive, so that their addresses are not reused while the key exists.
+ */
+class NodeEvaluationKey : public GenericKey {
+ public:
+  std::string data;
+  Vector<std::pair<WeakImplicitSharingPtr, int64_t>> shared_data;
+
+  uint64_t hash() const override
+  {
+    uint64_t hash = get_default_hash(data);
+    for (const auto &[sharing_info, version] : shared_data) {
+      hash = get_default_hash(hash, sharing_info.get(), version);
+    }
+    return hash;
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    const auto *other_key = dynamic_cast<const NodeEvaluationKey *>(&other);
+    if (other_key == nullptr) {
+      return false;
+    }
+    if (data != other_key->data || shared_data.size() != other_key->shared_data.size()) {
+      return false;
+    }
+    for (const int i : shared_data.index_range()) {
+      if (shared_data[i].first.get() != other_key->shared_data[i].first.get() ||
+          shared_data[i].second != other_key->shared_data[i].second)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<NodeEvaluationKey>(*this);
+  }
+
+  template<typename T> void append_value(const T &value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  void append_string(const StringRef str)
+  {
+    this->append_value(str.size());
+    data.append(str.data(), str.size());
+  }
+
+  /** Appends a string that may be null, which is distinguished from an empty string. */
+  void append_optional_string(const char *str)
+  {
+    if (str == nullptr) {
+      this->append_value(int64_t(-1));
+      return;
+    }
+    this->append_string(str);
+  }
+
+  /** Returns false if the data is not shared and therefore has no identity. */
+  bool append_shared(const ImplicitSharingInfo *sharing_info)
+  {
+    if (sharing_info == nullptr) {
+      return false;
+    }
+    sharing_info->add_weak_user();
+    shared_data.append({WeakImplicitSharingPtr(sharing_info), sharing_info->version()});
+    return true;
+  }
+};
+
+/**
+ * Copies of the node outputs. Outputs that were not computed are null. The warnings are added to
+ * the log again when the outputs are reused, because the node is not executed then.
+ */
+class CachedNodeOutputs : public memory_cache::CachedValue {
+ public:
+  Array<GMutablePointer> outputs;
+  Vector<geo_eval_log::NodeWarning> warnings;
+
+  CachedNodeOutputs(const int outputs_num) : outputs(outputs_num) {}
+
+  ~CachedNodeOutputs() override
+  {
+    for (GMutablePointer &value : outputs) {
+      if (value.get() != nullptr) {
+        value.destruct();
+        MEM_freeN(value.get());
+      }
+    }
+  }
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    for (const GMutablePointer &value : outputs) {
+      if (value.get() == nullptr) {
+        continue;
+      }
+      if (value.type()->is<GeometrySet>()) {
+        value.get<GeometrySet>()->count_memory(memory);
+      }
+      else {
+        memory.add(value.type()->size());
+      }
+    }
+    for (const geo_eval_log::NodeWarning &warning : warnings) {
+      memory.add(warning.message.size());
+    }
+  }
+};
+
+template<typename IDWithMaterials>
+static void append_materials(const IDWithMaterials &id, NodeEvaluationKey &key)
+{
+  key.append_value(id.totcol);
+  for (const int i : IndexRange(id.totcol)) {
+    const Material *material = id.mat[i];
+    key.append_value(material ? material->id.session_uid : 0u);
+  }
+}
+
+static bool is_vertex_group_name(const ListBase &vertex_group_names, const StringRef name)
+{
+  LISTBASE_FOREACH (const bDeformGroup *, group, &vertex_group_names) {
+    if (group->name == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Vertex groups are exposed as virtual attributes without sharing info, but the weights of all
+ * groups are stored in a single shared layer which identifies them instead.
+ */
+static bool append_vertex_groups(const ListBase &vertex_group_names,
+                                 const CustomData &point_data,
+                                 NodeEvaluationKey &key)
+{
+  LISTBASE_FOREACH (const bDeformGroup *, group, &vertex_group_names) {
+    key.append_string(group->name);
+  }
+  key.append_value(-1);
+  if (BLI_listbase_is_empty(&vertex_group_names)) {
+    return true;
+  }
+  const int layer_index = CustomData_get_layer_index(&point_data, CD_MDEFORMVERT);
+  key.append_value(layer_index != -1);
+  if (layer_index == -1) {
+    return true;
+  }
+  return key.append_shared(point_data.layers[layer_index].sharing_info);
+}
+
+/**
+ * \param vertex_group_names: Attributes with these names are skipped, they have to be added with
+ * #append_vertex_groups.
+ */
+static bool append_attributes(const bke::AttributeAccessor attributes,
+                              const ListBase &vertex_group_names,
+                              NodeEvaluationKey &key)
+{
+  bool success = true;
+  attributes.foreach_attribute([&](const bke::AttributeIter &iter) {
+    if (is_vertex_group_name(vertex_group_names, iter.name)) {
+      return;
+    }
+    key.append_string(iter.name);
+    key.append_value(iter.domain);
+    key.append_value(iter.data_type);
+    const bke::GAttributeReader attribute = iter.get();
+    if (!key.append_shared(attribute.sharing_info)) {
+      /* Other virtual attributes have no identity other than their content. */
+      success = false;
+      iter.stop();
+    }
+  });
+  return success;
+}
+
+static bool append_geometry(const GeometrySet &geometry, NodeEvaluationKey &key)
+{
+  for (const GeometryComponent *component : geometry.get_components()) {
+    if (component->is_empty()) {
+      continue;
+    }
+    const GeometryComponent::Type type = component->type();
+    key.append_value(type);
+    switch (type) {
+      case GeometryComponent::Type::Mesh: {
+        const Mesh &mesh = *geometry.get_mesh();
+        key.append_value(mesh.verts_num);
+        key.append_value(mesh.edges_num);
+        key.append_value(mesh.faces_num);
+        key.append_value(mesh.corners_num);
+        if (mesh.faces_num > 0) {
+          if (!key.append_shared(mesh.runtime->face_offsets_sharing_info)) {
+            return false;
+          }
+        }
+        /* Mesh state that is not stored in the attributes but is propagated to the output. */
+        key.append_value(mesh.flag);
+        key.append_optional_string(mesh.active_color_attribute);
+        key.append_optional_string(mesh.default_color_attribute);
+        key.append_optional_string(
+            CustomData_get_active_layer_name(&mesh.corner_data, CD_PROP_FLOAT2));
+        key.append_optional_string(
+            CustomData_get_render_layer_name(&mesh.corner_data, CD_PROP_FLOAT2));
+        append_materials(mesh, key);
+        if (!append_vertex_groups(mesh.vertex_group_names, mesh.vert_data, key)) {
+          return false;
+        }
+        if (!append_attributes(mesh.attributes(), mesh.vertex_group_names, key)) {
+          return false;
+        }
+        break;
+      }
+      case GeometryComponent::Type::PointCloud: {
+        const PointCloud &pointcloud = *geometry.get_pointcloud();
+        key.append_value(pointcloud.totpoint);
+        append_materials(pointcloud, key);
+        if (!append_attributes(pointcloud.attributes(), {}, key)) {
+          return false;
+        }
+        break;
+      }
+      case GeometryComponent::Type::Curve: {
+        const Curves &curves_id = *geometry.get_curves();
+        const bke::CurvesGeometry &curves = curves_id.geometry.wrap();
+        key.append_value(curves.points_num());
+        key.append_value(curves.curves_num());
+        if (curves.curves_num() > 0) {
+          if (!key.append_shared(curves.runtime->curve_offsets_sharing_info)) {
+            return false;
+          }
+        }
+        append_materials(curves_id, key);
+        if (!append_vertex_groups(curves.vertex_group_names, curves.point_data, key)) {
+          return false;
+        }
+        if (!append_attributes(curves.attributes(), curves.vertex_group_names, key)) {
+          return false;
+        }
+        break;
+      }
+      case GeometryComponent::Type::Volume: {
+#ifdef WITH_OPENVDB
+        const Volume &volume = *geometry.get_volume();
+        const int grids_num = BKE_volume_num_grids(&volume);
+        key.append_value(grids_num);
+        for (const int i : IndexRange(grids_num)) {
+          const bke::VolumeGridData *grid = BKE_volume_grid_get(&volume, i);
+          key.append_string(grid->name());
+          if (!key.append_shared(grid)) {
+            return false;
+          }
+        }
+        append_materials(volume, key);
+        break;
+#else
+        return false;
+#endif
+      }
+      default: {
+        /* Instances may reference data-blocks that can change without changing the component.
+         * Other components are rarely used as input for expensive nodes. */
+        return false;
+      }
+    }
+  }
+  key.append_value(GeometryComponent::Type(-1));
+  return true;
+}
+
+static bool append_input_value(const CPPType &type, const void *value, NodeEvaluationKey &key)
+{
+  if (type.is<GeometrySet>()) {
+    return append_geometry(*static_cast<const GeometrySet *>(value), key);
+  }
+  if (type.is<Vector<GeometrySet>>()) {
+    const Vector<GeometrySet> &geometries = *static_cast<const Vector<GeometrySet> *>(value);
+    key.append_value(geometries.size());
+    for (const GeometrySet &geometry : geometries) {
+      if (!append_geometry(geometry, key)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (type.is<SocketValueVariant>()) {
+    const SocketValueVariant &value_variant = *static_cast<const SocketValueVariant *>(value);
+    if (!value_variant.is_single()) {
+      /* Fields are evaluated on the geometry and can't be compared. */
+      return false;
+    }
+    const GPointer single_value = value_variant.get_single_ptr();
+    const CPPType &single_type = *single_value.type();
+    key.append_value(&single_type);
+    if (single_type.is<std::string>()) {
+      key.append_string(*single_value.get<std::string>());
+      return true;
+    }
+    if (!single_type.is_trivial()) {
+      return false;
+    }
+    key.data.append(static_cast<const char *>(single_value.get()), single_type.size());
+    return true;
+  }
+  if (type.is<bool>()) {
+    key.append_value(*static_cast<const bool *>(value));
+    return true;
+  }
+  if (type.is<GeometryNodesReferenceSet>()) {
+    const GeometryNodesReferenceSet &reference_set =
+        *static_cast<const GeometryNodesReferenceSet *>(value);
+    if (!reference_set.names) {
+      key.append_value(int64_t(-1));
+      return true;
+    }
+    /* The order of the names in the set is not deterministic. */
+    Vector<StringRef> names(reference_set.names->begin(), reference_set.names->end());
+    std::sort(names.begin(), names.end());
+    key.append_value(names.size());
+    for (const StringRef name : names) {
+      key.append_string(name);
+    }
+    return true;
+  }
+  return false;
+}
+
+/**
+ * The storage is added field by field, because the padding of DNA structs is not initialized
+ * reliably. Returns false for nodes with storage that is not known here.
+ */
+static bool append_node_storage(const bNode &node, NodeEvaluationKey &key)
+{
+  if (node.storage == nullptr) {
+    return true;
+  }
+  switch (node.type_legacy) {
+    case GEO_NODE_SUBDIVISION_SURFACE: {
+      const auto &storage = *static_cast<const NodeGeometrySubdivisionSurface *>(node.storage);
+      key.append_value(storage.uv_smooth);
+      key.append_value(storage.boundary_smooth);
+      return true;
+    }
+    case GEO_NODE_VOLUME_TO_MESH: {
+      const auto &storage = *static_cast<const NodeGeometryVolumeToMesh *>(node.storage);
+      key.append_value(storage.resolution_mode);
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool append_node_settings(const bNode &node, NodeEvaluationKey &key)
+{
+  key.append_string(node.idname);
+  key.append_value(node.custom1);
+  key.append_value(node.custom2);
+  key.append_value(node.custom3);
+  key.append_value(node.custom4);
+  return append_node_storage(node, key);
+}
+
+static std::unique_ptr<CachedNodeOutputs> compute_node_outputs(
+    const lf::LazyFunction &fn,
+    lf::Params &params,
+    const FunctionRef<void(lf::Params &params, Vector<geo_eval_log::NodeWarning> &r_warnings)>
+        execute_fn)
+{
+  const int inputs_num = fn.inputs().size();
+  const int outputs_num = fn.outputs().size();
+
+  Array<GMutablePointer> inputs(inputs_num);
+  for (const int i : IndexRange(inputs_num)) {
+    inputs[i] = {fn.inputs()[i].type, params.try_get_input_data_ptr(i)};
+  }
+  Array<std::optional<lf::ValueUsage>> input_usages(inputs_num);
+
+  Array<GMutablePointer> outputs(outputs_num);
+  Array<lf::ValueUsage> output_usages(outputs_num);
+  Array<bool> set_outputs(outputs_num);
+  for (const int i : IndexRange(outputs_num)) {
+    const CPPType &type = *fn.outputs()[i].type;
+    outputs[i] = {type, MEM_mallocN_aligned(type.size(), type.alignment(), __func__)};
+    output_usages[i] = params.get_output_usage(i);
+    /* Outputs that are set already don't depend on the inputs of the node. */
+    set_outputs[i] = params.output_was_set(i);
+  }
+  const Array<bool> outputs_set_before = set_outputs;
+
+  lf::BasicParams memoized_params{fn, inputs, outputs, input_usages, output_usages, set_outputs};
+  auto result = std::make_unique<CachedNodeOutputs>(outputs_num);
+  execute_fn(memoized_params, result->warnings);
+
+  for (const int i : IndexRange(outputs_num)) {
+    if (set_outputs[i] && !outputs_set_before[i]) {
+      result->outputs[i] = outputs[i];
+    }
+    else {
+      MEM_freeN(outputs[i].get());
+    }
+  }
+  return result;
+}
+
+bool execute_geometry_node_memoized(
+    const bNode &node,
+    const lf::LazyFunction &fn,
+    lf::Params &params,
+    const Span<std::string> output_attribute_names,
+    geo_eval_log::GeoTreeLogger *tree_logger,
+    const FunctionRef<void(lf::Params &params, Vector<geo_eval_log::NodeWarning> &r_warnings)>
+        execute_fn)
+{
+  NodeEvaluationKey key;
+  if (!append_node_settings(node, key)) {
+    return false;
+  }
+  for (const int i : fn.inputs().index_range()) {
+    const void *value = params.try_get_input_data_ptr(i);
+    BLI_assert(value != nullptr);
+    if (!append_input_value(*fn.inputs()[i].type, value, key)) {
+      return false;
+    }
+  }
+  for (const int i : fn.outputs().index_range()) {
+    /* Nodes may skip computing outputs that are not used. */
+    key.append_value(params.get_output_usage(i) != lf::ValueUsage::Unused);
+  }
+  for (const std::string &name : output_attribute_names) {
+    key.append_string(name);
+  }
+
+  bool outputs_computed = false;
+  const std::shared_ptr<const CachedNodeOutputs> cached_outputs =
+      memory_cache::get<CachedNodeOutputs>(key, [&]() {
+        outputs_computed = true;
+        return compute_node_outputs(fn, params, execute_fn);
+      });
+
+  if (tree_logger && !outputs_computed) {
+    /* The warnings were only logged by the evaluation that computed the outputs. */
+    for (const geo_eval_log::NodeWarning &warning : cached_outputs->warnings) {
+      tree_logger->node_warnings.append(
+          *tree_logger->allocator,
+          {node.identifier, {warning.type, tree_logger->allocator->copy_string(warning.message)}});
+    }
+  }
+
+  for (const int i : fn.outputs().index_range()) {
+    const GMutablePointer value = cached_outputs->outputs[i];
+    if (value.get() == nullptr || params.output_was_set(i)) {
+      continue;
+    }
+    value.type()->copy_construct(value.get(), params.get_output_data_ptr(i));
+    params.output_set(i);
+  }
+  return true;
+}
+
+}  // namespace blender::nodes
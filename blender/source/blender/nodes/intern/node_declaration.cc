@@ -124,6 +124,11 @@ void NodeDeclarationBuilder::allow_any_socket_order(bool enable)
   declaration_.allow_any_socket_order = enable;
 }
 
+void NodeDeclarationBuilder::memoize_outputs(bool enable)
+{
+  declaration_.memoize_outputs = enable;
+}
+
 Span<SocketDeclaration *> NodeDeclaration::sockets(eNodeSocketInOut in_out) const
 {
   if (in_out == SOCK_IN) {
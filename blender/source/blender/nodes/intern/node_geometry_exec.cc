@@ -29,6 +29,9 @@ Main *GeoNodeExecParams::bmain() const
 void GeoNodeExecParams::error_message_add(const NodeWarningType type,
                                           const StringRef message) const
 {
+  if (r_warnings) {
+    r_warnings->append({type, message});
+  }
   if (geo_eval_log::GeoTreeLogger *tree_logger = this->get_local_tree_logger()) {
     tree_logger->node_warnings.append(
         *tree_logger->allocator,
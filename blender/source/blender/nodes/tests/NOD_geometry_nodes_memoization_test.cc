@@ -0,0 +1,180 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "NOD_geometry_nodes_log.hh"
+#include "NOD_geometry_nodes_memoization.hh"
+
+#include "BKE_deform.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_idtype.hh"
+#include "BKE_mesh.hh"
+#include "BKE_node_legacy_types.hh"
+
+#include "BLI_listbase.h"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_utils.hh"
+#include "BLI_string.h"
+#include "BLI_string_utils.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_node_types.h"
+
+#include "FN_lazy_function_execute.hh"
+
+namespace blender::nodes::tests {
+
+using bke::GeometrySet;
+
+class PassThroughFunction : public lf::LazyFunction {
+ public:
+  PassThroughFunction()
+  {
+    debug_name_ = "Pass Through";
+    inputs_.append({"Geometry", CPPType::get<GeometrySet>()});
+    outputs_.append({"Geometry", CPPType::get<GeometrySet>()});
+  }
+
+  void execute_impl(lf::Params &params, const lf::Context & /*context*/) const override
+  {
+    params.set_output(0, params.get_input<GeometrySet>(0));
+  }
+};
+
+class geometry_nodes_memoization : public testing::Test {
+ protected:
+  PassThroughFunction fn_;
+  int executions_num_ = 0;
+
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+
+  void SetUp() override
+  {
+    memory_cache::clear();
+  }
+
+  void TearDown() override
+  {
+    memory_cache::clear();
+  }
+
+  /** Evaluates the node with the geometry as input and returns whether it was memoized. */
+  bool evaluate(const bNode &node, const GeometrySet &geometry)
+  {
+    GeometrySet input = geometry;
+    TypedBuffer<GeometrySet> output;
+    Array<GMutablePointer> inputs = {GMutablePointer(&input)};
+    Array<std::optional<lf::ValueUsage>> input_usages(1);
+    Array<GMutablePointer> outputs = {GMutablePointer(output.ptr())};
+    Array<lf::ValueUsage> output_usages = {lf::ValueUsage::Used};
+    Array<bool> set_outputs = {false};
+    lf::BasicParams params{fn_, inputs, outputs, input_usages, output_usages, set_outputs};
+
+    const bool memoized = execute_geometry_node_memoized(
+        node,
+        fn_,
+        params,
+        {},
+        nullptr,
+        [&](lf::Params &params, Vector<geo_eval_log::NodeWarning> & /*r_warnings*/) {
+          executions_num_++;
+          params.set_output(0, params.get_input<GeometrySet>(0));
+        });
+    if (set_outputs[0]) {
+      std::destroy_at(output.ptr());
+    }
+    return memoized;
+  }
+};
+
+static bNode convex_hull_node()
+{
+  bNode node{};
+  STRNCPY(node.idname, "GeometryNodeConvexHull");
+  node.type_legacy = GEO_NODE_CONVEX_HULL;
+  return node;
+}
+
+/** Mesh with a vertex group, which is a virtual attribute. */
+static GeometrySet create_mesh_with_vertex_group()
+{
+  Mesh *mesh = BKE_mesh_new_nomain(4, 0, 0, 0);
+  bDeformGroup *group = MEM_cnew<bDeformGroup>(__func__);
+  STRNCPY(group->name, "Group");
+  BLI_addtail(&mesh->vertex_group_names, group);
+  MutableSpan<MDeformVert> dverts = mesh->deform_verts_for_write();
+  BKE_defvert_add_index_notest(&dverts[0], 0, 0.5f);
+  return GeometrySet::from_mesh(mesh);
+}
+
+TEST_F(geometry_nodes_memoization, reuse_for_same_data)
+{
+  const bNode node = convex_hull_node();
+  GeometrySet geometry = create_mesh_with_vertex_group();
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 1);
+
+  /* Copying the mesh shares all its arrays, so the outputs are reused. */
+  geometry.get_mesh_for_write();
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 1);
+}
+
+TEST_F(geometry_nodes_memoization, recompute_for_changed_data)
+{
+  const bNode node = convex_hull_node();
+  GeometrySet geometry = create_mesh_with_vertex_group();
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 1);
+
+  geometry.get_mesh_for_write()->vert_positions_for_write()[0].x = 1.0f;
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 2);
+
+  geometry.get_mesh_for_write()->deform_verts_for_write()[0].dw[0].weight = 0.25f;
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 3);
+
+  /* Only the name changes, all arrays are still shared with the previous mesh. */
+  Mesh *mesh = geometry.get_mesh_for_write();
+  mesh->default_color_attribute = BLI_strdup("Color");
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 4);
+
+  mesh->flag ^= ME_NO_OVERLAPPING_TOPOLOGY;
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 5);
+}
+
+TEST_F(geometry_nodes_memoization, node_storage)
+{
+  NodeGeometrySubdivisionSurface storage{};
+  bNode node{};
+  STRNCPY(node.idname, "GeometryNodeSubdivisionSurface");
+  node.type_legacy = GEO_NODE_SUBDIVISION_SURFACE;
+  node.storage = &storage;
+  const GeometrySet geometry = create_mesh_with_vertex_group();
+
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 1);
+
+  storage.boundary_smooth = 1;
+  EXPECT_TRUE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 2);
+
+  /* Storage of other nodes is unknown and can't be part of the key. */
+  node.type_legacy = GEO_NODE_CONVEX_HULL;
+  EXPECT_FALSE(this->evaluate(node, geometry));
+  EXPECT_EQ(executions_num_, 2);
+}
+
+}  // namespace blender::nodes::tests
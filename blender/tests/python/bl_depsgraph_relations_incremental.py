@@ -0,0 +1,150 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# ./blender.bin --background --factory-startup --python tests/python/bl_depsgraph_relations_incremental.py -- --verbose
+
+import collections
+import re
+import unittest
+
+import bpy
+
+
+def relations_from_dot(dot_graph):
+    """
+    Get the relations of the graph from its graphviz export. Nodes are identified by their labels
+    and the labels of the clusters they are in, since the pointers differ between builds.
+    """
+    attribute_re = re.compile(r'(\w+)="((?:[^"\\]|\\.)*)"')
+
+    def normalize_label(label):
+        # Strip pointers and visibility state from ID and component node labels.
+        label = re.sub(r" \(orig: .*\)$", "", label)
+        label = re.sub(r" : \(affects_visible_id: \w+\)$", "", label)
+        return label
+
+    node_paths = {}
+    edges = []
+    clusters = []
+    for line in dot_graph.splitlines():
+        line = line.strip()
+        if line.startswith("subgraph "):
+            clusters.append(None)
+        elif line == "}":
+            if clusters:
+                clusters.pop()
+        elif line.startswith("graph ["):
+            if clusters:
+                attributes = dict(attribute_re.findall(line))
+                clusters[-1] = normalize_label(attributes.get("label", ""))
+        elif " -> " in line:
+            from_id, rest = line.split(" -> ", 1)
+            to_id, attributes_str = rest.split(" ", 1)
+            edges.append((from_id, to_id, dict(attribute_re.findall(attributes_str))))
+        elif line.startswith('"'):
+            node_id, attributes_str = line.split(" ", 1)
+            attributes = dict(attribute_re.findall(attributes_str))
+            node_paths[node_id] = tuple(clusters) + (normalize_label(attributes.get("label", "")),)
+
+    return collections.Counter(
+        (node_paths[from_id.split(":")[0]],
+         node_paths[to_id.split(":")[0]],
+         attributes.get("id"),
+         attributes.get("color"),
+         attributes.get("style"))
+        for from_id, to_id, attributes in edges
+    )
+
+
+class IncrementalRelationsUpdateTest(unittest.TestCase):
+    """
+    Change modifier targets, which updates the relations of the modified object only, and compare
+    the relations with the ones of a full rebuild of the graph.
+    """
+
+    def setUp(self):
+        bpy.ops.wm.read_factory_settings(use_empty=True)
+        bpy.context.preferences.experimental.use_depsgraph_incremental_relations = True
+
+    def tearDown(self):
+        bpy.context.preferences.experimental.use_depsgraph_incremental_relations = False
+
+    @staticmethod
+    def make_object(name):
+        mesh = bpy.data.meshes.new(name)
+        mesh.from_pydata([(0.0, 0.0, 0.0), (1.0, 0.0, 0.0), (0.0, 1.0, 0.0)], [], [(0, 1, 2)])
+        ob = bpy.data.objects.new(name, mesh)
+        bpy.context.scene.collection.objects.link(ob)
+        return ob
+
+    def relations_after_incremental_and_full_update(self):
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        incremental_relations = relations_from_dot(depsgraph.debug_relations_graphviz())
+        depsgraph.debug_tag_update()
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        full_relations = relations_from_dot(depsgraph.debug_relations_graphviz())
+        return incremental_relations, full_relations
+
+    def test_change_modifier_target(self):
+        ob = self.make_object("Object")
+        target_a = self.make_object("TargetA")
+        target_b = self.make_object("TargetB")
+        modifier = ob.modifiers.new("Array", 'ARRAY')
+        modifier.use_object_offset = True
+        modifier.offset_object = target_a
+        relations_before = relations_from_dot(
+            bpy.context.evaluated_depsgraph_get().debug_relations_graphviz())
+
+        modifier.offset_object = target_b
+        incremental_relations, full_relations = self.relations_after_incremental_and_full_update()
+        self.assertNotEqual(incremental_relations, relations_before)
+        self.assertEqual(incremental_relations, full_relations)
+
+    @staticmethod
+    def add_property_driver(ob, target):
+        driver = ob.driver_add("location", 0).driver
+        driver.type = 'SUM'
+        variable = driver.variables.new()
+        variable.type = 'SINGLE_PROP'
+        variable.targets[0].id = target
+        variable.targets[0].data_path = '["prop"]'
+
+    def test_shared_relation(self):
+        # Drivers of both objects read the same ID property, so both their builders create the
+        # relations of that property.
+        target = self.make_object("Target")
+        target["prop"] = 1.0
+        ob_a = self.make_object("A")
+        ob_b = self.make_object("B")
+        self.add_property_driver(ob_a, target)
+        self.add_property_driver(ob_b, target)
+        modifier = ob_a.modifiers.new("Array", 'ARRAY')
+        modifier.use_object_offset = True
+        modifier.offset_object = ob_b
+        bpy.context.evaluated_depsgraph_get()
+
+        modifier.offset_object = target
+        incremental_relations, full_relations = self.relations_after_incremental_and_full_update()
+        self.assertTrue(any("ID Property" in relation[2] for relation in incremental_relations))
+        self.assertEqual(incremental_relations, full_relations)
+
+    def test_remove_dependency_cycle(self):
+        ob_a = self.make_object("A")
+        ob_b = self.make_object("B")
+        ob_c = self.make_object("C")
+        modifier = ob_a.modifiers.new("Boolean", 'BOOLEAN')
+        modifier.object = ob_b
+        ob_b.modifiers.new("Boolean", 'BOOLEAN').object = ob_a
+        bpy.context.evaluated_depsgraph_get()
+
+        # Relations which were part of the cycle are not cyclic anymore.
+        modifier.object = ob_c
+        incremental_relations, full_relations = self.relations_after_incremental_and_full_update()
+        self.assertEqual(incremental_relations, full_relations)
+
+
+if __name__ == '__main__':
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
@@ -0,0 +1,106 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# ./blender.bin --background --factory-startup --python tests/python/bl_node_foreach_geometry_element.py -- --verbose
+
+import unittest
+
+import bpy
+
+
+class ForeachGeometryElementZoneTest(unittest.TestCase):
+    """
+    A zone body that only does field math is evaluated once for all elements. Compare its result
+    with the same body evaluated per element, which is forced by using the element geometry.
+    """
+
+    points_num = 50
+
+    def setUp(self):
+        bpy.ops.wm.read_factory_settings(use_empty=True)
+
+    def make_object(self, name):
+        mesh = bpy.data.meshes.new(name)
+        mesh.from_pydata([(float(i), 0.0, 0.0) for i in range(self.points_num)], [], [])
+        ob = bpy.data.objects.new(name, mesh)
+        bpy.context.scene.collection.objects.link(ob)
+        return ob
+
+    def make_node_group(self, name, *, use_element_geometry):
+        tree = bpy.data.node_groups.new(name, 'GeometryNodeTree')
+        tree.interface.new_socket("Geometry", in_out='INPUT', socket_type='NodeSocketGeometry')
+        tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+        nodes = tree.nodes
+        links = tree.links
+
+        group_input = nodes.new('NodeGroupInput')
+        group_output = nodes.new('NodeGroupOutput')
+
+        zone_input = nodes.new('GeometryNodeForeachGeometryElementInput')
+        zone_output = nodes.new('GeometryNodeForeachGeometryElementOutput')
+        zone_input.pair_with_output(zone_output)
+        zone_output.domain = 'POINT'
+        zone_output.generation_items.clear()
+        zone_output.main_items.new('FLOAT', "Value")
+
+        # Value = Index * 2 + 1
+        multiply = nodes.new('ShaderNodeMath')
+        multiply.operation = 'MULTIPLY'
+        multiply.inputs[1].default_value = 2.0
+        add = nodes.new('ShaderNodeMath')
+        add.operation = 'ADD'
+        add.inputs[1].default_value = 1.0
+        links.new(zone_input.outputs["Index"], multiply.inputs[0])
+        links.new(multiply.outputs[0], add.inputs[0])
+
+        if use_element_geometry:
+            # Adds zero, but makes the body depend on the geometry of every element.
+            domain_size = nodes.new('GeometryNodeAttributeDomainSize')
+            domain_size.component = 'MESH'
+            zero = nodes.new('ShaderNodeMath')
+            zero.operation = 'MULTIPLY'
+            zero.inputs[1].default_value = 0.0
+            links.new(zone_input.outputs["Element"], domain_size.inputs["Geometry"])
+            links.new(domain_size.outputs["Point Count"], zero.inputs[0])
+            links.new(zero.outputs[0], add.inputs[1])
+
+        links.new(add.outputs[0], zone_output.inputs["Value"])
+
+        store = nodes.new('GeometryNodeStoreNamedAttribute')
+        store.data_type = 'FLOAT'
+        store.domain = 'POINT'
+        store.inputs["Name"].default_value = "result"
+
+        links.new(group_input.outputs[0], zone_input.inputs["Geometry"])
+        links.new(zone_output.outputs["Geometry"], store.inputs["Geometry"])
+        links.new(zone_output.outputs["Value"], store.inputs["Value"])
+        links.new(store.outputs["Geometry"], group_output.inputs[0])
+        return tree
+
+    def evaluate_result(self, ob):
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        mesh = ob.evaluated_get(depsgraph).data
+        attribute = mesh.attributes["result"]
+        return [item.value for item in attribute.data]
+
+    def test_field_only_body_matches_per_element(self):
+        results = []
+        for use_element_geometry in (False, True):
+            name = "per_element" if use_element_geometry else "field_only"
+            ob = self.make_object(name)
+            modifier = ob.modifiers.new(name, 'NODES')
+            modifier.node_group = self.make_node_group(
+                name, use_element_geometry=use_element_geometry)
+            results.append(self.evaluate_result(ob))
+
+        field_only_result, per_element_result = results
+        expected = [i * 2.0 + 1.0 for i in range(self.points_num)]
+        self.assertEqual(field_only_result, expected)
+        self.assertEqual(per_element_result, expected)
+
+
+if __name__ == '__main__':
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()